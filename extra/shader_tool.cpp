@@ -0,0 +1,671 @@
+// Command line tool to check and rewrite .shader files without opening the editor
+// Only needs shader_core and shader_graph, build it with 'make shader_tool'
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+
+#include "shader_core/vector.h"
+
+#include "shader_graph/graph.h"
+#include "shader_graph/node.h"
+#include "shader_graph/node_id.h"
+#include "shader_graph/node_type.h"
+#include "shader_graph/serialize.h"
+#include "shader_graph/serialize_compressed.h"
+#include "shader_graph/slot_id.h"
+
+namespace fs = boost::filesystem;
+
+enum class ToolMode {
+	VALIDATE,
+	CANONICALIZE,
+	CONVERT,
+	FUZZ,
+};
+
+struct ToolOptions {
+	ToolMode mode{ ToolMode::VALIDATE };
+	csg::SerializedFormat format{ csg::SerializedFormat::TEXT };
+	size_t thread_count{ 1 };
+	bool quiet{ false };
+	std::vector<std::string> paths;
+
+	// Fuzz mode only
+	size_t fuzz_iterations{ 2000 };
+	uint64_t fuzz_seed{ 1 };
+	size_t fuzz_input_size{ 4 << 20 };
+	double min_throughput{ 1.0 };
+};
+
+enum class FileStatus {
+	OK,
+	REWRITTEN,
+	FAILED,
+};
+
+struct FileResult {
+	FileStatus status{ FileStatus::OK };
+	std::string message;
+	double milliseconds{ 0.0 };
+};
+
+static const char* const USAGE{
+	"Usage: shader_tool <mode> [options] <file or directory>...\n"
+	"Directories are searched recursively for .shader files.\n"
+	"\n"
+	"Modes:\n"
+	"  validate        Check that each graph survives a round trip through every format\n"
+	"  canonicalize    Rewrite each file in the current text format\n"
+	"  convert <fmt>   Rewrite each file in the given format: text, binary or compressed\n"
+	"  fuzz            Load random and hostile inputs, any files given are used as seeds for the random inputs\n"
+	"\n"
+	"Options:\n"
+	"  -j <count>      Number of files to process at once, defaults to the number of hardware threads\n"
+	"  -q              Only report files that failed\n"
+	"\n"
+	"Fuzz options:\n"
+	"  -n <count>      Number of random inputs, default 2000\n"
+	"  --seed <seed>   Seed for the random inputs and node ids, default 1\n"
+	"  --size <bytes>  Size of each hostile input, default 4 MiB\n"
+	"  --min-mbps <x>  Fail if any large input loads slower than this many MB per second, default 1\n"
+};
+
+static boost::optional<csg::SerializedFormat> parse_format(const std::string& name)
+{
+	if (name == "text") {
+		return csg::SerializedFormat::TEXT;
+	}
+	else if (name == "binary") {
+		return csg::SerializedFormat::BINARY;
+	}
+	else if (name == "compressed") {
+		return csg::SerializedFormat::COMPRESSED;
+	}
+	return boost::none;
+}
+
+static const char* get_format_name(const csg::SerializedFormat format)
+{
+	switch (format) {
+		case csg::SerializedFormat::TEXT:
+			return "text";
+		case csg::SerializedFormat::BINARY:
+			return "binary";
+		case csg::SerializedFormat::COMPRESSED:
+			return "compressed";
+	}
+	return "unknown";
+}
+
+static boost::optional<ToolOptions> parse_args(const int argc, const char* const argv[])
+{
+	if (argc < 2) {
+		return boost::none;
+	}
+
+	ToolOptions result;
+	result.thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+	int next_arg{ 2 };
+	const std::string mode_name{ argv[1] };
+	if (mode_name == "validate") {
+		result.mode = ToolMode::VALIDATE;
+	}
+	else if (mode_name == "canonicalize") {
+		result.mode = ToolMode::CANONICALIZE;
+	}
+	else if (mode_name == "fuzz") {
+		result.mode = ToolMode::FUZZ;
+	}
+	else if (mode_name == "convert" && argc > 2) {
+		const boost::optional<csg::SerializedFormat> opt_format{ parse_format(argv[2]) };
+		if (opt_format.has_value() == false) {
+			return boost::none;
+		}
+		result.mode = ToolMode::CONVERT;
+		result.format = *opt_format;
+		next_arg = 3;
+	}
+	else {
+		return boost::none;
+	}
+
+	for (int i = next_arg; i < argc; i++) {
+		if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+			const int thread_count{ std::atoi(argv[i + 1]) };
+			if (thread_count < 1) {
+				return boost::none;
+			}
+			result.thread_count = static_cast<size_t>(thread_count);
+			i++;
+		}
+		else if (std::strcmp(argv[i], "-q") == 0) {
+			result.quiet = true;
+		}
+		else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			result.fuzz_iterations = static_cast<size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+			i++;
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			result.fuzz_seed = std::strtoull(argv[i + 1], nullptr, 10);
+			i++;
+		}
+		else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+			result.fuzz_input_size = static_cast<size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+			i++;
+		}
+		else if (std::strcmp(argv[i], "--min-mbps") == 0 && i + 1 < argc) {
+			result.min_throughput = std::atof(argv[i + 1]);
+			i++;
+		}
+		else {
+			result.paths.push_back(argv[i]);
+		}
+	}
+
+	if (result.paths.empty() && result.mode != ToolMode::FUZZ) {
+		return boost::none;
+	}
+	return result;
+}
+
+// Expand directories into the .shader files they contain, sorted so runs over the same tree report in the same order
+static bool find_files(const std::vector<std::string>& paths, std::vector<fs::path>& files)
+{
+	for (const std::string& this_path : paths) {
+		boost::system::error_code error;
+		if (fs::is_directory(this_path, error)) {
+			for (fs::recursive_directory_iterator iter{ this_path, error }; iter != fs::recursive_directory_iterator{}; iter.increment(error)) {
+				if (error) {
+					break;
+				}
+				if (fs::is_regular_file(iter->status()) && iter->path().extension() == ".shader") {
+					files.push_back(iter->path());
+				}
+			}
+		}
+		else if (fs::is_regular_file(this_path, error)) {
+			files.push_back(this_path);
+		}
+		if (error) {
+			std::cerr << "Unable to read " << this_path << ": " << error.message() << std::endl;
+			return false;
+		}
+	}
+	std::sort(files.begin(), files.end());
+	return true;
+}
+
+static boost::optional<std::string> read_file(const fs::path& path)
+{
+	std::ifstream input{ path.string(), std::ifstream::in | std::ifstream::binary };
+	if (input.is_open() == false) {
+		return boost::none;
+	}
+	std::ostringstream contents;
+	contents << input.rdbuf();
+	if (input.bad()) {
+		return boost::none;
+	}
+	return contents.str();
+}
+
+// Write to a temporary file first so an interrupted run never leaves a partly written graph behind
+static bool replace_file(const fs::path& path, const std::string& contents)
+{
+	fs::path temp_path{ path };
+	temp_path += ".tmp";
+	{
+		std::ofstream output{ temp_path.string(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc };
+		if (output.is_open() == false) {
+			return false;
+		}
+		output << contents;
+		output.close();
+		if (output.fail()) {
+			fs::remove(temp_path);
+			return false;
+		}
+	}
+	boost::system::error_code error;
+	fs::rename(temp_path, path, error);
+	if (error) {
+		fs::remove(temp_path, error);
+		return false;
+	}
+	return true;
+}
+
+// Returns a description of the problem, or none if graph serializes to something that loads back unchanged
+static boost::optional<std::string> check_round_trip(const csg::Graph& graph, const csg::SerializedFormat format)
+{
+	const std::string serialized{ graph.serialize(format) };
+	const boost::optional<csg::Graph> reloaded{ csg::deserialize_graph(serialized) };
+	if (reloaded.has_value() == false) {
+		return std::string{ get_format_name(format) } + " output could not be loaded";
+	}
+	if (*reloaded != graph) {
+		return std::string{ get_format_name(format) } + " round trip changed the graph";
+	}
+	if (reloaded->serialize(format) != serialized) {
+		return std::string{ get_format_name(format) } + " output changed when saved again";
+	}
+	return boost::none;
+}
+
+static FileResult process_file(const fs::path& path, const ToolOptions& options)
+{
+	FileResult result;
+
+	const boost::optional<std::string> contents{ read_file(path) };
+	if (contents.has_value() == false) {
+		result.status = FileStatus::FAILED;
+		result.message = "could not be read";
+		return result;
+	}
+
+	const boost::optional<csg::Graph> graph{ csg::deserialize_graph(*contents) };
+	if (graph.has_value() == false) {
+		result.status = FileStatus::FAILED;
+		result.message = "is not a valid shader graph";
+		return result;
+	}
+
+	if (options.mode == ToolMode::VALIDATE) {
+		for (const csg::SerializedFormat format : { csg::SerializedFormat::TEXT, csg::SerializedFormat::BINARY, csg::SerializedFormat::COMPRESSED }) {
+			const boost::optional<std::string> problem{ check_round_trip(*graph, format) };
+			if (problem.has_value()) {
+				result.status = FileStatus::FAILED;
+				result.message = *problem;
+				return result;
+			}
+		}
+		return result;
+	}
+
+	// Rewriting, canonicalize is a conversion to text
+	const csg::SerializedFormat format{ options.mode == ToolMode::CANONICALIZE ? csg::SerializedFormat::TEXT : options.format };
+	const std::string serialized{ graph->serialize(format) };
+	if (serialized == *contents) {
+		result.message = "unchanged";
+		return result;
+	}
+
+	// Never replace a file with output that does not load back to the same graph
+	const boost::optional<csg::Graph> reloaded{ csg::deserialize_graph(serialized) };
+	if (reloaded.has_value() == false || *reloaded != *graph) {
+		result.status = FileStatus::FAILED;
+		result.message = "new contents do not match the original graph, file left unchanged";
+		return result;
+	}
+	if (replace_file(path, serialized) == false) {
+		result.status = FileStatus::FAILED;
+		result.message = "could not be written";
+		return result;
+	}
+	result.status = FileStatus::REWRITTEN;
+	result.message = std::string{ "rewritten as " } + get_format_name(format);
+	return result;
+}
+
+// Fuzz mode
+
+// Streaming input is fed in chunks this size, small enough that records often span two chunks
+constexpr size_t FUZZ_CHUNK_SIZE{ 4096 };
+// Throughput is only checked for inputs at least this large, smaller ones are dominated by fixed costs
+constexpr size_t FUZZ_MIN_TIMED_SIZE{ 64 * 1024 };
+
+struct FuzzInput {
+	std::string name;
+	std::string data;
+};
+
+// Some random nodes with random connections, most connection attempts fail which is fine
+static std::string make_random_graph(std::mt19937_64& rng, const csg::SerializedFormat format)
+{
+	csg::Graph graph{ rng() % 2 == 0 ? csg::GraphType::MATERIAL : csg::GraphType::EMPTY };
+	const size_t node_count{ rng() % 40 };
+	std::vector<csg::NodeId> ids;
+	for (const csg::Node& this_node : graph.nodes()) {
+		ids.push_back(this_node.id());
+	}
+	for (size_t i = 0; i < node_count; i++) {
+		const csg::NodeType type{ static_cast<csg::NodeType>(rng() % static_cast<size_t>(csg::NodeType::COUNT)) };
+		const csc::Int2 pos{ static_cast<int>(rng() % 2000) - 1000, static_cast<int>(rng() % 2000) - 1000 };
+		ids.push_back(graph.add(type, pos));
+	}
+	if (ids.empty() == false) {
+		for (size_t i = 0; i < ids.size() * 2; i++) {
+			const csg::SlotId source{ ids[rng() % ids.size()], static_cast<size_t>(rng() % 8) };
+			const csg::SlotId dest{ ids[rng() % ids.size()], static_cast<size_t>(rng() % 12) };
+			graph.add_connection(source, dest);
+		}
+	}
+	return graph.serialize(format);
+}
+
+static std::string mutate(std::string input, std::mt19937_64& rng)
+{
+	static const char SPECIAL_CHARS[]{ "|,/-.0123456789e+ \nabcdhxz\xff" };
+	const size_t mutation_count{ 1 + rng() % 8 };
+	for (size_t i = 0; i < mutation_count; i++) {
+		const size_t pos{ input.empty() ? 0 : static_cast<size_t>(rng() % input.size()) };
+		switch (rng() % 6) {
+			case 0:
+				if (input.empty() == false) {
+					input[pos] = static_cast<char>(input[pos] ^ (1 << (rng() % 8)));
+				}
+				break;
+			case 1:
+				input.insert(pos, 1, '|');
+				break;
+			case 2:
+				input.erase(pos, static_cast<size_t>(rng() % 16));
+				break;
+			case 3:
+				input.insert(pos, input.substr(pos, static_cast<size_t>(rng() % 256)));
+				break;
+			case 4:
+				input.resize(pos);
+				break;
+			default:
+				if (input.empty() == false) {
+					input[pos] = SPECIAL_CHARS[rng() % (sizeof(SPECIAL_CHARS) - 1)];
+				}
+				break;
+		}
+	}
+	return input;
+}
+
+// Repeat a record until the result is at least size bytes
+static std::string repeat_until(std::string prefix, const size_t size, const std::function<std::string(size_t)>& make_record)
+{
+	for (size_t i = 0; prefix.size() < size; i++) {
+		prefix += make_record(i);
+	}
+	return prefix;
+}
+
+// Inputs built to hit the worst case of each part of the parser
+static std::vector<FuzzInput> make_hostile_inputs(const size_t size)
+{
+	std::vector<FuzzInput> result;
+	const std::string header{ "cycles_shader|1|section_nodes|" };
+
+	result.push_back(FuzzInput{ "no separators", "cycles_shader" + std::string(size, 'x') });
+	result.push_back(FuzzInput{ "only separators", header + std::string(size, '|') });
+	result.push_back(FuzzInput{ "unterminated record", header + "math|" + std::string(size, 'a') });
+	result.push_back(FuzzInput{ "unknown node types", repeat_until(header, size, [](const size_t i) {
+		return "no_such_type|n" + std::to_string(i) + "|0|0|value|1|node_end|";
+	}) });
+	result.push_back(FuzzInput{ "many nodes", repeat_until(header, size, [](const size_t i) {
+		return "math|n" + std::to_string(i) + "|0|0|node_end|";
+	}) });
+	result.push_back(FuzzInput{ "long value", header + "math|a|0|0|value1|" + std::string(size, '1') + "|node_end|" });
+
+	const std::string curve_points{ repeat_until("", std::min<size_t>(size, 512 * 1024), [](size_t) { return std::string{ "0.5,0.5,h," }; }) };
+	result.push_back(FuzzInput{ "curve with many points", header + "rgb_curves|a|0|0|curves|curve_rgb_00/00/" + curve_points + "/0,0,h,1,1,h/0,0,h,1,1,h/0,0,h,1,1,h|node_end|" });
+	result.push_back(FuzzInput{ "legacy curve point count", repeat_until(header, size, [](const size_t i) {
+		return "rgb_curves|n" + std::to_string(i) + "|0|0|rgb_curve|curve00,linear,2147483647,0,0,1,1|node_end|";
+	}) });
+
+	// Every connection record names real slots, so each one goes through the cycle check in add_connection
+	constexpr size_t CONNECTED_NODE_COUNT{ 1000 };
+	std::string connection_nodes{ header };
+	for (size_t i = 0; i < CONNECTED_NODE_COUNT; i++) {
+		connection_nodes += "math|n" + std::to_string(i) + "|0|0|node_end|";
+	}
+	connection_nodes += "section_connections|";
+	std::mt19937_64 connection_rng{ 0 };
+	result.push_back(FuzzInput{ "many connections", repeat_until(connection_nodes, size, [&](size_t) {
+		const size_t source{ static_cast<size_t>(connection_rng() % CONNECTED_NODE_COUNT) };
+		const size_t dest{ static_cast<size_t>(connection_rng() % CONNECTED_NODE_COUNT) };
+		return "n" + std::to_string(source) + "|Value|n" + std::to_string(dest) + "|Value1|";
+	}) });
+
+	// Point every node in a binary graph at the whole value table
+	{
+		csg::Graph graph{ csg::GraphType::EMPTY };
+		for (size_t i = 0; i < 1000; i++) {
+			graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 });
+		}
+		std::string binary{ graph.serialize(csg::SerializedFormat::BINARY) };
+		constexpr size_t HEADER_SIZE{ 32 };
+		constexpr size_t NODE_RECORD_SIZE{ 32 };
+		constexpr size_t FIRST_VALUE_OFFSET{ 20 };
+		uint32_t value_count;
+		std::memcpy(&value_count, binary.data() + 16, sizeof(value_count));
+		for (size_t i = 0; i < graph.nodes().size(); i++) {
+			const uint32_t zero{ 0 };
+			char* const record{ &binary[HEADER_SIZE + i * NODE_RECORD_SIZE] };
+			std::memcpy(record + FIRST_VALUE_OFFSET, &zero, sizeof(zero));
+			std::memcpy(record + FIRST_VALUE_OFFSET + 4, &value_count, sizeof(value_count));
+		}
+		result.push_back(FuzzInput{ "binary overlapping values", binary });
+	}
+
+	result.push_back(FuzzInput{ "compression bomb", csg::compress_serialized_graph(header + std::string(size * 16, '|')) });
+	result.push_back(FuzzInput{ "compressed size too large", "cycles_shader_lz|1|999999999999|AAAA" });
+
+	return result;
+}
+
+// Load data both at once and streamed in small chunks, returns a description of the problem if there is one
+static boost::optional<std::string> check_fuzz_input(const std::string& data, const double min_throughput, double& milliseconds)
+{
+	const auto start_time{ std::chrono::steady_clock::now() };
+	const boost::optional<csg::Graph> graph{ csg::deserialize_graph(data) };
+	const std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() - start_time };
+	milliseconds = elapsed.count();
+
+	csg::GraphStreamParser parser;
+	for (size_t pos = 0; pos < data.size() && parser.failed() == false; pos += FUZZ_CHUNK_SIZE) {
+		parser.feed(boost::string_view{ data }.substr(pos, FUZZ_CHUNK_SIZE));
+	}
+	const boost::optional<csg::Graph> streamed_graph{ parser.finish() };
+
+	if (graph.has_value() != streamed_graph.has_value()) {
+		return std::string{ "streaming parser " } + (graph.has_value() ? "rejected" : "accepted") + " input the whole input parser did not";
+	}
+	if (graph.has_value() && (graph->nodes().size() != streamed_graph->nodes().size() || graph->connections().size() != streamed_graph->connections().size())) {
+		return std::string{ "streaming parser produced a different graph" };
+	}
+
+	// Compressed input is timed against what it expands to, otherwise a bomb would look slow
+	size_t data_size{ data.size() };
+	if (csg::is_compressed_graph(data)) {
+		const boost::optional<std::string> decompressed{ csg::decompress_serialized_graph(data, csg::DeserializeOptions{}.max_decompressed_size) };
+		if (decompressed.has_value()) {
+			data_size = std::max(data_size, decompressed->size());
+		}
+	}
+	if (data_size >= FUZZ_MIN_TIMED_SIZE && milliseconds > 0.0) {
+		const double throughput{ static_cast<double>(data_size) / 1.0e6 / (milliseconds / 1000.0) };
+		if (throughput < min_throughput) {
+			char message[128];
+			std::snprintf(message, sizeof(message), "loaded at %.2f MB/s which is below the minimum of %.2f MB/s", throughput, min_throughput);
+			return std::string{ message };
+		}
+	}
+	return boost::none;
+}
+
+static int run_fuzz(const ToolOptions& options)
+{
+	std::printf("Fuzzing with seed %llu\n", static_cast<unsigned long long>(options.fuzz_seed));
+	std::mt19937_64 rng{ options.fuzz_seed };
+	// Random graphs get the same node ids on every run with the same seed
+	csg::Node::seed_ids(options.fuzz_seed);
+
+	std::vector<std::string> seeds;
+	std::vector<fs::path> files;
+	if (find_files(options.paths, files) == false) {
+		return 2;
+	}
+	for (const fs::path& this_file : files) {
+		const boost::optional<std::string> contents{ read_file(this_file) };
+		if (contents.has_value()) {
+			seeds.push_back(*contents);
+		}
+	}
+	for (const csg::SerializedFormat format : { csg::SerializedFormat::TEXT, csg::SerializedFormat::BINARY, csg::SerializedFormat::COMPRESSED }) {
+		for (size_t i = 0; i < 8; i++) {
+			seeds.push_back(make_random_graph(rng, format));
+		}
+	}
+
+	size_t failed_count{ 0 };
+	size_t input_count{ 0 };
+	const auto report = [&](const std::string& name, const boost::optional<std::string>& problem, const double milliseconds) {
+		input_count++;
+		if (problem.has_value()) {
+			failed_count++;
+		}
+		if (problem.has_value() || options.quiet == false) {
+			std::printf("%-4s %10.2f ms  %s", problem.has_value() ? "FAIL" : "OK", milliseconds, name.c_str());
+			if (problem.has_value()) {
+				std::printf(": %s", problem->c_str());
+			}
+			std::printf("\n");
+		}
+	};
+
+	for (const FuzzInput& this_input : make_hostile_inputs(options.fuzz_input_size)) {
+		double milliseconds{ 0.0 };
+		boost::optional<std::string> problem;
+		try {
+			problem = check_fuzz_input(this_input.data, options.min_throughput, milliseconds);
+		}
+		catch (const std::exception& exception) {
+			problem = std::string{ "threw " } + exception.what();
+		}
+		report(this_input.name + " (" + std::to_string(this_input.data.size()) + " bytes)", problem, milliseconds);
+	}
+
+	// Random inputs are only reported when they fail, there are too many to list
+	double total_milliseconds{ 0.0 };
+	for (size_t i = 0; i < options.fuzz_iterations; i++) {
+		const std::string& seed{ seeds[rng() % seeds.size()] };
+		const std::string data{ mutate(seed, rng) };
+		double milliseconds{ 0.0 };
+		boost::optional<std::string> problem;
+		try {
+			problem = check_fuzz_input(data, options.min_throughput, milliseconds);
+		}
+		catch (const std::exception& exception) {
+			problem = std::string{ "threw " } + exception.what();
+		}
+		total_milliseconds += milliseconds;
+		if (problem.has_value()) {
+			report("random input " + std::to_string(i), problem, milliseconds);
+		}
+		else {
+			input_count++;
+		}
+	}
+	if (options.fuzz_iterations > 0) {
+		std::printf("%zu random inputs in %.2f ms\n", options.fuzz_iterations, total_milliseconds);
+	}
+
+	std::printf("%zu inputs, %zu failed\n", input_count, failed_count);
+	return failed_count == 0 ? 0 : 1;
+}
+
+int main(const int argc, const char* const argv[])
+{
+	const boost::optional<ToolOptions> opt_options{ parse_args(argc, argv) };
+	if (opt_options.has_value() == false) {
+		std::cerr << USAGE;
+		return 2;
+	}
+	const ToolOptions& options{ *opt_options };
+	if (options.mode == ToolMode::FUZZ) {
+		return run_fuzz(options);
+	}
+
+	std::vector<fs::path> files;
+	if (find_files(options.paths, files) == false) {
+		return 2;
+	}
+
+	const auto start_time{ std::chrono::steady_clock::now() };
+
+	std::vector<FileResult> results(files.size());
+	std::atomic<size_t> next_file{ 0 };
+	std::mutex output_mutex;
+	const auto worker = [&]() {
+		for (size_t index = next_file++; index < files.size(); index = next_file++) {
+			const auto file_start_time{ std::chrono::steady_clock::now() };
+			FileResult this_result{ process_file(files[index], options) };
+			const std::chrono::duration<double, std::milli> elapsed{ std::chrono::steady_clock::now() - file_start_time };
+			this_result.milliseconds = elapsed.count();
+
+			// Report each file as it finishes so progress is visible on long runs
+			if (this_result.status == FileStatus::FAILED || options.quiet == false) {
+				const char* const status_name{ this_result.status == FileStatus::FAILED ? "FAIL" : "OK" };
+				std::lock_guard<std::mutex> lock{ output_mutex };
+				std::printf("%-4s %10.2f ms  %s", status_name, this_result.milliseconds, files[index].string().c_str());
+				if (this_result.message.empty() == false) {
+					std::printf(": %s", this_result.message.c_str());
+				}
+				std::printf("\n");
+			}
+			results[index] = std::move(this_result);
+		}
+	};
+
+	const size_t thread_count{ std::min(options.thread_count, std::max<size_t>(files.size(), 1)) };
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < thread_count; i++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& this_thread : threads) {
+		this_thread.join();
+	}
+
+	const std::chrono::duration<double> total_time{ std::chrono::steady_clock::now() - start_time };
+	size_t failed_count{ 0 };
+	size_t rewritten_count{ 0 };
+	double slowest_time{ 0.0 };
+	size_t slowest_index{ 0 };
+	for (size_t i = 0; i < results.size(); i++) {
+		if (results[i].status == FileStatus::FAILED) {
+			failed_count++;
+		}
+		else if (results[i].status == FileStatus::REWRITTEN) {
+			rewritten_count++;
+		}
+		if (results[i].milliseconds > slowest_time) {
+			slowest_time = results[i].milliseconds;
+			slowest_index = i;
+		}
+	}
+
+	std::printf("%zu files, %zu failed, %zu rewritten in %.2f s on %zu %s\n", files.size(), failed_count, rewritten_count, total_time.count(), thread_count, (thread_count == 1) ? "thread" : "threads");
+	if (results.empty() == false) {
+		std::printf("Slowest file: %.2f ms  %s\n", slowest_time, files[slowest_index].string().c_str());
+	}
+
+	return failed_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Defines integer hashing helpers.
+ */
+
+#include <cstdint>
+
+namespace csc {
+	// Spreads every bit of value over the whole result, this is the output step of the splitmix64 generator
+	inline uint64_t mix_hash(uint64_t value)
+	{
+		value ^= value >> 30;
+		value *= 0xbf58476d1ce4e5b9ull;
+		value ^= value >> 27;
+		value *= 0x94d049bb133111ebull;
+		value ^= value >> 31;
+		return value;
+	}
+
+	// Hash of a sequence, the result depends on the order values are combined in
+	inline uint64_t combine_hash(const uint64_t seed, const uint64_t value)
+	{
+		return mix_hash(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+	}
+}
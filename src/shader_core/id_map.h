@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Defines IdMap.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hash.h"
+
+namespace csc {
+	/**
+	 * @brief Hash table from integer ids to values, stored in a single array with linear probing.
+	 * Erasing shifts later entries back into the gap, so the table never fills up with deleted markers.
+	 */
+	template <typename K, typename V> class IdMap {
+		static_assert(std::is_integral<K>::value, "IdMap keys must be integers");
+
+	public:
+		// Returns nullptr if the key is not in the map
+		// The pointer is only valid until the next insert or erase
+		V* find(const K key)
+		{
+			const FindResult result{ find_bucket(key) };
+			return result.found ? &buckets[result.index].value : nullptr;
+		}
+		const V* find(const K key) const
+		{
+			const FindResult result{ find_bucket(key) };
+			return result.found ? &buckets[result.index].value : nullptr;
+		}
+
+		bool contains(const K key) const { return find_bucket(key).found; }
+
+		// Returns false and leaves the map unchanged if the key is already present
+		bool insert(const K key, V value)
+		{
+			if ((_size + 1) * 2 > buckets.size()) {
+				rehash(buckets.empty() ? MIN_BUCKET_COUNT : buckets.size() * 2);
+			}
+			const FindResult result{ find_bucket(key) };
+			if (result.found) {
+				return false;
+			}
+			buckets[result.index] = Bucket{ key, std::move(value), true };
+			_size++;
+			return true;
+		}
+
+		// Returns the value for key, adding a default constructed value first if the key is not present
+		V& operator[](const K key)
+		{
+			const FindResult existing{ find_bucket(key) };
+			if (existing.found) {
+				return buckets[existing.index].value;
+			}
+			insert(key, V{});
+			return buckets[find_bucket(key).index].value;
+		}
+
+		bool erase(const K key)
+		{
+			const FindResult result{ find_bucket(key) };
+			if (result.found == false) {
+				return false;
+			}
+
+			// Move each following entry back into the gap unless that would put it before its home bucket
+			const size_t mask{ buckets.size() - 1 };
+			size_t gap{ result.index };
+			for (size_t i = (gap + 1) & mask; buckets[i].occupied; i = (i + 1) & mask) {
+				const size_t home{ hash(buckets[i].key) & mask };
+				if (((i - home) & mask) >= ((i - gap) & mask)) {
+					buckets[gap] = std::move(buckets[i]);
+					gap = i;
+				}
+			}
+			buckets[gap] = Bucket{};
+			_size--;
+			return true;
+		}
+
+		void clear()
+		{
+			buckets.clear();
+			_size = 0;
+		}
+
+		void reserve(const size_t count)
+		{
+			size_t bucket_count{ MIN_BUCKET_COUNT };
+			while (bucket_count < count * 2) {
+				bucket_count *= 2;
+			}
+			if (bucket_count > buckets.size()) {
+				rehash(bucket_count);
+			}
+		}
+
+		size_t size() const { return _size; }
+		bool empty() const { return _size == 0; }
+
+	private:
+		static constexpr size_t MIN_BUCKET_COUNT{ 16 };
+
+		struct Bucket {
+			K key{};
+			V value{};
+			bool occupied{ false };
+		};
+
+		struct FindResult {
+			size_t index;
+			bool found;
+		};
+
+		// Ids are often random already, but mix them anyway so sequential ids spread over the table
+		static size_t hash(const K key) { return static_cast<size_t>(mix_hash(static_cast<uint64_t>(key))); }
+
+		// Index of the bucket holding key, or of the empty bucket where it would go
+		FindResult find_bucket(const K key) const
+		{
+			if (buckets.empty()) {
+				return FindResult{ 0, false };
+			}
+			const size_t mask{ buckets.size() - 1 };
+			for (size_t i = hash(key) & mask; ; i = (i + 1) & mask) {
+				if (buckets[i].occupied == false) {
+					return FindResult{ i, false };
+				}
+				if (buckets[i].key == key) {
+					return FindResult{ i, true };
+				}
+			}
+		}
+
+		void rehash(const size_t bucket_count)
+		{
+			assert((bucket_count & (bucket_count - 1)) == 0);
+			std::vector<Bucket> old_buckets(bucket_count);
+			old_buckets.swap(buckets);
+			const size_t mask{ buckets.size() - 1 };
+			for (Bucket& this_bucket : old_buckets) {
+				if (this_bucket.occupied) {
+					size_t i{ hash(this_bucket.key) & mask };
+					while (buckets[i].occupied) {
+						i = (i + 1) & mask;
+					}
+					buckets[i] = std::move(this_bucket);
+				}
+			}
+		}
+
+		std::vector<Bucket> buckets;
+		size_t _size{ 0 };
+	};
+
+	template <typename K, typename V> constexpr size_t IdMap<K, V>::MIN_BUCKET_COUNT;
+}
@@ -0,0 +1,216 @@
+#include "lz.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+/*
+ * The compressed stream is a series of sequences, each one made of:
+ *   u8 token, literal length in the high four bits and match length minus MIN_MATCH in the low four bits
+ *   Extra literal length bytes if the literal length in the token is 15, each added to it until one is not 255
+ *   Literal bytes
+ *   u16 little-endian offset back into the output where the match begins
+ *   Extra match length bytes, same as for literals
+ * The last sequence ends after its literals and has no match
+ */
+
+constexpr size_t MIN_MATCH{ 4 };
+constexpr size_t MAX_OFFSET{ 65535 };
+constexpr uint8_t LENGTH_MASK{ 15 };
+constexpr uint8_t LENGTH_BYTE_MAX{ 255 };
+
+// The hash table holds the last position seen for each hash of 4 bytes
+constexpr size_t HASH_BITS{ 15 };
+constexpr size_t WINDOW_SIZE{ MAX_OFFSET + 1 };
+// Earlier positions with the same hash checked for a longer match, more is slower but compresses better
+constexpr size_t MAX_CHAIN_ATTEMPTS{ 16 };
+
+static uint32_t read_u32(const char* const data)
+{
+	uint32_t result;
+	std::memcpy(&result, data, sizeof(result));
+	return result;
+}
+
+static size_t hash_u32(const uint32_t value)
+{
+	return static_cast<size_t>((value * 2654435761u) >> (32 - HASH_BITS));
+}
+
+static void append_length(std::string& output, size_t length)
+{
+	while (length >= LENGTH_BYTE_MAX) {
+		output += static_cast<char>(LENGTH_BYTE_MAX);
+		length -= LENGTH_BYTE_MAX;
+	}
+	output += static_cast<char>(length);
+}
+
+// A match_length of 0 writes the final sequence
+static void append_sequence(std::string& output, const char* const literals, const size_t literal_count, const size_t offset, const size_t match_length)
+{
+	const size_t match_code{ match_length == 0 ? 0 : match_length - MIN_MATCH };
+	const uint8_t token{ static_cast<uint8_t>(
+		(std::min<size_t>(literal_count, LENGTH_MASK) << 4) | std::min<size_t>(match_code, LENGTH_MASK)
+	) };
+	output += static_cast<char>(token);
+	if (literal_count >= LENGTH_MASK) {
+		append_length(output, literal_count - LENGTH_MASK);
+	}
+	output.append(literals, literal_count);
+
+	if (match_length == 0) {
+		return;
+	}
+	output += static_cast<char>(offset & 0xff);
+	output += static_cast<char>(offset >> 8);
+	if (match_code >= LENGTH_MASK) {
+		append_length(output, match_code - LENGTH_MASK);
+	}
+}
+
+// Add extra length bytes starting at pos to length, returns false if input ends first
+static bool read_length(const boost::string_view input, size_t& pos, size_t& length)
+{
+	while (pos < input.size()) {
+		const uint8_t this_byte{ static_cast<uint8_t>(input[pos]) };
+		pos++;
+		length += this_byte;
+		if (this_byte != LENGTH_BYTE_MAX) {
+			return true;
+		}
+	}
+	return false;
+}
+
+std::string csc::lz_compress(const boost::string_view input)
+{
+	assert(input.size() < std::numeric_limits<uint32_t>::max());
+
+	std::string output;
+	output.reserve(input.size() / 2 + 16);
+
+	// Positions are stored plus one so 0 can mean empty
+	// Each position links to the previous one with the same hash, back as far as a match can reach
+	std::vector<uint32_t> last_position(static_cast<size_t>(1) << HASH_BITS, 0);
+	std::vector<uint32_t> previous_position(WINDOW_SIZE, 0);
+	const char* const data{ input.data() };
+	const auto insert_position = [&](const size_t pos) -> size_t {
+		const size_t hash{ hash_u32(read_u32(data + pos)) };
+		const size_t result{ last_position[hash] };
+		previous_position[pos % WINDOW_SIZE] = static_cast<uint32_t>(result);
+		last_position[hash] = static_cast<uint32_t>(pos + 1);
+		return result;
+	};
+
+	size_t literal_begin{ 0 };
+	size_t pos{ 0 };
+	while (pos + MIN_MATCH <= input.size()) {
+		// Find the longest match among the most recent positions with the same hash
+		size_t best_length{ 0 };
+		size_t best_offset{ 0 };
+		size_t candidate_plus_one{ insert_position(pos) };
+		for (size_t attempt = 0; attempt < MAX_CHAIN_ATTEMPTS && candidate_plus_one != 0; attempt++) {
+			const size_t candidate{ candidate_plus_one - 1 };
+			if (pos - candidate > MAX_OFFSET) {
+				break;
+			}
+			size_t match_length{ 0 };
+			while (pos + match_length < input.size() && data[candidate + match_length] == data[pos + match_length]) {
+				match_length++;
+			}
+			if (match_length > best_length) {
+				best_length = match_length;
+				best_offset = pos - candidate;
+			}
+			candidate_plus_one = previous_position[candidate % WINDOW_SIZE];
+		}
+
+		if (best_length < MIN_MATCH) {
+			pos++;
+			continue;
+		}
+
+		append_sequence(output, data + literal_begin, pos - literal_begin, best_offset, best_length);
+		const size_t match_end{ pos + best_length };
+		for (pos++; pos < match_end && pos + MIN_MATCH <= input.size(); pos++) {
+			insert_position(pos);
+		}
+		pos = match_end;
+		literal_begin = pos;
+	}
+	append_sequence(output, data + literal_begin, input.size() - literal_begin, 0, 0);
+
+	return output;
+}
+
+boost::optional<std::string> csc::lz_decompress(const boost::string_view compressed, const size_t decompressed_size)
+{
+	// No sequence can expand to more than this many times its size, so anything larger is corrupt
+	constexpr size_t MAX_EXPANSION{ LENGTH_BYTE_MAX };
+	if (decompressed_size > compressed.size() * MAX_EXPANSION + MIN_MATCH + LENGTH_MASK) {
+		return boost::none;
+	}
+
+	std::string output;
+	output.reserve(decompressed_size);
+	size_t pos{ 0 };
+	bool final_sequence_read{ false };
+	while (pos < compressed.size()) {
+		const uint8_t token{ static_cast<uint8_t>(compressed[pos]) };
+		pos++;
+
+		size_t literal_count{ static_cast<size_t>(token >> 4) };
+		if (literal_count == LENGTH_MASK && read_length(compressed, pos, literal_count) == false) {
+			return boost::none;
+		}
+		if (literal_count > compressed.size() - pos || literal_count > decompressed_size - output.size()) {
+			return boost::none;
+		}
+		output.append(compressed.data() + pos, literal_count);
+		pos += literal_count;
+
+		if (pos == compressed.size()) {
+			final_sequence_read = true;
+			break;
+		}
+
+		if (compressed.size() - pos < 2) {
+			return boost::none;
+		}
+		const size_t offset{ static_cast<size_t>(static_cast<uint8_t>(compressed[pos])) | static_cast<size_t>(static_cast<uint8_t>(compressed[pos + 1])) << 8 };
+		pos += 2;
+		size_t match_length{ static_cast<size_t>(token & LENGTH_MASK) };
+		if (match_length == LENGTH_MASK && read_length(compressed, pos, match_length) == false) {
+			return boost::none;
+		}
+		match_length += MIN_MATCH;
+		if (offset == 0 || offset > output.size() || match_length > decompressed_size - output.size()) {
+			return boost::none;
+		}
+
+		const size_t match_dest{ output.size() };
+		output.resize(match_dest + match_length);
+		char* const out{ &output[0] };
+		if (offset >= match_length) {
+			std::memcpy(out + match_dest, out + match_dest - offset, match_length);
+		}
+		else {
+			// The match overlaps the bytes it produces, so copy one at a time
+			for (size_t i = 0; i < match_length; i++) {
+				out[match_dest + i] = out[match_dest - offset + i];
+			}
+		}
+	}
+
+	// Input that stops right after a match has lost its final sequence
+	if (final_sequence_read == false || output.size() != decompressed_size) {
+		return boost::none;
+	}
+	return output;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Declares a small LZ77 style byte compressor.
+ */
+
+#include <cstddef>
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+namespace csc {
+	// Compress arbitrary bytes, the result is binary and does not record the input size
+	std::string lz_compress(boost::string_view input);
+	// Returns none if compressed is malformed or does not expand to exactly decompressed_size bytes
+	boost::optional<std::string> lz_decompress(boost::string_view compressed, size_t decompressed_size);
+}
@@ -0,0 +1,197 @@
+#include "number_format.h"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <boost/utility/string_view.hpp>
+
+#include "number_parse.h"
+
+// A float is always recovered exactly from 9 significant digits
+constexpr int MAX_SIGNIFICANT_DIGITS{ 9 };
+
+// Exponents in this range are written without scientific notation, which parse_float handles without falling back
+constexpr int MIN_FIXED_EXPONENT{ -10 };
+constexpr int MAX_FIXED_EXPONENT{ 15 };
+
+// Writes an unsigned integer backwards from end, returns the first character written
+static char* write_digits(char* const end, uint64_t value)
+{
+	char* begin{ end };
+	do {
+		--begin;
+		*begin = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	return begin;
+}
+
+static double power_of_ten(const int exponent)
+{
+	static constexpr double POWERS[]{
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+		1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31,
+		1e32, 1e33, 1e34, 1e35, 1e36, 1e37, 1e38, 1e39, 1e40, 1e41, 1e42, 1e43, 1e44, 1e45, 1e46, 1e47,
+		1e48, 1e49, 1e50, 1e51, 1e52, 1e53, 1e54, 1e55, 1e56, 1e57, 1e58, 1e59, 1e60, 1e61, 1e62, 1e63
+	};
+	const size_t index{ static_cast<size_t>(std::abs(exponent)) };
+	assert(index < sizeof(POWERS) / sizeof(double));
+	return exponent < 0 ? 1.0 / POWERS[index] : POWERS[index];
+}
+
+// Multiply by 10^exponent, dividing for negative exponents to keep the result as accurate as possible
+static double scale_by_ten(const double value, const int exponent)
+{
+	return exponent < 0 ? value / power_of_ten(-exponent) : value * power_of_ten(exponent);
+}
+
+// Lay out significant digits with the given decimal exponent of the first digit
+static size_t format_decimal(char* const out, const bool negative, const char* const digits, const size_t digit_count, const int exponent)
+{
+	char* cursor{ out };
+	if (negative) {
+		*cursor++ = '-';
+	}
+
+	if (exponent < MIN_FIXED_EXPONENT || exponent > MAX_FIXED_EXPONENT) {
+		*cursor++ = digits[0];
+		if (digit_count > 1) {
+			*cursor++ = '.';
+			std::memcpy(cursor, digits + 1, digit_count - 1);
+			cursor += digit_count - 1;
+		}
+		*cursor++ = 'e';
+		if (exponent < 0) {
+			*cursor++ = '-';
+		}
+		std::array<char, 8> exponent_buffer;
+		char* const exponent_end{ exponent_buffer.data() + exponent_buffer.size() };
+		const char* const exponent_begin{ write_digits(exponent_end, static_cast<uint64_t>(std::abs(exponent))) };
+		std::memcpy(cursor, exponent_begin, exponent_end - exponent_begin);
+		cursor += exponent_end - exponent_begin;
+	}
+	else if (exponent < 0) {
+		*cursor++ = '0';
+		*cursor++ = '.';
+		for (int i = exponent + 1; i < 0; i++) {
+			*cursor++ = '0';
+		}
+		std::memcpy(cursor, digits, digit_count);
+		cursor += digit_count;
+	}
+	else {
+		const size_t integer_count{ static_cast<size_t>(exponent) + 1 };
+		for (size_t i = 0; i < integer_count; i++) {
+			*cursor++ = (i < digit_count) ? digits[i] : '0';
+		}
+		if (digit_count > integer_count) {
+			*cursor++ = '.';
+			std::memcpy(cursor, digits + integer_count, digit_count - integer_count);
+			cursor += digit_count - integer_count;
+		}
+	}
+
+	return static_cast<size_t>(cursor - out);
+}
+
+void csc::append_float(std::string& output, const float value)
+{
+	if (std::isnan(value)) {
+		output += "nan";
+		return;
+	}
+	if (std::isinf(value)) {
+		output += (value < 0.0f) ? "-inf" : "inf";
+		return;
+	}
+	const bool negative{ std::signbit(value) };
+	if (value == 0.0f) {
+		output += negative ? "-0" : "0";
+		return;
+	}
+
+	const float float_magnitude{ std::fabs(value) };
+	const double magnitude{ float_magnitude };
+	int exponent{ static_cast<int>(std::floor(std::log10(magnitude))) };
+	// log10 may be off by one right next to a power of ten
+	if (scale_by_ten(1.0, exponent) > magnitude) {
+		exponent--;
+	}
+	else if (scale_by_ten(1.0, exponent + 1) <= magnitude) {
+		exponent++;
+	}
+
+	// Any decimal strictly between the midpoints to the neighboring floats reads back as this float
+	// The midpoints themselves round to whichever float has an even mantissa
+	const float next_up{ std::nextafter(float_magnitude, std::numeric_limits<float>::infinity()) };
+	// Past the max float the next step up would be 2^128
+	const double next_up_double{ std::isinf(next_up) ? std::ldexp(1.0, std::numeric_limits<float>::max_exponent) : next_up };
+	const double upper_bound{ (magnitude + next_up_double) / 2.0 };
+	const double lower_bound{ (magnitude + std::nextafter(float_magnitude, 0.0f)) / 2.0 };
+	uint32_t float_bits;
+	std::memcpy(&float_bits, &float_magnitude, sizeof(float));
+	const bool bounds_inclusive{ (float_bits & 1) == 0 };
+
+	std::array<char, 64> buffer;
+	std::array<char, 24> digit_buffer;
+	char* const digit_end{ digit_buffer.data() + digit_buffer.size() };
+
+	// Find the fewest significant digits that can land inside the bounds
+	for (int precision = 1; precision <= MAX_SIGNIFICANT_DIGITS; precision++) {
+		const int scale{ precision - 1 - exponent };
+		const double scaled_lower{ scale_by_ten(lower_bound, scale) };
+		const double scaled_upper{ scale_by_ten(upper_bound, scale) };
+		double candidate{ std::round(scale_by_ten(magnitude, scale)) };
+		if (candidate > scaled_upper || (candidate == scaled_upper && bounds_inclusive == false)) {
+			candidate -= 1.0;
+		}
+		else if (candidate < scaled_lower || (candidate == scaled_lower && bounds_inclusive == false)) {
+			candidate += 1.0;
+		}
+		const bool in_bounds{ bounds_inclusive ?
+			(candidate >= scaled_lower && candidate <= scaled_upper) :
+			(candidate > scaled_lower && candidate < scaled_upper) };
+		if (in_bounds == false && precision < MAX_SIGNIFICANT_DIGITS) {
+			continue;
+		}
+
+		uint64_t digits{ static_cast<uint64_t>(candidate) };
+		int digits_exponent{ exponent };
+		if (digits >= static_cast<uint64_t>(power_of_ten(precision))) {
+			// Rounding carried into a new leading digit
+			digits /= 10;
+			digits_exponent++;
+		}
+		while (digits % 10 == 0) {
+			digits /= 10;
+		}
+
+		const char* const digit_begin{ write_digits(digit_end, digits) };
+		const size_t length{ format_decimal(buffer.data(), negative, digit_begin, digit_end - digit_begin, digits_exponent) };
+		const boost::string_view candidate_text{ buffer.data(), length };
+		// Bounds were computed with rounded arithmetic, so confirm by reading the text back
+		if (parse_float(candidate_text) == value || precision == MAX_SIGNIFICANT_DIGITS) {
+			output.append(candidate_text.data(), candidate_text.size());
+			return;
+		}
+	}
+}
+
+void csc::append_int(std::string& output, const int value)
+{
+	std::array<char, 16> buffer;
+	char* const end{ buffer.data() + buffer.size() };
+	// Widen before negating so INT_MIN is handled
+	const int64_t wide_value{ value };
+	char* begin{ write_digits(end, static_cast<uint64_t>(wide_value < 0 ? -wide_value : wide_value)) };
+	if (wide_value < 0) {
+		--begin;
+		*begin = '-';
+	}
+	output.append(begin, end - begin);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Declares locale-independent functions to write numbers as text.
+ */
+
+#include <string>
+
+namespace csc {
+	// Append the shortest decimal text that parse_float will read back as exactly the same float
+	void append_float(std::string& output, float value);
+	void append_int(std::string& output, int value);
+}
@@ -0,0 +1,131 @@
+#include "number_parse.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+
+// Sign, digits and decimal exponent of a number in the serializer grammar
+struct DecimalNumber {
+	bool negative{ false };
+	uint64_t digits{ 0 };
+	size_t digit_count{ 0 };
+	size_t fraction_count{ 0 };
+};
+
+// Max digits that always fit in a uint64_t
+constexpr size_t MAX_DIGITS{ 19 };
+
+// Returns false if input is not entirely [+-]digits[.digits] or has too many digits to hold
+static bool read_decimal(const boost::string_view input, DecimalNumber& result)
+{
+	size_t i{ 0 };
+	if (i < input.size() && (input[i] == '-' || input[i] == '+')) {
+		result.negative = (input[i] == '-');
+		i++;
+	}
+
+	bool seen_point{ false };
+	bool seen_digit{ false };
+	for (; i < input.size(); i++) {
+		const char this_char{ input[i] };
+		if (this_char >= '0' && this_char <= '9') {
+			seen_digit = true;
+			if (result.digits == 0 && this_char == '0') {
+				// Leading zeros do not count against the digit limit
+				if (seen_point) {
+					result.fraction_count++;
+				}
+				continue;
+			}
+			result.digit_count++;
+			if (result.digit_count > MAX_DIGITS) {
+				return false;
+			}
+			result.digits = result.digits * 10 + static_cast<uint64_t>(this_char - '0');
+			if (seen_point) {
+				result.fraction_count++;
+			}
+		}
+		else if (this_char == '.' && seen_point == false) {
+			seen_point = true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	return seen_digit;
+}
+
+float csc::parse_float(const boost::string_view input)
+{
+	DecimalNumber decimal;
+	if (read_decimal(input, decimal) == false) {
+		return parse_float_stream(input);
+	}
+
+	if (decimal.digits == 0) {
+		return decimal.negative ? -0.0f : 0.0f;
+	}
+
+	// When both the digits and the power of ten are exact in a float, one division gives the correctly rounded result
+	constexpr uint64_t MAX_EXACT_FLOAT{ static_cast<uint64_t>(1) << 24 };
+	constexpr float POWERS_FLOAT[]{ 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+	if (decimal.digits <= MAX_EXACT_FLOAT && decimal.fraction_count < sizeof(POWERS_FLOAT) / sizeof(float)) {
+		const float result{ static_cast<float>(decimal.digits) / POWERS_FLOAT[decimal.fraction_count] };
+		return decimal.negative ? -result : result;
+	}
+
+	// Otherwise do the same in double precision, then round to float
+	// Rounding twice can only go wrong if the double lands exactly halfway between two floats
+	constexpr uint64_t MAX_EXACT_DOUBLE{ static_cast<uint64_t>(1) << 53 };
+	constexpr double POWERS_DOUBLE[]{
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	if (decimal.digits <= MAX_EXACT_DOUBLE && decimal.fraction_count < sizeof(POWERS_DOUBLE) / sizeof(double)) {
+		const double result_double{ static_cast<double>(decimal.digits) / POWERS_DOUBLE[decimal.fraction_count] };
+		const float result{ static_cast<float>(result_double) };
+		const float neighbor{ std::nextafter(result, static_cast<double>(result) < result_double ? std::numeric_limits<float>::max() : 0.0f) };
+		const bool is_halfway{ result_double * 2.0 == static_cast<double>(result) + static_cast<double>(neighbor) };
+		if (is_halfway == false) {
+			return decimal.negative ? -result : result;
+		}
+	}
+
+	return parse_float_stream(input);
+}
+
+int csc::parse_int(const boost::string_view input)
+{
+	DecimalNumber decimal;
+	// Anything up to 9 digits fits in an int
+	if (read_decimal(input, decimal) == false || decimal.fraction_count != 0 || decimal.digit_count > 9 || input.back() == '.') {
+		return parse_int_stream(input);
+	}
+
+	const int result{ static_cast<int>(decimal.digits) };
+	return decimal.negative ? -result : result;
+}
+
+float csc::parse_float_stream(const boost::string_view input)
+{
+	std::istringstream stream{ input.to_string() };
+	stream.imbue(std::locale::classic());
+	float result{ 0.0f };
+	stream >> result;
+	return result;
+}
+
+int csc::parse_int_stream(const boost::string_view input)
+{
+	std::istringstream stream{ input.to_string() };
+	stream.imbue(std::locale::classic());
+	int result{ 0 };
+	stream >> result;
+	return result;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Declares locale-independent functions to parse numbers from text.
+ */
+
+#include <boost/utility/string_view.hpp>
+
+namespace csc {
+	// Parse a number written as an optional sign, decimal digits and an optional fraction, as done by the graph serializer
+	// Input outside of that grammar is handed to the stream parsers below, so results always match them exactly
+	float parse_float(boost::string_view input);
+	int parse_int(boost::string_view input);
+
+	// Reference parsers built on a stringstream with the classic locale, 0 is returned if nothing could be parsed
+	float parse_float_stream(boost::string_view input);
+	int parse_int_stream(boost::string_view input);
+}
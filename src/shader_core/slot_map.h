@@ -0,0 +1,175 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Defines SlotMap.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace csc {
+	/**
+	 * @brief Container that keeps its values in one contiguous array and refers to them by handle.
+	 * Values stay in the order they were inserted unless moved with move_to_back, so a scan of values() visits them in that order.
+	 * A handle stays valid while its value is moved around the array, and once its value is erased it never refers to anything again.
+	 */
+	template <typename T> class SlotMap {
+	public:
+		class Handle {
+		public:
+			Handle() = default;
+
+			bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+			bool operator!=(const Handle& other) const { return operator==(other) == false; }
+
+		private:
+			friend class SlotMap<T>;
+			Handle(const uint32_t index, const uint32_t generation) : index{ index }, generation{ generation } {}
+
+			uint32_t index{ std::numeric_limits<uint32_t>::max() };
+			uint32_t generation{ 0 };
+		};
+
+		// Adds value after every existing value
+		Handle insert(T value)
+		{
+			uint32_t slot_index;
+			if (free_slots.empty() == false) {
+				slot_index = free_slots.back();
+				free_slots.pop_back();
+			}
+			else {
+				assert(slots.size() < EMPTY_SLOT);
+				slot_index = static_cast<uint32_t>(slots.size());
+				slots.push_back(Slot{});
+			}
+			slots[slot_index].dense_index = static_cast<uint32_t>(dense.size());
+			dense.push_back(std::move(value));
+			dense_slots.push_back(slot_index);
+			return Handle{ slot_index, slots[slot_index].generation };
+		}
+
+		bool contains(const Handle handle) const
+		{
+			return handle.index < slots.size() && slots[handle.index].generation == handle.generation && slots[handle.index].dense_index != EMPTY_SLOT;
+		}
+
+		// Returns nullptr if the handle's value has been erased
+		// The pointer is only valid until the next insert, erase or move
+		T* get(const Handle handle) { return contains(handle) ? &dense[slots[handle.index].dense_index] : nullptr; }
+		const T* get(const Handle handle) const { return contains(handle) ? &dense[slots[handle.index].dense_index] : nullptr; }
+
+		// Handle of the value at the given position in values()
+		Handle handle_at(const size_t dense_index) const
+		{
+			assert(dense_index < dense.size());
+			const uint32_t slot_index{ dense_slots[dense_index] };
+			return Handle{ slot_index, slots[slot_index].generation };
+		}
+
+		// Erase every value pred returns true for in a single pass, the rest keep their order
+		template <typename Pred> size_t erase_if(Pred pred)
+		{
+			size_t write_index{ 0 };
+			for (size_t read_index = 0; read_index < dense.size(); read_index++) {
+				const uint32_t slot_index{ dense_slots[read_index] };
+				if (pred(static_cast<const T&>(dense[read_index]))) {
+					release_slot(slot_index);
+					continue;
+				}
+				if (write_index != read_index) {
+					dense[write_index] = std::move(dense[read_index]);
+					dense_slots[write_index] = slot_index;
+				}
+				slots[slot_index].dense_index = static_cast<uint32_t>(write_index);
+				write_index++;
+			}
+			const size_t erased_count{ dense.size() - write_index };
+			dense.erase(dense.begin() + write_index, dense.end());
+			dense_slots.resize(write_index);
+			return erased_count;
+		}
+
+		bool erase(const Handle handle)
+		{
+			if (contains(handle) == false) {
+				return false;
+			}
+			const size_t dense_index{ slots[handle.index].dense_index };
+			dense.erase(dense.begin() + dense_index);
+			dense_slots.erase(dense_slots.begin() + dense_index);
+			release_slot(handle.index);
+			update_dense_indices(dense_index, dense.size());
+			return true;
+		}
+
+		// Move a value after every other value, the values after it shift down by one
+		void move_to_back(const Handle handle)
+		{
+			if (contains(handle) == false) {
+				return;
+			}
+			const size_t dense_index{ slots[handle.index].dense_index };
+			std::rotate(dense.begin() + dense_index, dense.begin() + dense_index + 1, dense.end());
+			std::rotate(dense_slots.begin() + dense_index, dense_slots.begin() + dense_index + 1, dense_slots.end());
+			update_dense_indices(dense_index, dense.size());
+		}
+
+		void clear()
+		{
+			for (const uint32_t this_slot : dense_slots) {
+				release_slot(this_slot);
+			}
+			dense.clear();
+			dense_slots.clear();
+		}
+
+		void reserve(const size_t capacity)
+		{
+			dense.reserve(capacity);
+			dense_slots.reserve(capacity);
+		}
+
+		// All values in order, mutable access is only given through handles so the order can not be broken
+		const std::vector<T>& values() const { return dense; }
+		size_t size() const { return dense.size(); }
+		bool empty() const { return dense.empty(); }
+
+	private:
+		static constexpr uint32_t EMPTY_SLOT{ std::numeric_limits<uint32_t>::max() };
+
+		struct Slot {
+			uint32_t dense_index{ EMPTY_SLOT };
+			uint32_t generation{ 0 };
+		};
+
+		// Bumping the generation makes every existing handle to this slot stale
+		void release_slot(const uint32_t slot_index)
+		{
+			slots[slot_index].dense_index = EMPTY_SLOT;
+			slots[slot_index].generation++;
+			free_slots.push_back(slot_index);
+		}
+
+		void update_dense_indices(const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++) {
+				slots[dense_slots[i]].dense_index = static_cast<uint32_t>(i);
+			}
+		}
+
+		std::vector<T> dense;
+		// Slot index of each value in dense
+		std::vector<uint32_t> dense_slots;
+		std::vector<Slot> slots;
+		std::vector<uint32_t> free_slots;
+	};
+
+	template <typename T> constexpr uint32_t SlotMap<T>::EMPTY_SLOT;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Defines StringTable.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
+
+namespace csc {
+	/**
+	 * @brief Hash table from names to values that is built once and then only read.
+	 * Keys are views and must outlive the table, it is meant for names that are string literals.
+	 * Building tries several hash seeds to find one where no two keys share a bucket, so most lookups compare a single key.
+	 */
+	template <typename T> class StringTable {
+	public:
+		StringTable() = default;
+
+		// If a key appears more than once the first value is kept, the same as a linear search would find
+		StringTable(const std::vector<std::pair<boost::string_view, T>>& entries)
+		{
+			for (const auto& this_entry : entries) {
+				if (find_in(_entries, this_entry.first) == nullptr) {
+					_entries.push_back(this_entry);
+				}
+			}
+			if (_entries.empty()) {
+				return;
+			}
+
+			// Keep the table at most half full so probes after a collision are short
+			size_t bucket_count{ 1 };
+			while (bucket_count < _entries.size() * 2) {
+				bucket_count *= 2;
+			}
+			buckets.assign(bucket_count, EMPTY_BUCKET);
+			mask = bucket_count - 1;
+
+			for (uint64_t this_seed = 0; this_seed < MAX_SEED_ATTEMPTS; this_seed++) {
+				seed = this_seed;
+				if (fill_buckets(false)) {
+					_perfect = true;
+					return;
+				}
+			}
+			seed = 0;
+			fill_buckets(true);
+		}
+
+		// Returns nullptr if the key is not in the table
+		const T* find(const boost::string_view key) const
+		{
+			if (buckets.empty()) {
+				return nullptr;
+			}
+			for (size_t i = hash(key) & mask; buckets[i] != EMPTY_BUCKET; i = (i + 1) & mask) {
+				const std::pair<boost::string_view, T>& this_entry{ _entries[buckets[i]] };
+				if (this_entry.first == key) {
+					return &this_entry.second;
+				}
+			}
+			return nullptr;
+		}
+
+		size_t size() const { return _entries.size(); }
+		// True if every key has a bucket to itself
+		bool perfect() const { return _perfect; }
+
+	private:
+		static constexpr uint32_t EMPTY_BUCKET{ std::numeric_limits<uint32_t>::max() };
+		static constexpr uint64_t MAX_SEED_ATTEMPTS{ 64 };
+
+		// Only used while building, where the entry count is small
+		static const T* find_in(const std::vector<std::pair<boost::string_view, T>>& entries, const boost::string_view key)
+		{
+			for (const auto& this_entry : entries) {
+				if (this_entry.first == key) {
+					return &this_entry.second;
+				}
+			}
+			return nullptr;
+		}
+
+		// FNV-1a with the seed mixed into the starting state, then a final mix so the low bits depend on every byte
+		size_t hash(const boost::string_view key) const
+		{
+			uint64_t result{ 14695981039346656037ull ^ (seed * 0x9e3779b97f4a7c15ull) };
+			for (const char this_char : key) {
+				result ^= static_cast<uint8_t>(this_char);
+				result *= 1099511628211ull;
+			}
+			result ^= result >> 32;
+			result *= 0xd6e8feb86659fd93ull;
+			result ^= result >> 32;
+			return static_cast<size_t>(result);
+		}
+
+		// Returns false if a collision was found and allow_collisions is false
+		bool fill_buckets(const bool allow_collisions)
+		{
+			std::fill(buckets.begin(), buckets.end(), EMPTY_BUCKET);
+			for (size_t entry_index = 0; entry_index < _entries.size(); entry_index++) {
+				size_t bucket{ hash(_entries[entry_index].first) & mask };
+				if (buckets[bucket] != EMPTY_BUCKET && allow_collisions == false) {
+					return false;
+				}
+				while (buckets[bucket] != EMPTY_BUCKET) {
+					bucket = (bucket + 1) & mask;
+				}
+				buckets[bucket] = static_cast<uint32_t>(entry_index);
+			}
+			return true;
+		}
+
+		std::vector<std::pair<boost::string_view, T>> _entries;
+		std::vector<uint32_t> buckets;
+		size_t mask{ 0 };
+		uint64_t seed{ 0 };
+		bool _perfect{ false };
+	};
+
+	template <typename T> constexpr uint32_t StringTable<T>::EMPTY_BUCKET;
+	template <typename T> constexpr uint64_t StringTable<T>::MAX_SEED_ATTEMPTS;
+}
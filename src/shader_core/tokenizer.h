@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Defines Tokenizer.
+ */
+
+#include <cassert>
+#include <cstddef>
+
+#include <boost/utility/string_view.hpp>
+
+namespace csc {
+	/**
+	 * @brief Splits a string on a single separator character without copying.
+	 * Every token is a view into the input, which must outlive the tokenizer. Empty tokens are skipped.
+	 */
+	class Tokenizer {
+	public:
+		Tokenizer(const boost::string_view input, const char separator) : input{ input }, separator{ separator }
+		{
+			seek(0);
+		}
+
+		bool done() const { return token_begin >= input.size(); }
+
+		boost::string_view front() const
+		{
+			assert(done() == false);
+			return input.substr(token_begin, token_end - token_begin);
+		}
+
+		boost::string_view next()
+		{
+			const boost::string_view result{ front() };
+			seek(token_end);
+			return result;
+		}
+
+		// Offset of the next token in the input, or the input size once done
+		size_t position() const { return token_begin; }
+
+		// Check whether next() can be called count times before the input is exhausted
+		bool has_tokens(size_t count) const
+		{
+			Tokenizer copy{ *this };
+			while (count > 0) {
+				if (copy.done()) {
+					return false;
+				}
+				copy.next();
+				count--;
+			}
+			return true;
+		}
+
+	private:
+		void seek(size_t pos)
+		{
+			while (pos < input.size() && input[pos] == separator) {
+				pos++;
+			}
+			token_begin = pos;
+			if (pos < input.size()) {
+				const size_t found{ input.find(separator, pos) };
+				token_end = (found == boost::string_view::npos) ? input.size() : found;
+			}
+			else {
+				token_end = pos;
+			}
+		}
+
+		boost::string_view input;
+		char separator;
+
+		size_t token_begin{ 0 };
+		size_t token_end{ 0 };
+	};
+}
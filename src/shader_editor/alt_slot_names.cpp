@@ -7,7 +7,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 	const char* const unused = "(unused)";
 	switch (node.type()) {
 	case csg::NodeType::MAP_RANGE:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("type") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("type") }) {
 			const csg::MapRangeType type{ static_cast<csg::MapRangeType>(opt_value->get()) };
 			if (disp_name == "Steps") {
 				if (type != csg::MapRangeType::STEPPED) {
@@ -25,7 +25,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::MATH:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("type") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("type") }) {
 			const size_t type_int = opt_value->get();
 			const csg::MathType type{ static_cast<csg::MathType>(type_int) };
 			switch (type) {
@@ -191,7 +191,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::VECTOR_MATH:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("type") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("type") }) {
 			const size_t type_int = opt_value->get();
 			const csg::VectorMathType type{ static_cast<csg::VectorMathType>(type_int) };
 			// Shortcut for a common case, scale will almost always be replaced here
@@ -254,7 +254,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::TANGENT:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("direction") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("direction") }) {
 			const csg::TangentDirection type{ static_cast<csg::TangentDirection>(opt_value->get()) };
 			if (disp_name == "Radial Axis" && type != csg::TangentDirection::RADIAL) {
 				return unused;
@@ -262,7 +262,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::PRINCIPLED_BSDF:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("distribution") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("distribution") }) {
 			const csg::PrincipledBSDFDistribution dist{ static_cast<csg::PrincipledBSDFDistribution>(opt_value->get()) };
 			if (disp_name == "Transmission Roughness") {
 				if (dist == csg::PrincipledBSDFDistribution::GGX) {
@@ -275,7 +275,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::PRINCIPLED_HAIR:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("coloring") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("coloring") }) {
 			const csg::PrincipledHairColoring color{ static_cast<csg::PrincipledHairColoring>(opt_value->get()) };
 			if (color != csg::PrincipledHairColoring::ABSORPTION_COEFFICIENT && disp_name == "Absorption Coefficient") {
 				return unused;
@@ -291,7 +291,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::SUBSURFACE_SCATTER:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("falloff") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("falloff") }) {
 			const csg::SubsurfaceScatterFalloff color{ static_cast<csg::SubsurfaceScatterFalloff>(opt_value->get()) };
 			if (color != csg::SubsurfaceScatterFalloff::CUBIC && disp_name == "Sharpness") {
 				return unused;
@@ -299,7 +299,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::MUSGRAVE_TEX:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("dimensions") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("dimensions") }) {
 			const csg::MusgraveTexDimensions dim{ static_cast<csg::MusgraveTexDimensions>(opt_value->get()) };
 			if (dim == csg::MusgraveTexDimensions::ONE && disp_name == "Vector") {
 				return unused;
@@ -308,7 +308,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 				return unused;
 			}
 		}
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("type") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("type") }) {
 			const csg::MusgraveTexType dim{ static_cast<csg::MusgraveTexType>(opt_value->get()) };
 			const std::array<csg::MusgraveTexType, 3>
 				with_offset{ csg::MusgraveTexType::RIDGED_MULTIFRACTAL, csg::MusgraveTexType::HYBRID_MULTIFRACTAL, csg::MusgraveTexType::HETERO_TERRAIN };
@@ -334,7 +334,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::NOISE_TEX:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("dimensions") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("dimensions") }) {
 			const csg::NoiseTexDimensions dim{ static_cast<csg::NoiseTexDimensions>(opt_value->get()) };
 			if (dim == csg::NoiseTexDimensions::ONE && disp_name == "Vector") {
 				return unused;
@@ -345,7 +345,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::VORONOI_TEX:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("dimensions") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("dimensions") }) {
 			const csg::VoronoiTexDimensions dim{ static_cast<csg::VoronoiTexDimensions>(opt_value->get()) };
 			if (dim == csg::VoronoiTexDimensions::ONE && disp_name == "Vector") {
 				return unused;
@@ -354,7 +354,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 				return unused;
 			}
 		}
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("feature") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("feature") }) {
 			const csg::VoronoiTexFeature feat{ static_cast<csg::VoronoiTexFeature>(opt_value->get()) };
 			const std::array<csg::VoronoiTexFeature, 3> with_metric{ csg::VoronoiTexFeature::F1, csg::VoronoiTexFeature::F2, csg::VoronoiTexFeature::SMOOTH_F1 };
 			const std::array<csg::VoronoiTexFeature, 3> with_exponent{ csg::VoronoiTexFeature::F1, csg::VoronoiTexFeature::F2, csg::VoronoiTexFeature::SMOOTH_F1 };
@@ -378,7 +378,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 			else if (disp_name == "Exponent") {
 				const bool use_exponent{ std::find(with_exponent.begin(), with_exponent.end(), feat) != with_exponent.end() };
 				if (use_exponent) {
-					if (const auto opt_metric{ node.slot_value_as<csg::EnumSlotValue>("metric") }) {
+					if (const auto opt_metric{ node.slot_value_ptr<csg::EnumSlotValue>("metric") }) {
 						const csg::VoronoiTexMetric metric{ static_cast<csg::VoronoiTexMetric>(opt_metric->get()) };
 						if (metric == csg::VoronoiTexMetric::MINKOWSKI) {
 							return disp_name;
@@ -395,7 +395,7 @@ boost::string_view cse::get_alt_slot_name(const csg::Node& node, const boost::st
 		}
 		break;
 	case csg::NodeType::WHITE_NOISE_TEX:
-		if (const auto opt_value{ node.slot_value_as<csg::EnumSlotValue>("dimensions") }) {
+		if (const auto opt_value{ node.slot_value_ptr<csg::EnumSlotValue>("dimensions") }) {
 			const csg::WhiteNoiseTexDimensions dim{ static_cast<csg::WhiteNoiseTexDimensions>(opt_value->get()) };
 			if (dim == csg::WhiteNoiseTexDimensions::ONE && disp_name == "Vector") {
 				return unused;
@@ -0,0 +1,129 @@
+#include "graph_saver.h"
+
+#include <string>
+#include <utility>
+
+#include "shader_graph/graph.h"
+#include "shader_graph/serialize.h"
+
+#include "shared_state.h"
+
+cse::GraphSaver::GraphSaver(const std::shared_ptr<SharedState>& shared_state, const csg::Graph& output_graph) :
+	shared_state{ shared_state },
+	output_graph{ std::make_shared<const csg::Graph>(output_graph) }
+{
+	worker = std::thread{ &GraphSaver::worker_loop, this };
+}
+
+cse::GraphSaver::~GraphSaver()
+{
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		stop = true;
+	}
+	wake_worker.notify_one();
+	// Saves already requested are still finished so closing the window does not lose them
+	worker.join();
+}
+
+void cse::GraphSaver::save_to_host(const csg::Graph& graph)
+{
+	// Copy before taking the lock, the worker never sees the live graph
+	std::shared_ptr<const csg::Graph> snapshot{ std::make_shared<const csg::Graph>(graph) };
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		pending_host_save = std::move(snapshot);
+	}
+	wake_worker.notify_one();
+}
+
+void cse::GraphSaver::save_to_file(const csg::Graph& graph, const Platform::FilePath& path)
+{
+	FileSave file_save{ std::make_shared<const csg::Graph>(graph), path };
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		pending_file_save = std::move(file_save);
+	}
+	wake_worker.notify_one();
+}
+
+void cse::GraphSaver::set_output_graph(const csg::Graph& graph)
+{
+	std::shared_ptr<const csg::Graph> new_output_graph{ std::make_shared<const csg::Graph>(graph) };
+	std::lock_guard<std::mutex> lock{ mutex };
+	pending_host_save.reset();
+	output_graph = std::move(new_output_graph);
+}
+
+bool cse::GraphSaver::busy() const
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+	return saving || pending_host_save || pending_file_save.has_value();
+}
+
+size_t cse::GraphSaver::failed_save_count() const
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+	return _failed_save_count;
+}
+
+bool cse::GraphSaver::last_save_failed() const
+{
+	std::lock_guard<std::mutex> lock{ mutex };
+	return _last_save_failed;
+}
+
+void cse::GraphSaver::worker_loop()
+{
+	std::unique_lock<std::mutex> lock{ mutex };
+	while (true) {
+		wake_worker.wait(lock, [this] { return stop || pending_host_save || pending_file_save.has_value(); });
+
+		if (pending_host_save) {
+			const std::shared_ptr<const csg::Graph> graph{ std::move(pending_host_save) };
+			pending_host_save.reset();
+			saving = true;
+			lock.unlock();
+			do_save_to_host(graph);
+			lock.lock();
+			saving = false;
+		}
+		else if (pending_file_save) {
+			const FileSave file_save{ std::move(*pending_file_save) };
+			pending_file_save = boost::none;
+			saving = true;
+			lock.unlock();
+			const bool written{ Platform::write_graph_file(file_save.path, file_save.graph->serialize()) };
+			lock.lock();
+			saving = false;
+			if (written == false) {
+				_failed_save_count++;
+			}
+			_last_save_failed = (written == false);
+		}
+		else if (stop) {
+			return;
+		}
+	}
+}
+
+void cse::GraphSaver::do_save_to_host(const std::shared_ptr<const csg::Graph>& graph)
+{
+	std::shared_ptr<const csg::Graph> base_graph;
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		base_graph = output_graph;
+	}
+
+	// Only this thread reads output_graph once it is set, so its lazily decoded values are safe to touch here
+	const std::string serialized_graph{ graph->serialize() };
+	const std::string patch{ csg::serialize_graph_patch(*base_graph, *graph) };
+
+	std::lock_guard<std::mutex> lock{ mutex };
+	if (output_graph != base_graph) {
+		// A new graph was loaded from the host while this one was saving, it would overwrite that
+		return;
+	}
+	shared_state->set_output_graph(serialized_graph, patch);
+	output_graph = graph;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Defines GraphSaver.
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <boost/optional.hpp>
+
+#include "platform.h"
+
+namespace csg {
+	class Graph;
+}
+
+namespace cse {
+
+	class SharedState;
+
+	/**
+	 * @brief Serializes and delivers graphs on a worker thread so saving never stalls the UI.
+	 * Each save works on a snapshot of the graph taken when it was requested.
+	 * A request made while another save to the same destination is waiting replaces it.
+	 */
+	class GraphSaver {
+	public:
+		GraphSaver(const std::shared_ptr<SharedState>& shared_state, const csg::Graph& output_graph);
+		~GraphSaver();
+
+		GraphSaver(const GraphSaver&) = delete;
+		GraphSaver& operator=(const GraphSaver&) = delete;
+
+		void save_to_host(const csg::Graph& graph);
+		void save_to_file(const csg::Graph& graph, const Platform::FilePath& path);
+
+		// Replaces the graph the host is known to have, a host save still in progress is dropped
+		void set_output_graph(const csg::Graph& graph);
+
+		// True while any save is waiting or running
+		bool busy() const;
+
+		// Number of file saves that could not be written, and whether the most recent file save was one of them
+		size_t failed_save_count() const;
+		bool last_save_failed() const;
+
+	private:
+		struct FileSave {
+			std::shared_ptr<const csg::Graph> graph;
+			Platform::FilePath path;
+		};
+
+		void worker_loop();
+
+		void do_save_to_host(const std::shared_ptr<const csg::Graph>& graph);
+
+		const std::shared_ptr<SharedState> shared_state;
+
+		mutable std::mutex mutex;
+		std::condition_variable wake_worker;
+
+		std::shared_ptr<const csg::Graph> pending_host_save;
+		boost::optional<FileSave> pending_file_save;
+		bool saving{ false };
+		bool stop{ false };
+		size_t _failed_save_count{ 0 };
+		bool _last_save_failed{ false };
+
+		// Graph as of the last output to the host, output patches are made relative to this
+		std::shared_ptr<const csg::Graph> output_graph;
+
+		std::thread worker;
+	};
+}
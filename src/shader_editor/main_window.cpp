@@ -15,6 +15,7 @@
 #include "shader_core/vector.h"
 #include "shader_graph/graph.h"
 #include "shader_graph/ramp.h"
+#include "shader_graph/serialize.h"
 #include "shader_graph/slot.h"
 #include "shader_graph/slot_id.h"
 
@@ -26,9 +27,18 @@
 #include "wrapper_glfw_func.h"
 #include "wrapper_glfw_window.h"
 
+// Most curves and ramps of a loaded graph are never opened in a session, so they are only decoded once needed
+static csg::DeserializeOptions get_load_options()
+{
+	csg::DeserializeOptions options;
+	options.lazy_heavy_values = true;
+	return options;
+}
+
 cse::MainWindow::MainWindow(const std::shared_ptr<SharedState>& shared_state) :
 	the_graph{ std::make_shared<csg::Graph>(csg::GraphType::MATERIAL) },
 	shared_state{ shared_state },
+	graph_saver{ shared_state, *the_graph },
 	window_graph{ the_graph },
 	window_param_editor{ the_graph },
 	undo_stack{ *the_graph }
@@ -140,6 +150,13 @@ void cse::MainWindow::event_loop_iteration()
 		}
 	}
 
+	// The graph was marked saved when the save was queued, a write that failed since then undoes that
+	const size_t failed_saves{ graph_saver.failed_save_count() };
+	if (failed_saves != handled_failed_saves) {
+		handled_failed_saves = failed_saves;
+		graph_unsaved = true;
+	}
+
 	glfwSwapBuffers(glfw_window->window_ptr);
 }
 
@@ -170,7 +187,13 @@ void cse::MainWindow::callback_scroll(const double xoffset, const double yoffset
 
 void cse::MainWindow::load_graph(const std::string serialized_graph)
 {
-	const boost::optional<csg::Graph> opt_graph{ csg::Graph::from(serialized_graph) };
+	set_loaded_graph(csg::deserialize_graph(serialized_graph, get_load_options()));
+	// The host already has this graph, so later patches start from here
+	graph_saver.set_output_graph(*the_graph);
+}
+
+void cse::MainWindow::set_loaded_graph(const boost::optional<csg::Graph>& opt_graph)
+{
 	if (opt_graph.has_value()) {
 		*the_graph = *opt_graph;
 		undo_stack.clear(*the_graph);
@@ -342,6 +365,15 @@ cse::InterfaceEventArray cse::MainWindow::run_gui_menu_bar() const
 			}
 		}
 
+		if (graph_saver.busy()) {
+			ImGui::Separator();
+			ImGui::TextDisabled("Saving...");
+		}
+		else if (graph_saver.last_save_failed()) {
+			ImGui::Separator();
+			ImGui::Text("Save failed");
+		}
+
 		ImGui::EndMainMenuBar();
 	}
 
@@ -587,18 +619,23 @@ void cse::MainWindow::do_event(const InterfaceEvent& event)
 				quit_requested = true;
 				break;
 			case InterfaceEventType::SAVE_TO_MAX:
-				shared_state->set_output_graph(the_graph->serialize());
+				graph_saver.save_to_host(*the_graph);
 				graph_unsaved = false;
 				break;
 			case InterfaceEventType::SAVE_TO_FILE:
-				Platform::save_graph_dialog(the_graph->serialize());
-				graph_unsaved = false;
+			{
+				const boost::optional<Platform::FilePath> save_path{ Platform::save_graph_path_dialog() };
+				if (save_path.has_value()) {
+					graph_saver.save_to_file(*the_graph, *save_path);
+					graph_unsaved = false;
+				}
 				break;
+			}
 			case InterfaceEventType::LOAD_FROM_FILE:
 			{
-				const boost::optional<std::string> loaded_graph{ Platform::load_graph_dialog() };
-				if (loaded_graph.has_value()) {
-					load_graph(*loaded_graph);
+				csg::GraphStreamParser parser{ nullptr, get_load_options() };
+				if (Platform::load_graph_dialog(parser)) {
+					set_loaded_graph(parser.finish());
 				}
 				break;
 			}
@@ -637,8 +674,8 @@ void cse::MainWindow::do_event(const InterfaceEvent& event)
 				// Fetch the curve from the graph
 				if (selected_slot) {
 					const csg::SlotId slot_id{ *selected_slot };
-					const auto this_slot_rgb{ the_graph->get_slot_value_as<csg::RGBCurveSlotValue>(slot_id) };
-					const auto this_slot_vec{ the_graph->get_slot_value_as<csg::VectorCurveSlotValue>(slot_id) };
+					const auto this_slot_rgb{ the_graph->get_slot_value_ptr<csg::RGBCurveSlotValue>(slot_id) };
+					const auto this_slot_vec{ the_graph->get_slot_value_ptr<csg::VectorCurveSlotValue>(slot_id) };
 					if (this_slot_rgb) {
 						modal_curve_editor.set_vector(*this_slot_rgb);
 						modal_window = ModalWindow::CURVE_EDITOR;
@@ -685,9 +722,9 @@ void cse::MainWindow::do_event(const InterfaceEvent& event)
 				assert(event.details_as<ModalRampColorPickShowDetails>().has_value());
 				const ModalRampColorPickShowDetails details{ event.details_as<ModalRampColorPickShowDetails>().get() };
 				// Get the current RGB value from the attached slot and index
-				const auto opt_value{ the_graph->get_slot_value_as<csg::ColorRampSlotValue>(details.slot_id) };
+				const auto opt_value{ the_graph->get_slot_value_ptr<csg::ColorRampSlotValue>(details.slot_id) };
 				if (opt_value) {
-					const csg::ColorRamp ramp{ opt_value->get() };
+					const csg::ColorRamp& ramp{ opt_value->get() };
 					if (details.index < ramp.size()) {
 						const csg::ColorRampPoint point{ ramp.get(details.index) };
 						const csc::Float4 rgba{ point.color, point.alpha };
@@ -764,7 +801,7 @@ void cse::MainWindow::do_event(const InterfaceEvent& event)
 			{
 				const boost::optional<ModifySlotRampColorDetails> details{ event.details_as<ModifySlotRampColorDetails>() };
 				assert(details.has_value());
-				const boost::optional<csg::ColorRampSlotValue> opt_ramp{ the_graph->get_slot_value_as<csg::ColorRampSlotValue>(details->slot_id) };
+				const csg::ColorRampSlotValue* const opt_ramp{ the_graph->get_slot_value_ptr<csg::ColorRampSlotValue>(details->slot_id) };
 				if (opt_ramp) {
 					const boost::optional<csg::ColorRampPoint> opt_point{ opt_ramp->get().get(details->point_index) };
 					if (opt_point) {
@@ -784,7 +821,7 @@ void cse::MainWindow::do_event(const InterfaceEvent& event)
 			{
 				const boost::optional<ModifySlotRampPosDetails> details{ event.details_as<ModifySlotRampPosDetails>() };
 				assert(details.has_value());
-				const boost::optional<csg::ColorRampSlotValue> opt_ramp{ the_graph->get_slot_value_as<csg::ColorRampSlotValue>(details->slot_id) };
+				const csg::ColorRampSlotValue* const opt_ramp{ the_graph->get_slot_value_ptr<csg::ColorRampSlotValue>(details->slot_id) };
 				if (opt_ramp) {
 					const boost::optional<csg::ColorRampPoint> opt_point{ opt_ramp->get().get(details->point_index) };
 					if (opt_point) {
@@ -802,10 +839,9 @@ void cse::MainWindow::do_event(const InterfaceEvent& event)
 			{
 				const boost::optional<SlotIdDetails> details{ event.details_as<SlotIdDetails>() };
 				assert(details.has_value());
-				const boost::optional<csg::ColorRampSlotValue> opt_ramp{ the_graph->get_slot_value_as<csg::ColorRampSlotValue>(details->value) };
+				const csg::ColorRampSlotValue* const opt_ramp{ the_graph->get_slot_value_ptr<csg::ColorRampSlotValue>(details->value) };
 				if (opt_ramp) {
-					const csg::ColorRamp ramp{ opt_ramp->get() };
-					std::vector<csg::ColorRampPoint> mut_points{ ramp.get() };
+					std::vector<csg::ColorRampPoint> mut_points{ opt_ramp->get().get() };
 					mut_points.push_back(csg::ColorRampPoint{ 1.0f, csc::Float3{ 1.0f, 1.0f, 1.0f }, 1.0f });
 					const csg::ColorRamp new_ramp{ mut_points };
 					the_graph->set_color_ramp(details->value, new_ramp);
@@ -817,7 +853,7 @@ void cse::MainWindow::do_event(const InterfaceEvent& event)
 			{
 				const boost::optional<ModifySlotRampDeleteDetails> details{ event.details_as<ModifySlotRampDeleteDetails>() };
 				assert(details.has_value());
-				const boost::optional<csg::ColorRampSlotValue> opt_ramp{ the_graph->get_slot_value_as<csg::ColorRampSlotValue>(details->slot_id) };
+				const csg::ColorRampSlotValue* const opt_ramp{ the_graph->get_slot_value_ptr<csg::ColorRampSlotValue>(details->slot_id) };
 				if (opt_ramp) {
 					csg::ColorRamp mut_ramp{ opt_ramp->get() };
 					mut_ramp.remove(details->point_index);
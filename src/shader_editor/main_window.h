@@ -5,6 +5,7 @@
  * @brief Defines MainWindow.
  */
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -14,6 +15,7 @@
 
 #include "enum.h"
 #include "event.h"
+#include "graph_saver.h"
 #include "modal_curve_editor.h"
 #include "modal_ramp_color_pick.h"
 #include "subwindow_alert.h"
@@ -57,6 +59,9 @@ namespace cse {
 		void load_graph(std::string serialized_graph);
 
 	private:
+		// Replaces the current graph, or shows an alert if the graph could not be loaded
+		void set_loaded_graph(const boost::optional<csg::Graph>& opt_graph);
+
 		void new_frame();
 
 		InterfaceEventArray run_gui() const;
@@ -73,8 +78,11 @@ namespace cse {
 
 		std::shared_ptr<csg::Graph> the_graph;
 		bool graph_unsaved{ false };
+		// Failed saves already reported by graph_saver, each new one marks the graph unsaved again
+		size_t handled_failed_saves{ 0 };
 
 		std::shared_ptr<SharedState> shared_state;
+		GraphSaver graph_saver;
 
 		std::unique_ptr<GlfwWindow> glfw_window;
 		ImGuiContext* imgui_context{ nullptr };
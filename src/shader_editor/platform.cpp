@@ -1,13 +1,15 @@
 #include "platform.h"
 
+#include <fstream>
+
 #ifdef _WIN32
 
 #include <array>
-#include <fstream>
-#include <sstream>
 
 #include <ShObjIdl.h>
 
+#include "shader_graph/serialize.h"
+
 // Filters for the save dialog
 static const COMDLG_FILTERSPEC rg_spec[] =
 {
@@ -16,9 +18,9 @@ static const COMDLG_FILTERSPEC rg_spec[] =
 	{ L"All Files", L"*.*" },
 };
 
-bool cse::Platform::save_graph_dialog(const std::string graph)
+boost::optional<cse::Platform::FilePath> cse::Platform::save_graph_path_dialog()
 {
-	bool result{ false };
+	boost::optional<FilePath> result;
 
 #pragma warning( push )
 #pragma warning( disable: 4456 )
@@ -41,10 +43,7 @@ bool cse::Platform::save_graph_dialog(const std::string graph)
 				wchar_t* wstr_ptr{ wstr_path.data() };
 				const HRESULT hr = save_item->GetDisplayName(SIGDN_FILESYSPATH, &wstr_ptr);
 				if (SUCCEEDED(hr)) {
-					std::ofstream file_stream{ wstr_ptr, std::ofstream::trunc };
-					file_stream << graph;
-					file_stream.close();
-					result = true;
+					result = FilePath{ wstr_ptr };
 				}
 
 				save_item->Release();
@@ -58,9 +57,9 @@ bool cse::Platform::save_graph_dialog(const std::string graph)
 	return result;
 }
 
-boost::optional<std::string> cse::Platform::load_graph_dialog()
+bool cse::Platform::load_graph_dialog(csg::GraphStreamParser& parser)
 {
-	boost::optional<std::string> result;
+	bool result{ false };
 
 #pragma warning( push )
 #pragma warning( disable: 4456 )
@@ -81,19 +80,10 @@ boost::optional<std::string> cse::Platform::load_graph_dialog()
 				hr = shell_item->GetDisplayName(SIGDN_FILESYSPATH, &file_path);
 
 				if (SUCCEEDED(hr)) {
-					std::stringstream result_stream;
-					std::ifstream input_file(file_path, std::ifstream::in);
-
-					while (true) {
-						const int c{ input_file.get() };
-						if (c != EOF) {
-							result_stream << static_cast<char>(c);
-						}
-						else {
-							break;
-						}
+					std::ifstream input_file(file_path, std::ifstream::in | std::ifstream::binary);
+					if (input_file.is_open()) {
+						result = parser.feed(input_file);
 					}
-					result = result_stream.str();
 				}
 				shell_item->Release();
 			}
@@ -107,14 +97,25 @@ boost::optional<std::string> cse::Platform::load_graph_dialog()
 
 #else
 
-bool cse::Platform::save_graph_dialog(std::string)
+boost::optional<cse::Platform::FilePath> cse::Platform::save_graph_path_dialog()
 {
-	return false;
+	return boost::none;
 }
 
-boost::optional<std::string> cse::Platform::load_graph_dialog()
+bool cse::Platform::load_graph_dialog(csg::GraphStreamParser&)
 {
-	return boost::none;
+	return false;
 }
 
 #endif
+
+bool cse::Platform::write_graph_file(const FilePath& path, const std::string& graph)
+{
+	std::ofstream file_stream{ path, std::ofstream::trunc };
+	if (file_stream.is_open() == false) {
+		return false;
+	}
+	file_stream << graph;
+	file_stream.close();
+	return file_stream.good();
+}
@@ -9,9 +9,23 @@
 
 #include <boost/optional.hpp>
 
+namespace csg {
+	class GraphStreamParser;
+}
+
 namespace cse {
 	namespace Platform {
-		bool save_graph_dialog(std::string graph);
-		boost::optional<std::string> load_graph_dialog();
+#ifdef _WIN32
+		using FilePath = std::wstring;
+#else
+		using FilePath = std::string;
+#endif
+
+		// Asks the user where to save, returns none if the dialog was cancelled
+		boost::optional<FilePath> save_graph_path_dialog();
+		// Safe to call from any thread
+		bool write_graph_file(const FilePath& path, const std::string& graph);
+		// Streams the selected file into parser, returns false if no file was selected or it could not be read
+		bool load_graph_dialog(csg::GraphStreamParser& parser);
 	}
 }
@@ -42,6 +42,16 @@ std::string cse::ShaderGraphEditor::get_serialized_graph()
 	return impl->get_serialized_graph();
 }
 
+std::string cse::ShaderGraphEditor::get_serialized_graph_compressed()
+{
+	return impl->get_serialized_graph_compressed();
+}
+
+std::string cse::ShaderGraphEditor::get_graph_patch()
+{
+	return impl->get_graph_patch();
+}
+
 void cse::ShaderGraphEditor::force_close()
 {
 	impl->force_close();
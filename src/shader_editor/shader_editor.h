@@ -29,6 +29,10 @@ namespace cse {
 
 		bool has_new_data();
 		std::string get_serialized_graph();
+		// Same as get_serialized_graph but in the much smaller compressed format, load_graph accepts it as well
+		std::string get_serialized_graph_compressed();
+		// Changes since the previous get_serialized_graph or get_graph_patch, apply with csg::apply_graph_patch
+		std::string get_graph_patch();
 
 		void force_close();
 
@@ -6,6 +6,8 @@
 #include <GLFW/glfw3.h>
 #include <imgui.h>
 
+#include "shader_graph/serialize_compressed.h"
+
 #include "main_window.h"
 #include "shared_state.h"
 
@@ -79,6 +81,16 @@ std::string cse::ShaderGraphEditorImpl::get_serialized_graph()
 	return shared_state->get_output_graph();
 }
 
+std::string cse::ShaderGraphEditorImpl::get_serialized_graph_compressed()
+{
+	return csg::compress_serialized_graph(shared_state->get_output_graph());
+}
+
+std::string cse::ShaderGraphEditorImpl::get_graph_patch()
+{
+	return shared_state->get_output_patch();
+}
+
 void cse::ShaderGraphEditorImpl::force_close()
 {
 	shared_state->request_stop();
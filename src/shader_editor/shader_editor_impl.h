@@ -31,6 +31,8 @@ namespace cse {
 
 		bool has_new_data();
 		std::string get_serialized_graph();
+		std::string get_serialized_graph_compressed();
+		std::string get_graph_patch();
 
 		void force_close();
 
@@ -33,13 +33,25 @@ std::string cse::SharedState::get_output_graph()
 {
 	std::lock_guard<std::mutex> lock(output_mutex);
 	const std::string result{ output_graph };
+	output_patch.clear();
 	_output_updated = false;
 	return result;
 }
 
-void cse::SharedState::set_output_graph(const std::string& new_graph)
+std::string cse::SharedState::get_output_patch()
+{
+	std::lock_guard<std::mutex> lock(output_mutex);
+	const std::string result{ output_patch };
+	output_patch.clear();
+	_output_updated = false;
+	return result;
+}
+
+void cse::SharedState::set_output_graph(const std::string& new_graph, const std::string& patch)
 {
 	std::lock_guard<std::mutex> lock(output_mutex);
 	output_graph = new_graph;
+	// Patches that have not been read yet are kept, the reader applies them all in order
+	output_patch += patch;
 	_output_updated = true;
 }
@@ -23,7 +23,9 @@ namespace cse {
 		void set_input_graph(const std::string& new_graph);
 
 		std::string get_output_graph();
-		void set_output_graph(const std::string& new_graph);
+		// Patches describing every output change since the last call to either output getter, in order
+		std::string get_output_patch();
+		void set_output_graph(const std::string& new_graph, const std::string& patch);
 
 		void request_stop() { return stop.store(true); }
 		bool should_stop() { return stop.load(); }
@@ -36,6 +38,7 @@ namespace cse {
 
 		std::mutex output_mutex;
 		std::string output_graph;
+		std::string output_patch;
 		bool _output_updated{ false };
 
 		std::atomic<bool> stop{ false };
@@ -2,20 +2,38 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 #include <imgui.h>
 
+#include "shader_core/config.h"
+#include "shader_core/id_map.h"
 #include "shader_core/lerp.h"
+#include "shader_core/lz.h"
+#include "shader_core/number_format.h"
+#include "shader_core/number_parse.h"
+#include "shader_core/slot_map.h"
+#include "shader_core/string_table.h"
 #include "shader_core/util_enum.h"
 #include "shader_core/vector.h"
 #include "shader_graph/graph.h"
 #include "shader_graph/node.h"
 #include "shader_graph/node_enums.h"
 #include "shader_graph/node_type.h"
+#include "shader_graph/serialize.h"
 #include "shader_graph/slot.h"
 
 #include "enum.h"
@@ -26,6 +44,19 @@ cse::DebugSubwindow::DebugSubwindow() : message("Pres butan to run validation.")
 
 }
 
+// Memory held by a graph with one node of every type
+static size_t node_memory_usage()
+{
+	static const size_t result{ [] {
+		size_t total{ 0 };
+		for (const csg::NodeType this_type : csg::NodeTypeList{}) {
+			total += csg::Node{ this_type, csc::Int2{ 0, 0 } }.memory_usage();
+		}
+		return total;
+	}() };
+	return result;
+}
+
 cse::InterfaceEventArray cse::DebugSubwindow::run() const
 {
 	InterfaceEventArray events;
@@ -52,6 +83,7 @@ cse::InterfaceEventArray cse::DebugSubwindow::run() const
 			ImGui::Text("   ::InterfaceEventDetails: %ld", InterfaceEvent::sizeof_details());
 			ImGui::Text("   ::InterfaceEventArray: %ld", sizeof(InterfaceEventArray));
 			ImGui::Text("csg::Node: %ld", sizeof(csg::Node));
+			ImGui::Text("   ::memory_usage(), one of each type: %ld", node_memory_usage());
 			ImGui::Text("csg::Slot: %ld", sizeof(csg::Slot));
 			ImGui::Text("   ::SlotValue: %ld", sizeof(csg::SlotValue));
 			ImGui::Text("   ::SlotValueUnion: %ld", csg::SlotValue::sizeof_union());
@@ -122,6 +154,228 @@ std::string cse::DebugSubwindow::run_validation() const
 				out_stream << "lerp.h tests failed, see above" << std::endl;
 			}
 		}
+		// id_map.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			{
+				// Enough keys to grow the table several times, with every other one erased to exercise the backward shift
+				csc::IdMap<int64_t, int> map;
+				for (int64_t i = 0; i < 1000; i++) {
+					map.insert(i * 7919, static_cast<int>(i));
+				}
+				if (map.insert(0, -1)) {
+					++error_count;
+					out_stream << "csc::IdMap::insert replaced an existing key" << std::endl;
+				}
+				for (int64_t i = 0; i < 1000; i += 2) {
+					map.erase(i * 7919);
+				}
+				size_t mismatch_count{ 0 };
+				for (int64_t i = 0; i < 1000; i++) {
+					const int* const value{ map.find(i * 7919) };
+					const bool valid{ i % 2 == 0 ? value == nullptr : value != nullptr && *value == i };
+					if (!valid) {
+						++mismatch_count;
+					}
+				}
+				if (mismatch_count > 0 || map.size() != 500) {
+					++error_count;
+					out_stream << "csc::IdMap::find returned the wrong value for " << mismatch_count << " keys after erasing" << std::endl;
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "id_map.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "id_map.h tests failed, see above" << std::endl;
+			}
+		}
+		// lz.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			const char* const test_strings[]{ "", "a", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "cycles_shader|1|section_nodes|math|_nodeid_AAAAAAAAAAA=|0|0|math|_nodeid_AAAAAAAAAAE=|0|0|" };
+			for (const char* const this_string : test_strings) {
+				const std::string compressed{ csc::lz_compress(this_string) };
+				const boost::optional<std::string> decompressed{ csc::lz_decompress(compressed, std::strlen(this_string)) };
+				if (decompressed.has_value() == false || *decompressed != this_string) {
+					++error_count;
+					out_stream << "csc::lz_compress round trip failed for: " << this_string << std::endl;
+				}
+				if (compressed.empty() == false && csc::lz_decompress(compressed.substr(0, compressed.size() - 1), std::strlen(this_string)).has_value()) {
+					++error_count;
+					out_stream << "csc::lz_decompress accepted truncated input for: " << this_string << std::endl;
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "lz.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "lz.h tests failed, see above" << std::endl;
+			}
+		}
+		// number_format.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			{
+				const float test_values[]{ 0.0f, -0.0f, 0.1f, -1.5f, 1.0f / 3.0f, 1234.5678f, 1e-12f, 3e20f, std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min() };
+				for (const float this_value : test_values) {
+					std::string text;
+					csc::append_float(text, this_value);
+					const float result{ csc::parse_float(text) };
+					if (std::memcmp(&result, &this_value, sizeof(float)) != 0) {
+						++error_count;
+						out_stream << "csc::append_float wrote \"" << text << "\" which does not read back as the same value" << std::endl;
+					}
+				}
+			}
+
+			{
+				std::string text;
+				csc::append_float(text, 0.25f);
+				const bool valid{ text == "0.25" };
+				if (!valid) {
+					++error_count;
+					out_stream << "csc::append_float(0.25f) failed with: " << text << std::endl;
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "number_format.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "number_format.h tests failed, see above" << std::endl;
+			}
+		}
+		// number_parse.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			{
+				// Every value from -10 to 10 as written at SERIALIZED_GRAPH_PRECISION must match the stream parser bit for bit
+				int scale{ 1 };
+				for (int i = 0; i < SERIALIZED_GRAPH_PRECISION; i++) {
+					scale *= 10;
+				}
+				size_t mismatch_count{ 0 };
+				for (int i = -10 * scale; i <= 10 * scale; i++) {
+					std::stringstream value_stream;
+					value_stream.imbue(std::locale::classic());
+					value_stream << (i < 0 ? "-" : "") << std::abs(i) / scale << '.' << std::setw(SERIALIZED_GRAPH_PRECISION) << std::setfill('0') << std::abs(i) % scale;
+					const std::string value_string{ value_stream.str() };
+					const float result{ csc::parse_float(value_string) };
+					const float expected{ csc::parse_float_stream(value_string) };
+					if (std::memcmp(&result, &expected, sizeof(float)) != 0) {
+						++mismatch_count;
+						if (mismatch_count <= 5) {
+							out_stream << "csc::parse_float(\"" << value_string << "\") does not match stream result" << std::endl;
+						}
+					}
+				}
+				error_count += mismatch_count;
+			}
+
+			{
+				const char* const int_strings[]{ "0", "-0", "+7", "123456789", "-123456789", "2147483647", "-2147483648", "99999999999", "12.", "" };
+				for (const char* const this_string : int_strings) {
+					const int result{ csc::parse_int(this_string) };
+					const int expected{ csc::parse_int_stream(this_string) };
+					if (result != expected) {
+						++error_count;
+						out_stream << "csc::parse_int(\"" << this_string << "\") failed with: " << result << std::endl;
+					}
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "number_parse.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "number_parse.h tests failed, see above" << std::endl;
+			}
+		}
+		// slot_map.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			{
+				csc::SlotMap<int> map;
+				const csc::SlotMap<int>::Handle handle_a{ map.insert(1) };
+				const csc::SlotMap<int>::Handle handle_b{ map.insert(2) };
+				const csc::SlotMap<int>::Handle handle_c{ map.insert(3) };
+				map.move_to_back(handle_a);
+				const bool valid_order{ map.values() == std::vector<int>{ 2, 3, 1 } };
+				if (!valid_order) {
+					++error_count;
+					out_stream << "csc::SlotMap::move_to_back did not keep the order of the other values" << std::endl;
+				}
+				map.erase_if([](const int value) { return value == 3; });
+				if (map.get(handle_c) != nullptr || map.get(handle_a) == nullptr || *map.get(handle_a) != 1 || *map.get(handle_b) != 2) {
+					++error_count;
+					out_stream << "csc::SlotMap::erase_if left a handle pointing at the wrong value" << std::endl;
+				}
+				// The new value reuses the erased slot, which must not bring the old handle back
+				const csc::SlotMap<int>::Handle handle_d{ map.insert(4) };
+				if (map.get(handle_c) != nullptr || map.get(handle_d) == nullptr || *map.get(handle_d) != 4) {
+					++error_count;
+					out_stream << "csc::SlotMap::insert made a stale handle valid again" << std::endl;
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "slot_map.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "slot_map.h tests failed, see above" << std::endl;
+			}
+		}
+		// string_table.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			{
+				const std::vector<std::pair<boost::string_view, int>> entries{ { "color", 1 }, { "fac", 2 }, { "color", 3 }, { "", 4 } };
+				const csc::StringTable<int> table{ entries };
+				const bool valid_size{ table.size() == 3 };
+				if (!valid_size) {
+					++error_count;
+					out_stream << "csc::StringTable kept a duplicate key" << std::endl;
+				}
+				const int* const color{ table.find("color") };
+				if (color == nullptr || *color != 1) {
+					++error_count;
+					out_stream << "csc::StringTable::find did not return the first value for a duplicate key" << std::endl;
+				}
+				const int* const empty{ table.find("") };
+				if (empty == nullptr || *empty != 4) {
+					++error_count;
+					out_stream << "csc::StringTable::find failed for an empty key" << std::endl;
+				}
+				if (table.find("colo") != nullptr || table.find("colors") != nullptr) {
+					++error_count;
+					out_stream << "csc::StringTable::find matched a key that was not added" << std::endl;
+				}
+			}
+
+			{
+				const csc::StringTable<int> table;
+				if (table.find("color") != nullptr) {
+					++error_count;
+					out_stream << "csc::StringTable::find matched a key in an empty table" << std::endl;
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "string_table.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "string_table.h tests failed, see above" << std::endl;
+			}
+		}
 		// vector.h
 		{
 			const size_t error_count_begin{ error_count };
@@ -209,6 +463,129 @@ std::string cse::DebugSubwindow::run_validation() const
 				}
 			}
 
+			{
+				// Raising a node draws it on top, and removing nodes keeps the order of the rest
+				csg::Graph test_graph{ csg::GraphType::EMPTY };
+				const csg::NodeId node_a{ test_graph.add(csg::NodeType::ADD_SHADER, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_b{ test_graph.add(csg::NodeType::ADD_SHADER, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_c{ test_graph.add(csg::NodeType::ADD_SHADER, csc::Int2{ 0, 0 }) };
+				test_graph.raise(node_a);
+				test_graph.remove(std::set<csg::NodeId>{ node_b });
+				std::vector<csg::NodeId> draw_order;
+				for (const csg::Node& this_node : test_graph.nodes()) {
+					draw_order.push_back(this_node.id());
+				}
+				const bool valid_order{ draw_order == std::vector<csg::NodeId>{ node_a, node_c } };
+				if (!valid_order) {
+					++error_count;
+					out_stream << "csg::Graph::nodes is not in draw order after raise and remove" << std::endl;
+				}
+				if (test_graph.get(node_b) != nullptr || test_graph.get(node_c) == nullptr || test_graph.get(node_c)->id() != node_c) {
+					++error_count;
+					out_stream << "csg::Graph::get returned the wrong node after remove" << std::endl;
+				}
+			}
+
+			{
+				// Math nodes have their output at index 0 and the Value1 input at index 3
+				csg::Graph test_graph{ csg::GraphType::EMPTY };
+				const csg::NodeId node_a{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_b{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_c{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				test_graph.add_connection(csg::SlotId{ node_a, 0 }, csg::SlotId{ node_b, 3 });
+				test_graph.add_connection(csg::SlotId{ node_a, 0 }, csg::SlotId{ node_c, 3 });
+				test_graph.add_connection(csg::SlotId{ node_c, 0 }, csg::SlotId{ node_b, 3 });
+				const boost::optional<csg::Connection> replaced{ test_graph.connection_to(csg::SlotId{ node_b, 3 }) };
+				if (test_graph.connections().size() != 2 || replaced.has_value() == false || replaced->source().node_id() != node_c) {
+					++error_count;
+					out_stream << "csg::Graph::add_connection did not replace the connection into an input" << std::endl;
+				}
+				if (test_graph.connections_from(node_a).size() != 1 || test_graph.connections_to(node_b).size() != 1) {
+					++error_count;
+					out_stream << "csg::Graph::connections_from or connections_to returned the wrong connections" << std::endl;
+				}
+				test_graph.remove(std::set<csg::NodeId>{ node_c });
+				if (test_graph.connections().empty() == false || test_graph.connections_from(node_a).empty() == false) {
+					++error_count;
+					out_stream << "csg::Graph::remove kept connections to a removed node" << std::endl;
+				}
+			}
+
+			{
+				// Copies share nodes until one of them changes a node
+				csg::Graph test_graph{ csg::GraphType::EMPTY };
+				const csg::NodeId node_a{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_b{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				csg::Graph copy_graph{ test_graph };
+				if (copy_graph.get(node_a) != test_graph.get(node_a) || copy_graph != test_graph) {
+					++error_count;
+					out_stream << "csg::Graph copy did not share its nodes" << std::endl;
+				}
+				copy_graph.set_float(csg::SlotId{ node_a, 3 }, 7.0f);
+				copy_graph.set_position(node_b, csc::Int2{ 5, 5 });
+				const float original_value{ test_graph.get(node_a)->slot_value_as<csg::FloatSlotValue>(3)->get() };
+				const bool valid_original{ original_value != 7.0f && test_graph.get(node_b)->position == csc::Int2{ 0, 0 } };
+				if (!valid_original || copy_graph.get(node_a) == test_graph.get(node_a) || copy_graph == test_graph) {
+					++error_count;
+					out_stream << "csg::Graph copy changed a node of the graph it was copied from" << std::endl;
+				}
+			}
+
+			{
+				// Versions change with every change, the hash only depends on what the graph holds
+				csg::Graph test_graph{ csg::GraphType::EMPTY };
+				const csg::NodeId node_a{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_b{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				test_graph.add_connection(csg::SlotId{ node_a, 0 }, csg::SlotId{ node_b, 3 });
+				csg::Graph copy_graph{ test_graph };
+				const uint64_t copy_version{ copy_graph.version() };
+				copy_graph.set_position(node_a, csc::Int2{ 0, 0 });
+				copy_graph.add_connection(csg::SlotId{ node_a, 0 }, csg::SlotId{ node_b, 3 });
+				if (copy_version != test_graph.version() || copy_graph.version() != copy_version) {
+					++error_count;
+					out_stream << "csg::Graph version changed without a change to the graph" << std::endl;
+				}
+				copy_graph.set_position(node_a, csc::Int2{ 5, 5 });
+				if (copy_graph.version() == copy_version || copy_graph.structure_hash() == test_graph.structure_hash()) {
+					++error_count;
+					out_stream << "csg::Graph version or structure_hash did not change after a move" << std::endl;
+				}
+				copy_graph.set_position(node_a, csc::Int2{ 0, 0 });
+				copy_graph.remove_connection(csg::SlotId{ node_b, 3 });
+				copy_graph.add_connection(csg::SlotId{ node_a, 0 }, csg::SlotId{ node_b, 3 });
+				if (copy_graph.structure_hash() != test_graph.structure_hash() || copy_graph != test_graph) {
+					++error_count;
+					out_stream << "csg::Graph structure_hash differs after undoing every change" << std::endl;
+				}
+			}
+
+			{
+				// Material output takes displacement at index 2
+				csg::Graph test_graph{ csg::GraphType::MATERIAL };
+				const csg::NodeId node_out{ test_graph.topological_order().front() };
+				const csg::NodeId node_a{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_b{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_c{ test_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				test_graph.add_connection(csg::SlotId{ node_c, 0 }, csg::SlotId{ node_b, 3 });
+				test_graph.add_connection(csg::SlotId{ node_b, 0 }, csg::SlotId{ node_a, 3 });
+				if (test_graph.add_connection(csg::SlotId{ node_a, 0 }, csg::SlotId{ node_c, 3 }) || test_graph.connections().size() != 2) {
+					++error_count;
+					out_stream << "csg::Graph::add_connection accepted a connection that makes a cycle" << std::endl;
+				}
+				const std::vector<csg::NodeId> expected_order{ node_out, node_c, node_b, node_a };
+				if (test_graph.topological_order() != expected_order) {
+					++error_count;
+					out_stream << "csg::Graph::topological_order did not put sources before the nodes they connect into" << std::endl;
+				}
+				test_graph.add_connection(csg::SlotId{ node_a, 0 }, csg::SlotId{ node_out, 2 });
+				const bool all_reach_output{ test_graph.reaches_output(node_a) && test_graph.reaches_output(node_b) && test_graph.reaches_output(node_c) };
+				test_graph.remove(std::set<csg::NodeId>{ node_b });
+				if (all_reach_output == false || test_graph.reaches_output(node_a) == false || test_graph.reaches_output(node_c)) {
+					++error_count;
+					out_stream << "csg::Graph::reaches_output was not updated as connections changed" << std::endl;
+				}
+			}
+
 			if (error_count == error_count_begin) {
 				out_stream << "graph.h tests passed" << std::endl;
 			}
@@ -216,6 +593,419 @@ std::string cse::DebugSubwindow::run_validation() const
 				out_stream << "graph.h tests failed, see above" << std::endl;
 			}
 		}
+		// node.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			// Name lookups must find the same slot as searching the slots in order
+			for (const csg::NodeType this_type : csg::NodeTypeList{}) {
+				const csg::Node test_node{ this_type, csc::Int2{ 0, 0 } };
+				const std::vector<csg::Slot>& slots{ test_node.slots() };
+				for (size_t i = 0; i < slots.size(); i++) {
+					size_t first_by_name{ i };
+					size_t first_by_disp_name{ i };
+					for (size_t j = i; j > 0; j--) {
+						if (slots[j - 1].dir() == slots[i].dir() && std::strcmp(slots[j - 1].name(), slots[i].name()) == 0) {
+							first_by_name = j - 1;
+						}
+						if (slots[j - 1].dir() == slots[i].dir() && std::strcmp(slots[j - 1].disp_name(), slots[i].disp_name()) == 0) {
+							first_by_disp_name = j - 1;
+						}
+					}
+					if (test_node.slot_index(slots[i].dir(), slots[i].name()) != first_by_name) {
+						++error_count;
+						out_stream << "csg::Node::slot_index failed for " << csg::NodeTypeInfo::from(this_type)->name() << " slot " << slots[i].name() << std::endl;
+					}
+					if (test_node.slot_index_by_disp_name(slots[i].dir(), slots[i].disp_name()) != first_by_disp_name) {
+						++error_count;
+						out_stream << "csg::Node::slot_index_by_disp_name failed for " << csg::NodeTypeInfo::from(this_type)->name() << " slot " << slots[i].disp_name() << std::endl;
+					}
+				}
+				if (test_node.slot_index(csg::SlotDirection::INPUT, "not_a_slot").has_value()) {
+					++error_count;
+					out_stream << "csg::Node::slot_index found a slot that does not exist" << std::endl;
+				}
+			}
+
+			// Nodes of a type share their slots, but each has its own values
+			for (const csg::NodeType this_type : csg::NodeTypeList{}) {
+				csg::Node node_a{ this_type, csc::Int2{ 0, 0 } };
+				const csg::Node node_b{ this_type, csc::Int2{ 0, 0 } };
+				if (&node_a.slots() != &node_b.slots() || &node_a.slots() != &csg::Node::slots_of(this_type)) {
+					++error_count;
+					out_stream << "csg::Node::slots is not shared for " << csg::NodeTypeInfo::from(this_type)->name() << std::endl;
+				}
+				if (node_b.memory_usage() != sizeof(csg::Node) || csg::Node{ node_b }.memory_usage() != sizeof(csg::Node)) {
+					++error_count;
+					out_stream << "csg::Node does not share default values for " << csg::NodeTypeInfo::from(this_type)->name() << std::endl;
+				}
+				for (size_t i = 0; i < node_a.slot_count(); i++) {
+					const csg::Slot& this_slot{ node_a.slots()[i] };
+					csg::SlotValue* const value{ node_a.mutable_slot_value(i) };
+					if (value == nullptr) {
+						continue;
+					}
+					if (this_slot.dir() != csg::SlotDirection::INPUT || value->type() != this_slot.type()) {
+						++error_count;
+						out_stream << "csg::Node::slot_value_ptr has the wrong value for " << csg::NodeTypeInfo::from(this_type)->name() << " slot " << this_slot.name() << std::endl;
+						continue;
+					}
+					if (this_slot.type() == csg::SlotType::BOOL) {
+						*value = csg::BoolSlotValue{ value->as<csg::BoolSlotValue>()->get() == false };
+						if (*node_a.slot_value_ptr(i) == *node_b.slot_value_ptr(i)) {
+							++error_count;
+							out_stream << "csg::Node::mutable_slot_value did not change " << csg::NodeTypeInfo::from(this_type)->name() << " slot " << this_slot.name() << std::endl;
+						}
+						if (node_b.slot_value_ptr(i) != csg::Node::default_value_of(this_type, i)) {
+							++error_count;
+							out_stream << "csg::Node::mutable_slot_value changed another node for " << csg::NodeTypeInfo::from(this_type)->name() << std::endl;
+						}
+					}
+				}
+			}
+
+			// Typed pointers point into the node and the in-place setter only reports real changes
+			{
+				csg::Node math_node{ csg::NodeType::MATH, csc::Int2{ 0, 0 } };
+				const boost::optional<size_t> type_index{ math_node.slot_index(csg::SlotDirection::INPUT, "type") };
+				const csg::EnumSlotValue* const enum_value{ math_node.slot_value_ptr<csg::EnumSlotValue>("type") };
+				if (type_index.has_value() == false || enum_value == nullptr || enum_value != math_node.slot_value_ptr<csg::EnumSlotValue>(*type_index) ||
+					math_node.slot_value_ptr<csg::FloatSlotValue>(*type_index) != nullptr)
+				{
+					++error_count;
+					out_stream << "csg::Node::slot_value_ptr<T> returned the wrong pointer" << std::endl;
+				}
+				else {
+					math_node.set_serialized_values(std::make_shared<const std::string>("cached"));
+					if (math_node.set_slot_value<csg::EnumSlotValue>(*type_index, enum_value->get()) || math_node.serialized_values() == nullptr) {
+						++error_count;
+						out_stream << "csg::Node::set_slot_value changed a value that stayed the same" << std::endl;
+					}
+					const size_t new_option{ enum_value->get() == 0 ? size_t{ 1 } : size_t{ 0 } };
+					if (math_node.set_slot_value<csg::EnumSlotValue>(*type_index, new_option) == false || math_node.slot_value_ptr<csg::EnumSlotValue>(*type_index)->get() != new_option || math_node.serialized_values() != nullptr) {
+						++error_count;
+						out_stream << "csg::Node::set_slot_value did not change the value in place" << std::endl;
+					}
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "node.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "node.h tests failed, see above" << std::endl;
+			}
+		}
+		// node_enums.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			for (size_t meta_index = 0; meta_index < static_cast<size_t>(csg::NodeMetaEnum::COUNT); meta_index++) {
+				const csg::NodeMetaEnum meta_enum{ static_cast<csg::NodeMetaEnum>(meta_index) };
+				const size_t option_count{ csg::NodeEnumInfo::from(meta_enum)->count() };
+				for (size_t option = 0; option < option_count; option++) {
+					const csg::NodeEnumOptionInfo option_info{ csg::NodeEnumOptionInfo::from(meta_enum, option).value() };
+					if (csg::NodeEnumOptionInfo::find(meta_enum, option_info.internal_name()) != option) {
+						++error_count;
+						out_stream << "csg::NodeEnumOptionInfo::find failed for " << option_info.internal_name() << std::endl;
+					}
+					if (option_info.alt_name() != nullptr && csg::NodeEnumOptionInfo::find(meta_enum, option_info.alt_name()) != option) {
+						++error_count;
+						out_stream << "csg::NodeEnumOptionInfo::find failed for alternate name " << option_info.alt_name() << std::endl;
+					}
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "node_enums.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "node_enums.h tests failed, see above" << std::endl;
+			}
+		}
+		// node_type.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			for (const csg::NodeType this_type : csg::NodeTypeList{}) {
+				const char* const type_name{ csg::NodeTypeInfo::from(this_type)->name() };
+				const boost::optional<csg::NodeTypeInfo> found_info{ csg::NodeTypeInfo::from(boost::string_view{ type_name }) };
+				if (found_info.has_value() == false || found_info->type() != this_type) {
+					++error_count;
+					out_stream << "csg::NodeTypeInfo::from(boost::string_view) failed for " << type_name << std::endl;
+				}
+			}
+			if (csg::NodeTypeInfo::from(boost::string_view{ "not_a_node" }).has_value()) {
+				++error_count;
+				out_stream << "csg::NodeTypeInfo::from(boost::string_view) found a type that does not exist" << std::endl;
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "node_type.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "node_type.h tests failed, see above" << std::endl;
+			}
+		}
+		// serialize.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			csg::Graph test_graph{ csg::GraphType::MATERIAL };
+			int pos_x{ 0 };
+			for (const csg::NodeType this_type : csg::NodeTypeList()) {
+				test_graph.add(this_type, csc::Int2{ pos_x, -pos_x });
+				pos_x += 10;
+			}
+
+			const std::string binary_string{ test_graph.serialize(csg::SerializedFormat::BINARY) };
+			const boost::optional<csg::Graph> opt_binary_graph{ csg::Graph::from(binary_string) };
+			if (opt_binary_graph.has_value() == false) {
+				++error_count;
+				out_stream << "csg::Graph::from failed to load binary graph" << std::endl;
+			}
+			else if (*opt_binary_graph != test_graph) {
+				++error_count;
+				out_stream << "csg::Graph binary round trip does not match original" << std::endl;
+			}
+
+			const boost::optional<csg::Graph> opt_text_graph{ csg::Graph::from(test_graph.serialize(csg::SerializedFormat::TEXT)) };
+			if (opt_text_graph.has_value() == false || opt_text_graph->serialize(csg::SerializedFormat::BINARY) != binary_string) {
+				++error_count;
+				out_stream << "csg::Graph text and binary formats do not describe the same graph" << std::endl;
+			}
+
+			{
+				// Chunk sizes that split tokens and records in many different places
+				const std::string text_string{ test_graph.serialize(csg::SerializedFormat::TEXT) };
+				const size_t chunk_sizes[]{ 1, 7, 64 };
+				for (const size_t chunk_size : chunk_sizes) {
+					csg::GraphStreamParser parser;
+					for (size_t pos = 0; pos < text_string.size(); pos += chunk_size) {
+						parser.feed(boost::string_view{ text_string }.substr(pos, chunk_size));
+					}
+					const boost::optional<csg::Graph> opt_streamed_graph{ parser.finish() };
+					if (opt_streamed_graph.has_value() == false || *opt_streamed_graph != test_graph) {
+						++error_count;
+						out_stream << "csg::GraphStreamParser with chunk size " << chunk_size << " does not match original" << std::endl;
+					}
+				}
+			}
+
+			{
+				// Enough nodes that the text parser splits them across threads when more than one core is available
+				csg::Graph large_graph{ csg::GraphType::MATERIAL };
+				while (large_graph.nodes().size() < 2048) {
+					for (const csg::NodeType this_type : csg::NodeTypeList()) {
+						large_graph.add(this_type, csc::Int2{ static_cast<int>(large_graph.nodes().size()), 0 });
+					}
+				}
+				const boost::optional<csg::Graph> opt_large_graph{ csg::Graph::from(large_graph.serialize()) };
+				if (opt_large_graph.has_value() == false || *opt_large_graph != large_graph) {
+					++error_count;
+					out_stream << "csg::Graph text round trip of a large graph does not match original" << std::endl;
+				}
+			}
+
+			{
+				// Lazily loaded values must save unchanged and decode to the same graph
+				const std::string text_string{ test_graph.serialize(csg::SerializedFormat::TEXT) };
+				csg::DeserializeOptions lazy_options;
+				lazy_options.lazy_heavy_values = true;
+				const boost::optional<csg::Graph> opt_lazy_graph{ csg::deserialize_graph(text_string, lazy_options) };
+				if (opt_lazy_graph.has_value() == false || opt_lazy_graph->serialize() != text_string) {
+					++error_count;
+					out_stream << "csg::deserialize_graph with lazy values does not save back unchanged" << std::endl;
+				}
+				else {
+					// The copy shares nodes that still hold undecoded values, decoding through either graph must give the original
+					const csg::Graph lazy_copy{ *opt_lazy_graph };
+					if (*opt_lazy_graph != test_graph || lazy_copy != test_graph) {
+						++error_count;
+						out_stream << "csg::deserialize_graph with lazy values does not match original" << std::endl;
+					}
+				}
+			}
+
+			{
+				// The point limit a graph was loaded with also applies to lazy values decoded later
+				csg::Graph curve_graph{ csg::GraphType::EMPTY };
+				const csg::NodeId curve_node_id{ curve_graph.add(csg::NodeType::RGB_CURVES, csc::Int2{ 0, 0 }) };
+				const boost::optional<size_t> curves_index{ curve_graph.get(curve_node_id)->slot_index(csg::SlotDirection::INPUT, "curves") };
+				if (curves_index.has_value()) {
+					const csg::SlotId curves_slot{ curve_node_id, *curves_index };
+					csg::RGBCurveSlotValue curve_value{ *curve_graph.get_slot_value_ptr<csg::RGBCurveSlotValue>(curves_slot) };
+					csg::Curve three_point_curve{ curve_value.get_all() };
+					three_point_curve.create_point(0.5f);
+					curve_value.set_all(three_point_curve);
+					curve_graph.set_curve_rgb(curves_slot, curve_value);
+				}
+
+				const std::string curve_text{ curve_graph.serialize(csg::SerializedFormat::TEXT) };
+				csg::DeserializeOptions eager_options;
+				eager_options.max_curve_points = 2;
+				csg::DeserializeOptions lazy_options{ eager_options };
+				lazy_options.lazy_heavy_values = true;
+				const boost::optional<csg::Graph> opt_eager_graph{ csg::deserialize_graph(curve_text, eager_options) };
+				const boost::optional<csg::Graph> opt_lazy_graph{ csg::deserialize_graph(curve_text, lazy_options) };
+				if (opt_eager_graph.has_value() == false || opt_lazy_graph.has_value() == false || *opt_lazy_graph != *opt_eager_graph) {
+					++error_count;
+					out_stream << "csg::deserialize_graph with lazy values does not apply max_curve_points" << std::endl;
+				}
+			}
+
+			{
+				// Changing a value after a save must not leave stale cached output behind
+				csg::Graph cache_graph{ csg::GraphType::EMPTY };
+				const csg::NodeId node_id{ cache_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const boost::optional<size_t> slot_index{ cache_graph.get(node_id)->slot_index(csg::SlotDirection::INPUT, "value1") };
+				cache_graph.serialize();
+				if (slot_index.has_value() && cache_graph.set_float(csg::SlotId{ node_id, *slot_index }, 0.125f)) {
+					const boost::optional<csg::Graph> opt_reloaded_graph{ csg::Graph::from(cache_graph.serialize()) };
+					if (opt_reloaded_graph.has_value() == false || *opt_reloaded_graph != cache_graph) {
+						++error_count;
+						out_stream << "csg::Graph::serialize wrote stale node values after a change" << std::endl;
+					}
+				}
+				else {
+					++error_count;
+					out_stream << "csg::Graph::set_float failed on math node" << std::endl;
+				}
+			}
+
+			{
+				csg::Graph patched_graph{ test_graph };
+				const csg::NodeId added_id{ patched_graph.add(csg::NodeType::MATH, csc::Int2{ 5, 5 }) };
+				patched_graph.move(std::set<csg::NodeId>{ added_id }, csc::Float2{ 10.0f, 0.0f });
+				const std::string patch_string{ csg::serialize_graph_patch(test_graph, patched_graph) };
+				csg::Graph target_graph{ test_graph };
+				if (csg::apply_graph_patch(target_graph, patch_string) == false || target_graph != patched_graph) {
+					++error_count;
+					out_stream << "csg::apply_graph_patch did not reproduce the patched graph" << std::endl;
+				}
+			}
+
+			{
+				// A patch that no longer fits must be rejected whole, even when the failure is only found while applying it
+				csg::Graph base_graph{ csg::GraphType::EMPTY };
+				const csg::NodeId node_a{ base_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 0 }) };
+				const csg::NodeId node_b{ base_graph.add(csg::NodeType::MATH, csc::Int2{ 10, 0 }) };
+				const boost::optional<size_t> output_index{ base_graph.get(node_a)->slot_index(csg::SlotDirection::OUTPUT, "value") };
+				const boost::optional<size_t> input_index{ base_graph.get(node_a)->slot_index(csg::SlotDirection::INPUT, "value1") };
+				if (output_index.has_value() && input_index.has_value()) {
+					csg::Graph patched_graph{ base_graph };
+					patched_graph.add_connection(csg::SlotId{ node_a, *output_index }, csg::SlotId{ node_b, *input_index });
+					const std::string patch_string{ csg::serialize_graph_patch(base_graph, patched_graph) };
+
+					// The target connects b to a, so the patch would close a cycle
+					csg::Graph cycle_graph{ base_graph };
+					cycle_graph.add_connection(csg::SlotId{ node_b, *output_index }, csg::SlotId{ node_a, *input_index });
+					const csg::Graph cycle_graph_before{ cycle_graph };
+					if (csg::apply_graph_patch(cycle_graph, patch_string) || cycle_graph != cycle_graph_before) {
+						++error_count;
+						out_stream << "csg::apply_graph_patch applied a patch that closes a cycle" << std::endl;
+					}
+
+					// The target already has another connection into the patch's dest, which the patch did not remove
+					csg::Graph drifted_graph{ base_graph };
+					const csg::NodeId node_c{ drifted_graph.add(csg::NodeType::MATH, csc::Int2{ 0, 10 }) };
+					drifted_graph.add_connection(csg::SlotId{ node_c, *output_index }, csg::SlotId{ node_b, *input_index });
+					const csg::Graph drifted_graph_before{ drifted_graph };
+					if (csg::apply_graph_patch(drifted_graph, patch_string) || drifted_graph != drifted_graph_before) {
+						++error_count;
+						out_stream << "csg::apply_graph_patch replaced a connection the patch did not remove" << std::endl;
+					}
+				}
+				else {
+					++error_count;
+					out_stream << "csg::Node::slot_index failed on math node" << std::endl;
+				}
+			}
+
+			{
+				const std::string compressed_string{ test_graph.serialize(csg::SerializedFormat::COMPRESSED) };
+				const boost::optional<csg::Graph> opt_compressed_graph{ csg::Graph::from(compressed_string) };
+				if (opt_compressed_graph.has_value() == false || *opt_compressed_graph != test_graph) {
+					++error_count;
+					out_stream << "csg::Graph compressed round trip does not match original" << std::endl;
+				}
+				if (csg::Graph::from(compressed_string.substr(0, compressed_string.size() - 8)).has_value()) {
+					++error_count;
+					out_stream << "csg::Graph::from accepted truncated compressed graph" << std::endl;
+				}
+			}
+
+			const boost::string_view truncated_string{ binary_string.data(), binary_string.size() - 1 };
+			if (csg::Graph::from(truncated_string).has_value()) {
+				++error_count;
+				out_stream << "csg::Graph::from accepted truncated binary graph" << std::endl;
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "serialize.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "serialize.h tests failed, see above" << std::endl;
+			}
+		}
+		// slot.h
+		{
+			const size_t error_count_begin{ error_count };
+
+			// Copies of a curve share points until one of them is changed
+			{
+				const csg::RGBCurveSlotValue original;
+				csg::RGBCurveSlotValue copy{ original };
+				if (&copy.get_r() != &original.get_r()) {
+					++error_count;
+					out_stream << "csg::RGBCurveSlotValue copy did not share points" << std::endl;
+				}
+				const std::vector<csg::CurvePoint> points{
+					csg::CurvePoint{ csc::Float2{ 0.0f, 0.0f }, csg::CurveInterp::LINEAR },
+					csg::CurvePoint{ csc::Float2{ 0.5f, 0.8f }, csg::CurveInterp::LINEAR },
+					csg::CurvePoint{ csc::Float2{ 1.0f, 1.0f }, csg::CurveInterp::LINEAR }
+				};
+				const csg::Curve new_curve{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f }, points };
+				if (copy.set_r(new_curve) == false || copy == original || original != csg::RGBCurveSlotValue{}) {
+					++error_count;
+					out_stream << "csg::RGBCurveSlotValue::set_r changed the wrong value" << std::endl;
+				}
+				const csg::Curve out_of_bounds{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 2.0f, 2.0f }, points };
+				if (copy.set_g(out_of_bounds) || copy.get_g().similar(original.get_g(), FLOAT_COMPARE_DIFF) == false) {
+					++error_count;
+					out_stream << "csg::RGBCurveSlotValue::set_g accepted a curve with different bounds" << std::endl;
+				}
+			}
+
+			// A value can be assigned over a value of any other type
+			{
+				csg::SlotValue value{ csg::RGBCurveSlotValue{} };
+				value = csg::FloatSlotValue{ 0.5f, 0.0f, 1.0f };
+				if (value.as<csg::RGBCurveSlotValue>().has_value() || value.as<csg::FloatSlotValue>().has_value() == false) {
+					++error_count;
+					out_stream << "csg::SlotValue assigning a float over a curve failed" << std::endl;
+				}
+				value = csg::ColorRampSlotValue{};
+				const csg::SlotValue copy{ value };
+				const csg::SlotValue moved{ std::move(value) };
+				if (copy != moved || moved.as<csg::ColorRampSlotValue>().has_value() == false) {
+					++error_count;
+					out_stream << "csg::SlotValue copying a ramp failed" << std::endl;
+				}
+				value = csg::VectorCurveSlotValue{ csc::Float2{ -1.0f, -1.0f }, csc::Float2{ 1.0f, 1.0f } };
+				if (value.as<csg::VectorCurveSlotValue>().has_value() == false || value.as<csg::VectorCurveSlotValue>()->get_min() != csc::Float2{ -1.0f, -1.0f }) {
+					++error_count;
+					out_stream << "csg::SlotValue assigning to a moved from value failed" << std::endl;
+				}
+			}
+
+			if (error_count == error_count_begin) {
+				out_stream << "slot.h tests passed" << std::endl;
+			}
+			else {
+				out_stream << "slot.h tests failed, see above" << std::endl;
+			}
+		}
 	}
 	{
 		out_stream << "Checking NodeCategoryInfo for each NodeCategory..." << std::endl;
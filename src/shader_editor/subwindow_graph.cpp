@@ -4,7 +4,6 @@
 #include <cassert>
 #include <cmath>
 #include <cstdio>
-#include <list>
 #include <map>
 #include <set>
 #include <vector>
@@ -215,9 +214,9 @@ bool cse::GraphSubwindow::do_event(const InterfaceEvent& event)
 			case InterfaceEventType::FOCUS_SELECTION:
 			{
 				boost::optional<csc::FloatRect> bounding_rect;
-				for (const auto& this_node : the_graph->nodes()) {
-					const NodeGeometry node_geom{ *this_node };
-					if (node_selection.is_selected(this_node->id())) {
+				for (const csg::Node& this_node : the_graph->nodes()) {
+					const NodeGeometry node_geom{ this_node };
+					if (node_selection.is_selected(this_node.id())) {
 						if (bounding_rect) {
 							bounding_rect = bounding_rect->with_point(node_geom.pos()).with_point(node_geom.end());
 						}
@@ -233,12 +232,12 @@ bool cse::GraphSubwindow::do_event(const InterfaceEvent& event)
 			}
 			case InterfaceEventType::FOCUS_OUTPUT:
 			{
-				for (const auto this_node : the_graph->nodes()) {
-					const auto type_info{ csg::NodeTypeInfo::from(this_node->type()) };
-					const NodeGeometry node_geom{ *this_node };
+				for (const csg::Node& this_node : the_graph->nodes()) {
+					const auto type_info{ csg::NodeTypeInfo::from(this_node.type()) };
+					const NodeGeometry node_geom{ this_node };
 					assert(type_info.has_value());
 					if (type_info->category() == csg::NodeCategory::OUTPUT) {
-						view_center = this_node->position + csc::Int2{ node_geom.size() / 2.0f };
+						view_center = this_node.position + csc::Int2{ node_geom.size() / 2.0f };
 					}
 				}
 				break;
@@ -258,8 +257,7 @@ bool cse::GraphSubwindow::do_event(const InterfaceEvent& event)
 			{
 				const boost::optional<csg::SlotId> pin{ get_pin_at_pos( world_to_screen(mouse_world_pos), csg::SlotDirection::INPUT) };
 				if (pin && pending_connection_begin) {
-					the_graph->add_connection(*pending_connection_begin, *pin);
-					graph_altered = true;
+					graph_altered = the_graph->add_connection(*pending_connection_begin, *pin);
 				}
 				pending_connection_begin = boost::none;
 				break;
@@ -287,27 +285,30 @@ bool cse::GraphSubwindow::do_event(const InterfaceEvent& event)
 					if (opt_new_id.has_value()) {
 						old_to_new[original_id] = *opt_new_id;
 						node_selection.select(SelectMode::ADD, *opt_new_id);
+						graph_altered = true;
 					}
 				}
-				// Duplicate connections
-				const std::list<csg::Connection> original_connections{ the_graph->connections() };
-				for (const csg::Connection this_conn : original_connections) {
-					if (old_to_new.count(this_conn.source().node_id()) + old_to_new.count(this_conn.dest().node_id()) < 2) {
-						// Both nodes for this connection were not duplicated, go next
-						continue;
+				// Duplicate connections, any connection between two duplicated nodes goes into one of them
+				for (const auto& this_pair : old_to_new) {
+					for (const csg::Connection this_conn : the_graph->connections_to(this_pair.first)) {
+						if (old_to_new.count(this_conn.source().node_id()) == 0) {
+							// The source node was not duplicated, go next
+							continue;
+						}
+						const csg::SlotId new_source{ old_to_new[this_conn.source().node_id()],  this_conn.source().index() };
+						const csg::SlotId new_dest{ this_pair.second,  this_conn.dest().index() };
+						if (the_graph->add_connection(new_source, new_dest)) {
+							graph_altered = true;
+						}
 					}
-					const csg::SlotId new_source{ old_to_new[this_conn.source().node_id()],  this_conn.source().index() };
-					const csg::SlotId new_dest{ old_to_new[this_conn.dest().node_id()],  this_conn.dest().index() };
-					the_graph->add_connection(new_source, new_dest);
 				}
-				graph_altered = true;
 				break;
 			}
 			case InterfaceEventType::SELECT_ALL:
 			{
 				node_selection.clear();
-				for (const auto this_node : the_graph->nodes()) {
-					node_selection.select(SelectMode::ADD, this_node->id());
+				for (const csg::Node& this_node : the_graph->nodes()) {
+					node_selection.select(SelectMode::ADD, this_node.id());
 				}
 				break;
 			}
@@ -320,9 +321,9 @@ bool cse::GraphSubwindow::do_event(const InterfaceEvent& event)
 			{
 				std::set<csg::NodeId> original_selection{ node_selection.selected() };
 				node_selection.clear();
-				for (const auto this_node : the_graph->nodes()) {
-					if (original_selection.count(this_node->id()) == 0) {
-						node_selection.select(SelectMode::ADD, this_node->id());
+				for (const csg::Node& this_node : the_graph->nodes()) {
+					if (original_selection.count(this_node.id()) == 0) {
+						node_selection.select(SelectMode::ADD, this_node.id());
 					}
 				}
 				break;
@@ -568,17 +569,17 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 	boost::optional<NodeGeometry> connection_src_node_geom;
 
 	// Draw nodes (reverse order so nodes at the beginning of the list are drawn last)
-	for (const auto& node : boost::adaptors::reverse(the_graph->nodes())) {
-		const auto opt_node_type_info{ csg::NodeTypeInfo::from(node->type()) };
+	for (const csg::Node& node : boost::adaptors::reverse(the_graph->nodes())) {
+		const auto opt_node_type_info{ csg::NodeTypeInfo::from(node.type()) };
 		assert(opt_node_type_info.has_value());
 		const csg::NodeTypeInfo node_type_info{ opt_node_type_info.get() };
 
 		// Get node geometry and convert to screen space
-		const NodeGeometry node_geom_world{ *node };
+		const NodeGeometry node_geom_world{ node };
 		const NodeGeometry node_geom{ node_geom_world.with_pos( world_to_screen(node_geom_world.pos()) ) };
 
 		// Store geometry if this node is the pending connection source
-		if (pending_connection_begin && pending_connection_begin->node_id() == node->id()) {
+		if (pending_connection_begin && pending_connection_begin->node_id() == node.id()) {
 			connection_src_node_geom = node_geom;
 		}
 
@@ -587,9 +588,9 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 			continue;
 		}
 
-		const bool node_has_selected_slot = selected_slot ? selected_slot->node_id() == node->id() : false;
+		const bool node_has_selected_slot = selected_slot ? selected_slot->node_id() == node.id() : false;
 
-		const bool is_selected{ node_selection.is_selected(node->id()) };
+		const bool is_selected{ node_selection.is_selected(node.id()) };
 		const ImU32 outline_color = is_selected ? COLOR_NODE_OUTLINE_SELECTED : COLOR_NODE_OUTLINE_DEFAULT;
 
 		// Draw background
@@ -614,7 +615,7 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 		{
 			const csc::Float2 body_begin{ node_geom.pos() + csc::Float2{ 0.0f, NODE_HEADER_HEIGHT} };
 			// Lines between slots
-			for (unsigned int i = 1; i < node->slots().size(); i++) {
+			for (unsigned int i = 1; i < node.slot_count(); i++) {
 				const csc::Float2 p0{ body_begin + csc::Float2{ 0.0f, i * NODE_ROW_HEIGHT } };
 				const csc::Float2 p1{ node_geom.end().x, body_begin.y + NODE_ROW_HEIGHT * i };
 				ImGui::DrawList::AddLine(draw_list, p0, p1, COLOR_NODE_OUTLINE_DEFAULT);
@@ -626,7 +627,9 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 
 			// Main body of slot
 			size_t slots_drawn{ 0 };
-			for (const auto& slot : node->slots()) {
+			// Curve and ramp values are not drawn, so any that were loaded lazily can stay undecoded
+			for (const auto& slot : node.slots()) {
+				const csg::SlotValue* const slot_value{ node.slot_value_ptr_without_decoding(slots_drawn) };
 
 				const bool highlight_this_slot = node_has_selected_slot && selected_slot->index() == slots_drawn;
 				if (highlight_this_slot) {
@@ -637,14 +640,14 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 				// Label
 				{
 					const csc::Float2 label_pos{ next_slot_begin + csc::Float2{ 8.0f, 4.0f } };
-					const boost::string_view slot_disp_name_view{ get_alt_slot_name(*node, slot.disp_name()) };
+					const boost::string_view slot_disp_name_view{ get_alt_slot_name(node, slot.disp_name()) };
 					const char* const slot_disp_name{ slot_disp_name_view.data() };
 					std::array<char, 96> label_text;
 					label_text.fill('\0');
-					if (slot.value) {
+					if (slot_value != nullptr) {
 						if (slot.type() == csg::SlotType::BOOL) {
-							const auto bool_value{ slot.value->as<csg::BoolSlotValue>() };
-							assert(bool_value.has_value());
+							const csg::BoolSlotValue* const bool_value{ slot_value->as_ptr<csg::BoolSlotValue>() };
+							assert(bool_value != nullptr);
 							if (bool_value->get()) {
 								snprintf(label_text.data(), label_text.size() - 1, "%s: True", slot_disp_name);
 							}
@@ -653,8 +656,8 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 							}
 						}
 						else if (slot.type() == csg::SlotType::COLOR) {
-							const auto color_value = slot.value->as<csg::ColorSlotValue>();
-							assert(color_value.has_value());
+							const csg::ColorSlotValue* const color_value{ slot_value->as_ptr<csg::ColorSlotValue>() };
+							assert(color_value != nullptr);
 							snprintf(label_text.data(), label_text.size() - 1, "%s: ", slot_disp_name);
 							const ImVec2 text_size{ ImGui::CalcTextSize(label_text.data()) };
 							const csc::Float2 color_rect_offset{ label_pos + csc::Float2{ text_size.x, 0.0f } };
@@ -671,8 +674,8 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 							snprintf(label_text.data(), label_text.size() - 1, "%s: [Enum]", slot_disp_name);
 						}
 						else if (slot.type() == csg::SlotType::FLOAT) {
-							const auto float_value = slot.value->as<csg::FloatSlotValue>();
-							assert(float_value.has_value());
+							const csg::FloatSlotValue* const float_value{ slot_value->as_ptr<csg::FloatSlotValue>() };
+							assert(float_value != nullptr);
 							// Use snprintf to generate a pattern for another snprintf to get the label
 							// This is so the precision held by the slot is respected
 							std::array<char, 24> pattern_text;
@@ -682,8 +685,8 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 							snprintf(label_text.data(), label_text.size() - 1, pattern_text.data(), slot_disp_name, float_value->get());
 						}
 						else if (slot.type() == csg::SlotType::INT) {
-							const auto int_value{ slot.value->as<csg::IntSlotValue>() };
-							assert(int_value.has_value());
+							const csg::IntSlotValue* const int_value{ slot_value->as_ptr<csg::IntSlotValue>() };
+							assert(int_value != nullptr);
 							snprintf(label_text.data(), label_text.size() - 1, "%s: %d", slot_disp_name, int_value->get());
 						}
 						else if (slot.type() == csg::SlotType::VECTOR) {
@@ -724,17 +727,17 @@ void cse::GraphSubwindow::draw_nodes(ImDrawList* const draw_list) const
 
 	// Draw connections
 	for (const csg::Connection conn : the_graph->connections()) {
-		const boost::optional<std::shared_ptr<const csg::Node>> node_src{ the_graph->get(conn.source().node_id()) };
-		if (node_src.has_value() == false || node_src->use_count() == 0) {
+		const csg::Node* const node_src{ the_graph->get(conn.source().node_id()) };
+		if (node_src == nullptr) {
 			continue;
 		}
-		const boost::optional<std::shared_ptr<const csg::Node>> node_dest = the_graph->get(conn.dest().node_id());
-		if (node_dest.has_value() == false || node_dest->use_count() == 0) {
+		const csg::Node* const node_dest{ the_graph->get(conn.dest().node_id()) };
+		if (node_dest == nullptr) {
 			continue;
 		}
-		const NodeGeometry geom_src_world{ **node_src };
+		const NodeGeometry geom_src_world{ *node_src };
 		const NodeGeometry geom_src_screen{ geom_src_world.with_pos(world_to_screen(geom_src_world.pos())) };
-		const NodeGeometry geom_dest_world{ **node_dest };
+		const NodeGeometry geom_dest_world{ *node_dest };
 		const NodeGeometry geom_dest_screen{ geom_dest_world.with_pos(world_to_screen(geom_dest_world.pos())) };
 
 		const csc::Float2 begin{ geom_src_screen.pin_pos(conn.source().index(), csg::SlotDirection::OUTPUT) };
@@ -776,10 +779,10 @@ boost::optional<csc::FloatRect> cse::GraphSubwindow::selection_rect() const
 std::set<csg::NodeId> cse::GraphSubwindow::get_nodes_in_rect(const csc::FloatRect world_rect) const
 {
 	std::set<csg::NodeId> result;
-	for (const auto& node : the_graph->nodes()) {
-		const NodeGeometry node_geom{ *node };
+	for (const csg::Node& node : the_graph->nodes()) {
+		const NodeGeometry node_geom{ node };
 		if (world_rect.overlaps(node_geom.rect())) {
-			result.insert(node->id());
+			result.insert(node.id());
 		}
 	}
 	return result;
@@ -789,10 +792,10 @@ boost::optional<csg::NodeId> cse::GraphSubwindow::get_node_at_pos(const csc::Flo
 {
 	const csc::Float2 world_pos{ screen_to_world(screen_pos) };
 
-	for (const auto& node : the_graph->nodes()) {
-		const NodeGeometry node_geom{ *node };
+	for (const csg::Node& node : the_graph->nodes()) {
+		const NodeGeometry node_geom{ node };
 		if (node_geom.rect().contains(world_pos)) {
-			return node->id();
+			return node.id();
 		}
 	}
 
@@ -803,13 +806,13 @@ boost::optional<csg::SlotId> cse::GraphSubwindow::get_pin_at_pos(const csc::Floa
 {
 	const csc::Float2 world_pos{ screen_to_world(screen_pos) };
 
-	for (const auto& node : the_graph->nodes()) {
-		const NodeGeometry node_geom{ *node };
+	for (const csg::Node& node : the_graph->nodes()) {
+		const NodeGeometry node_geom{ node };
 		const boost::optional<size_t> maybe_pin{ node_geom.pin_at_pos(world_pos, direction) };
 		if (maybe_pin) {
-			if (node->has_pin(maybe_pin.value(), direction)) {
+			if (node.has_pin(maybe_pin.value(), direction)) {
 				// A match has been found
-				return csg::SlotId{ node->id(), maybe_pin.value() };
+				return csg::SlotId{ node.id(), maybe_pin.value() };
 			}
 			else {
 				return boost::none;
@@ -828,21 +831,21 @@ boost::optional<csg::SlotId> cse::GraphSubwindow::get_slot_at_pos(const csc::Flo
 {
 	const csc::Float2 world_pos{ screen_to_world(screen_pos) };
 
-	for (const auto& node : the_graph->nodes()) {
-		const NodeGeometry node_geom{ *node };
+	for (const csg::Node& node : the_graph->nodes()) {
+		const NodeGeometry node_geom{ node };
 		if (node_geom.rect().contains(world_pos)) {
 			const boost::optional<size_t> slot_id{ node_geom.slot_at_pos(world_pos) };
 			if (slot_id) {
-				const boost::optional<csg::Slot> slot{ node->slot(*slot_id) };
+				const boost::optional<csg::Slot> slot{ node.slot(*slot_id) };
 				if (slot) {
 					// We have found a real slot, check that the direction matches before returning
 					if (direction) {
 						if (slot->dir() == *direction) {
-							return csg::SlotId{ node->id(), *slot_id };
+							return csg::SlotId{ node.id(), *slot_id };
 						}
 					}
 					else {
-						return csg::SlotId{ node->id(), *slot_id };
+						return csg::SlotId{ node.id(), *slot_id };
 					}
 				}
 			}
@@ -56,7 +56,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 	}
 
 	const auto selected_node{ the_graph->get(selected_slot->node_id()) };
-	if (selected_node.use_count() == 0) {
+	if (selected_node == nullptr) {
 		return result;
 	}
 
@@ -68,6 +68,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 	if (opt_slot.has_value() == false) {
 		return result;
 	}
+	const csg::SlotValue* const slot_value{ selected_node->slot_value_ptr(selected_slot->index()) };
 
 	ImGui::SetNextWindowSizeConstraints(ImVec2{ 0.f, 0.f }, ImVec2{ 1000.f, 600.f });
 	if (ImGui::Begin("Parameter Editor", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
@@ -77,11 +78,11 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 		ImGui::Dummy(ImVec2{ 230.0f, 1.0f });
 		ImGui::Separator();
 		if (opt_slot->dir() == csg::SlotDirection::INPUT) {
-			if (opt_slot->value.has_value()) {
+			if (slot_value != nullptr) {
 				if (opt_slot->type() == csg::SlotType::BOOL) {
-					const auto opt_bool_val{ opt_slot->value->as<csg::BoolSlotValue>() };
-					if (opt_bool_val) {
-						const InterfaceEventArray bool_event{ run_bool(*selected_slot, *opt_bool_val) };
+					const csg::BoolSlotValue* const bool_val{ slot_value->as_ptr<csg::BoolSlotValue>() };
+					if (bool_val) {
+						const InterfaceEventArray bool_event{ run_bool(*selected_slot, *bool_val) };
 						result.push(bool_event);
 					}
 					else {
@@ -89,9 +90,9 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 					}
 				}
 				else if (opt_slot->type() == csg::SlotType::COLOR) {
-					const auto opt_color_val{ opt_slot->value->as<csg::ColorSlotValue>() };
-					if (opt_color_val) {
-						const InterfaceEventArray color_event{ run_color(*selected_slot, *opt_color_val) };
+					const csg::ColorSlotValue* const color_val{ slot_value->as_ptr<csg::ColorSlotValue>() };
+					if (color_val) {
+						const InterfaceEventArray color_event{ run_color(*selected_slot, *color_val) };
 						result.push(color_event);
 					}
 					else {
@@ -99,9 +100,9 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 					}
 				}
 				else if (opt_slot->type() == csg::SlotType::ENUM) {
-					const auto opt_enum_val{ opt_slot->value.value().as<csg::EnumSlotValue>() };
-					if (opt_enum_val) {
-						const InterfaceEventArray enum_event{ run_enum(*selected_slot, *opt_enum_val) };
+					const csg::EnumSlotValue* const enum_val{ slot_value->as_ptr<csg::EnumSlotValue>() };
+					if (enum_val) {
+						const InterfaceEventArray enum_event{ run_enum(*selected_slot, *enum_val) };
 						result.push(enum_event);
 					}
 					else {
@@ -109,9 +110,9 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 					}
 				}
 				else if (opt_slot->type() == csg::SlotType::FLOAT) {
-					const auto opt_float_val{ opt_slot->value.value().as<csg::FloatSlotValue>() };
-					if (opt_float_val) {
-						const InterfaceEventArray float_event{ run_float(*selected_slot, *opt_float_val) };
+					const csg::FloatSlotValue* const float_val{ slot_value->as_ptr<csg::FloatSlotValue>() };
+					if (float_val) {
+						const InterfaceEventArray float_event{ run_float(*selected_slot, *float_val) };
 						result.push(float_event);
 					}
 					else {
@@ -119,9 +120,9 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 					}
 				}
 				else if (opt_slot->type() == csg::SlotType::INT) {
-					const auto opt_int_val{ opt_slot->value.value().as<csg::IntSlotValue>() };
-					if (opt_int_val) {
-						const InterfaceEventArray int_event{ run_int(*selected_slot, *opt_int_val) };
+					const csg::IntSlotValue* const int_val{ slot_value->as_ptr<csg::IntSlotValue>() };
+					if (int_val) {
+						const InterfaceEventArray int_event{ run_int(*selected_slot, *int_val) };
 						result.push(int_event);
 					}
 					else {
@@ -129,9 +130,9 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 					}
 				}
 				else if (opt_slot->type() == csg::SlotType::VECTOR) {
-					const auto opt_vec_val{ opt_slot->value.value().as<csg::VectorSlotValue>() };
-					if (opt_vec_val) {
-						const InterfaceEventArray vec_event{ run_vector(*selected_slot, *opt_vec_val) };
+					const csg::VectorSlotValue* const vec_val{ slot_value->as_ptr<csg::VectorSlotValue>() };
+					if (vec_val) {
+						const InterfaceEventArray vec_event{ run_vector(*selected_slot, *vec_val) };
 						result.push(vec_event);
 					}
 					else {
@@ -151,9 +152,9 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 					}
 				}
 				else if (opt_slot->type() == csg::SlotType::COLOR_RAMP) {
-					const auto opt_ramp_val{ opt_slot->value.value().as<csg::ColorRampSlotValue>() };
-					if (opt_ramp_val) {
-						const InterfaceEventArray enum_events{ run_color_ramp(*selected_slot, *opt_ramp_val) };
+					const csg::ColorRampSlotValue* const ramp_val{ slot_value->as_ptr<csg::ColorRampSlotValue>() };
+					if (ramp_val) {
+						const InterfaceEventArray enum_events{ run_color_ramp(*selected_slot, *ramp_val) };
 						result.push(enum_events);
 					}
 					else {
@@ -177,7 +178,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run() const
 	return result;
 }
 
-cse::InterfaceEventArray cse::ParamEditorSubwindow::run_bool(const csg::SlotId slot_id, const csg::BoolSlotValue slot_value) const
+cse::InterfaceEventArray cse::ParamEditorSubwindow::run_bool(const csg::SlotId slot_id, const csg::BoolSlotValue& slot_value) const
 {
 	InterfaceEventArray result;
 
@@ -202,7 +203,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run_bool(const csg::SlotId s
 	return result;
 }
 
-cse::InterfaceEventArray cse::ParamEditorSubwindow::run_color(const csg::SlotId slot_id, const csg::ColorSlotValue slot_value) const
+cse::InterfaceEventArray cse::ParamEditorSubwindow::run_color(const csg::SlotId slot_id, const csg::ColorSlotValue& slot_value) const
 {
 	const ImGuiColorEditFlags flags{ ImGuiColorEditFlags_NoLabel | ImGuiColorEditFlags_Float };
 
@@ -234,7 +235,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run_color(const csg::SlotId
 	return result;
 }
 
-cse::InterfaceEventArray cse::ParamEditorSubwindow::run_enum(const csg::SlotId slot_id, const csg::EnumSlotValue slot_value) const
+cse::InterfaceEventArray cse::ParamEditorSubwindow::run_enum(const csg::SlotId slot_id, const csg::EnumSlotValue& slot_value) const
 {
 	InterfaceEventArray result;
 
@@ -257,7 +258,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run_enum(const csg::SlotId s
 	return result;
 }
 
-cse::InterfaceEventArray cse::ParamEditorSubwindow::run_float(const csg::SlotId slot_id, const csg::FloatSlotValue slot_value) const
+cse::InterfaceEventArray cse::ParamEditorSubwindow::run_float(const csg::SlotId slot_id, const csg::FloatSlotValue& slot_value) const
 {
 	InterfaceEventArray result;
 
@@ -282,7 +283,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run_float(const csg::SlotId
 	return result;
 }
 
-cse::InterfaceEventArray cse::ParamEditorSubwindow::run_int(const csg::SlotId slot_id, const csg::IntSlotValue slot_value) const
+cse::InterfaceEventArray cse::ParamEditorSubwindow::run_int(const csg::SlotId slot_id, const csg::IntSlotValue& slot_value) const
 {
 	InterfaceEventArray result;
 
@@ -303,7 +304,7 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run_int(const csg::SlotId sl
 	return result;
 }
 
-cse::InterfaceEventArray cse::ParamEditorSubwindow::run_vector(const csg::SlotId slot_id, const csg::VectorSlotValue slot_value) const
+cse::InterfaceEventArray cse::ParamEditorSubwindow::run_vector(const csg::SlotId slot_id, const csg::VectorSlotValue& slot_value) const
 {
 	InterfaceEventArray result;
 
@@ -334,13 +335,13 @@ cse::InterfaceEventArray cse::ParamEditorSubwindow::run_vector(const csg::SlotId
 	return result;
 }
 
-cse::InterfaceEventArray cse::ParamEditorSubwindow::run_color_ramp(csg::SlotId slot_id, csg::ColorRampSlotValue slot_value) const
+cse::InterfaceEventArray cse::ParamEditorSubwindow::run_color_ramp(csg::SlotId slot_id, const csg::ColorRampSlotValue& slot_value) const
 {
 	InterfaceEventArray result;
 
 	const char* const float_format{ "%.3f" };
 
-	const csg::ColorRamp points{ slot_value.get() };
+	const csg::ColorRamp& points{ slot_value.get() };
 	for (size_t i = 0; i < points.size(); i++) {
 		const csg::ColorRampPoint this_point{ points.get(i) };
 
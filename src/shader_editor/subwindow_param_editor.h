@@ -28,13 +28,13 @@ namespace cse {
 		ParamEditorSubwindow(std::shared_ptr<csg::Graph> the_graph) : the_graph{ the_graph } {}
 
 		InterfaceEventArray run() const;
-		InterfaceEventArray run_bool(csg::SlotId slot_id, csg::BoolSlotValue slot_value) const;
-		InterfaceEventArray run_color(csg::SlotId slot_id, csg::ColorSlotValue slot_value) const;
-		InterfaceEventArray run_enum(csg::SlotId slot_id, csg::EnumSlotValue slot_value) const;
-		InterfaceEventArray run_float(csg::SlotId slot_id, csg::FloatSlotValue slot_value) const;
-		InterfaceEventArray run_int(csg::SlotId slot_id, csg::IntSlotValue slot_value) const;
-		InterfaceEventArray run_vector(csg::SlotId slot_id, csg::VectorSlotValue slot_value) const;
-		InterfaceEventArray run_color_ramp(csg::SlotId slot_id, csg::ColorRampSlotValue slot_value) const;
+		InterfaceEventArray run_bool(csg::SlotId slot_id, const csg::BoolSlotValue& slot_value) const;
+		InterfaceEventArray run_color(csg::SlotId slot_id, const csg::ColorSlotValue& slot_value) const;
+		InterfaceEventArray run_enum(csg::SlotId slot_id, const csg::EnumSlotValue& slot_value) const;
+		InterfaceEventArray run_float(csg::SlotId slot_id, const csg::FloatSlotValue& slot_value) const;
+		InterfaceEventArray run_int(csg::SlotId slot_id, const csg::IntSlotValue& slot_value) const;
+		InterfaceEventArray run_vector(csg::SlotId slot_id, const csg::VectorSlotValue& slot_value) const;
+		InterfaceEventArray run_color_ramp(csg::SlotId slot_id, const csg::ColorRampSlotValue& slot_value) const;
 
 		void do_event(const InterfaceEvent& event);
 
@@ -282,7 +282,7 @@ void csg::Curve::set_bounds(const csc::FloatRect bounds_rect)
 	_max = bounds_rect.end();
 }
 
-bool csg::Curve::bounds_valid(const csc::FloatRect bounds_rect)
+bool csg::Curve::bounds_valid(const csc::FloatRect bounds_rect) const
 {
 	for (const CurvePoint this_point : points) {
 		if (bounds_rect.contains(this_point.pos) == false) {
@@ -48,7 +48,7 @@ namespace csg {
 
 		void set_bounds(csc::FloatRect bounds_rect);
 		// Returns true if it is possible to apply the provided bounds to this curve
-		bool bounds_valid(csc::FloatRect bounds_rect);
+		bool bounds_valid(csc::FloatRect bounds_rect) const;
 
 		bool similar(const Curve& other, float margin) const;
 
@@ -1,11 +1,17 @@
 #include "graph.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
-#include <list>
+#include <cstdint>
+#include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include <boost/optional.hpp>
 
+#include "shader_core/hash.h"
 #include "shader_core/vector.h"
 
 #include "node.h"
@@ -13,46 +19,51 @@
 #include "serialize.h"
 #include "slot.h"
 
-template <typename TSlot, typename TRaw> bool set_graph_value(
-	const std::map<csg::NodeId, std::shared_ptr<csg::Node>>& nodes_by_id,
-	const csg::SlotId slot_id,
-	const TRaw new_value)
+static uint64_t node_hash(const csg::Node& node)
 {
-	if (nodes_by_id.count(slot_id.node_id()) == 0) {
-		return false;
-	}
-
-	const std::shared_ptr<csg::Node> node{ nodes_by_id.at(slot_id.node_id()) };
-	if (node.use_count() == 0) {
-		return false;
-	}
-
-	const auto opt_slot{ node->slot(slot_id.index()) };
-	if (opt_slot.has_value() == false) {
-		return false;
-	}
-
-	csg::Slot& slot = node->slot_ref(slot_id.index());
-	if (slot.value.has_value() == false) {
-		return false;
-	}
-
-	const boost::optional<TSlot> opt_old_value = slot.value->as<TSlot>();
-	if (opt_old_value.has_value() == false) {
-		return false;
+	uint64_t result{ csc::combine_hash(static_cast<uint64_t>(node.id()), static_cast<uint64_t>(node.type())) };
+	result = csc::combine_hash(result, static_cast<uint32_t>(node.position.x));
+	result = csc::combine_hash(result, static_cast<uint32_t>(node.position.y));
+	// Only curves and ramps are ever left undecoded and those are not hashed, so the slots never need decoding here
+	for (size_t i = 0; i < node.slot_count(); i++) {
+		const csg::SlotValue* const value{ node.slot_value_ptr_without_decoding(i) };
+		if (value == nullptr) {
+			continue;
+		}
+		switch (value->type()) {
+			case csg::SlotType::BOOL:
+				result = csc::combine_hash(result, value->as_ptr<csg::BoolSlotValue>()->get());
+				break;
+			case csg::SlotType::ENUM:
+				result = csc::combine_hash(result, value->as_ptr<csg::EnumSlotValue>()->get());
+				break;
+			case csg::SlotType::INT:
+				result = csc::combine_hash(result, static_cast<uint32_t>(value->as_ptr<csg::IntSlotValue>()->get()));
+				break;
+			default:
+				break;
+		}
 	}
+	return result;
+}
 
-	const TSlot old_value = opt_old_value.value();
-	TSlot maybe_new_value{ old_value };
-	maybe_new_value.set(new_value);
-
-	if (maybe_new_value != old_value) {
-		slot.value = maybe_new_value;
-		return true;
+// Gives write access to something shared between copies of a graph, copying it first if another copy still holds it
+template <typename T> static T& unshare(std::shared_ptr<T>& shared)
+{
+	if (shared.use_count() > 1) {
+		shared = std::make_shared<T>(*shared);
 	}
 	else {
-		return false;
+		// Other graphs can let go of it on other threads, make their last reads of it happen before any change here
+		std::atomic_thread_fence(std::memory_order_acquire);
 	}
+	return *shared;
+}
+
+static uint64_t connection_hash(const csg::Connection& connection)
+{
+	const uint64_t source_hash{ csc::combine_hash(static_cast<uint64_t>(connection.source().node_id()), connection.source().index()) };
+	return csc::combine_hash(source_hash, csc::combine_hash(static_cast<uint64_t>(connection.dest().node_id()), connection.dest().index()));
 }
 
 bool csg::Connection::operator<(const Connection& other) const
@@ -66,7 +77,7 @@ bool csg::Connection::operator<(const Connection& other) const
 	return false;
 }
 
-boost::optional<csg::Graph> csg::Graph::from(const std::string& graph_string)
+boost::optional<csg::Graph> csg::Graph::from(const boost::string_view graph_string)
 {
 	return deserialize_graph(graph_string);
 }
@@ -78,32 +89,80 @@ csg::Graph::Graph(const GraphType type)
 	}
 }
 
-csg::Graph& csg::Graph::operator=(const Graph& other)
+csg::Graph& csg::Graph::operator=(Graph&& other)
 {
-	// Destroy all shared_ptrs, the objects they point to do not belong to the this graph anymore
-	_nodes.clear();
-	nodes_by_id.clear();
-
-	for (const std::shared_ptr<Node>& node : other.nodes()) {
-		// Make a new shared_ptr with an equivalent but distinct object
-		const std::shared_ptr<Node> new_node{ std::make_shared<Node>(*node) };
-		_nodes.push_back(new_node);
-		nodes_by_id[new_node->id()] = new_node;
+	if (this == &other) {
+		return *this;
 	}
 
-	_connections = other._connections;
+	node_table = std::move(other.node_table);
+	connection_table = std::move(other.connection_table);
+	_version = other._version;
+	_structure_hash = other._structure_hash;
+
+	// Leave other as a valid empty graph that can not be mistaken for this one
+	other.node_table = std::make_shared<NodeTable>();
+	other.connection_table = std::make_shared<ConnectionTable>();
+	other._structure_hash = 0;
+	other.changed();
 
 	return *this;
 }
 
-std::shared_ptr<const csg::Node> csg::Graph::get(const NodeId id) const
+const csg::Node* csg::Graph::get(const NodeId id) const
 {
-	if (nodes_by_id.count(id)) {
-		return std::const_pointer_cast<const Node>(nodes_by_id.at(id));
+	const csc::SlotMap<std::shared_ptr<Node>>::Handle* const handle{ node_table->handles_by_id.find(id) };
+	if (handle == nullptr) {
+		return nullptr;
 	}
-	else {
-		return std::shared_ptr<const csg::Node>{};
+	return node_table->nodes.get(*handle)->get();
+}
+
+csg::Node* csg::Graph::get_mutable(const NodeId id)
+{
+	const csc::SlotMap<std::shared_ptr<Node>>::Handle* const handle{ node_table->handles_by_id.find(id) };
+	if (handle == nullptr) {
+		return nullptr;
 	}
+	// Copied out first, unsharing the table can leave the pointer pointing into a table held by another graph
+	const csc::SlotMap<std::shared_ptr<Node>>::Handle node_handle{ *handle };
+	return &unshare(*mutable_node_table().nodes.get(node_handle));
+}
+
+csg::Graph::NodeTable& csg::Graph::mutable_node_table()
+{
+	return unshare(node_table);
+}
+
+csg::Graph::ConnectionTable& csg::Graph::mutable_connection_table()
+{
+	return unshare(connection_table);
+}
+
+template <typename TSlot, typename TRaw> bool csg::Graph::set_slot_value(const SlotId slot_id, const TRaw& new_value)
+{
+	// Everything is checked on the shared node, so setting a value that does not change anything never copies it
+	const Node* const node{ get(slot_id.node_id()) };
+	if (node == nullptr) {
+		return false;
+	}
+
+	const TSlot* const old_value{ node->slot_value_ptr<TSlot>(slot_id.index()) };
+	if (old_value == nullptr) {
+		return false;
+	}
+
+	TSlot maybe_new_value{ *old_value };
+	maybe_new_value.set(new_value);
+	if (maybe_new_value == *old_value) {
+		return false;
+	}
+
+	const uint64_t old_node_hash{ node_hash(*node) };
+	Node* const mutable_node{ get_mutable(slot_id.node_id()) };
+	*mutable_node->mutable_slot_value_ptr<TSlot>(slot_id.index()) = std::move(maybe_new_value);
+	node_changed(old_node_hash, *mutable_node);
+	return true;
 }
 
 boost::optional<csg::SlotValue> csg::Graph::get_slot_value(SlotId slot_id) const
@@ -118,53 +177,84 @@ boost::optional<csg::SlotValue> csg::Graph::get_slot_value(SlotId slot_id) const
 csg::NodeId csg::Graph::add(const NodeType type, const csc::Int2 pos)
 {
 	while (true) {
-		const std::shared_ptr<Node> new_node{ std::make_shared<Node>(type, pos) };
-		if (contains(new_node->id()) == false) {
-			_nodes.push_front(new_node);
-			nodes_by_id[new_node->id()] = new_node;
-			return new_node->id();
+		Node new_node{ type, pos };
+		const NodeId new_id{ new_node.id() };
+		if (add(std::move(new_node))) {
+			return new_id;
 		}
 	}
 }
 
 bool csg::Graph::add(const NodeType type, const csc::Int2 pos, const NodeId node_id)
 {
-	const std::shared_ptr<Node> new_node{ std::make_shared<Node>(type, pos, node_id) };
-	if (contains(new_node->id()) == false) {
-		_nodes.push_front(new_node);
-		nodes_by_id[new_node->id()] = new_node;
-		return true;
-	}
-	else {
+	return add(Node{ type, pos, node_id });
+}
+
+bool csg::Graph::add(Node node)
+{
+	if (contains(node.id())) {
 		return false;
 	}
+	const NodeId id{ node.id() };
+	ConnectionTable& connection_data{ mutable_connection_table() };
+	NodeConnections node_connections;
+	node_connections.order_position = connection_data.topological_order.size();
+	node_connections.is_output = NodeTypeInfo::from(node.type())->category() == NodeCategory::OUTPUT;
+	connection_data.by_node.insert(id, std::move(node_connections));
+	connection_data.topological_order.push_back(id);
+	_structure_hash += node_hash(node);
+	NodeTable& node_data{ mutable_node_table() };
+	node_data.handles_by_id.insert(id, node_data.nodes.insert(std::make_shared<Node>(std::move(node))));
+	changed();
+	return true;
 }
 
 void csg::Graph::remove(const std::set<NodeId>& ids)
 {
-	for (auto iter{ _nodes.begin() }; iter != _nodes.end(); ) {
-		const auto this_node{ *iter };
+	// One pass over the nodes no matter how many are removed
+	NodeTable& node_data{ mutable_node_table() };
+	const size_t removed_count{ node_data.nodes.erase_if([&](const std::shared_ptr<Node>& this_node) {
 		const bool is_deletable{ csg::NodeTypeInfo::from(this_node->type())->category() != csg::NodeCategory::OUTPUT };
 		if (is_deletable && ids.count(this_node->id())) {
-			nodes_by_id.erase(this_node->id());
-			iter = _nodes.erase(iter);
+			node_data.handles_by_id.erase(this_node->id());
+			_structure_hash -= node_hash(*this_node);
+			return true;
 		}
-		else {
-			++iter;
+		return false;
+	}) };
+	if (removed_count == 0) {
+		return;
+	}
+	changed();
+
+	// Connections are dropped with their nodes so they can not come back if a node with the same id is added
+	for (const NodeId this_id : ids) {
+		if (contains(this_id) == false) {
+			remove_connections_of(this_id);
+			mutable_connection_table().by_node.erase(this_id);
 		}
 	}
+	ConnectionTable& connection_data{ mutable_connection_table() };
+	std::vector<NodeId>& order{ connection_data.topological_order };
+	order.erase(
+		std::remove_if(order.begin(), order.end(), [this](const NodeId this_id) { return contains(this_id) == false; }),
+		order.end()
+	);
+	for (size_t i = 0; i < order.size(); i++) {
+		connection_data.by_node.find(order[i])->order_position = i;
+	}
 }
 
 boost::optional<csg::NodeId> csg::Graph::duplicate(const NodeId node_id)
 {
 	const csc::Int2 duplicate_offset{ 20, 20 };
 
-	if (nodes_by_id.count(node_id) == 0) {
+	const Node* const old_node{ get(node_id) };
+	if (old_node == nullptr) {
 		// node_id is invalid, do nothing
 		return boost::none;
 	}
 
-	const std::shared_ptr<Node> old_node{ nodes_by_id[node_id] };
 	const boost::optional<NodeTypeInfo> old_type_info{ NodeTypeInfo::from(old_node->type()) };
 	assert(old_type_info.has_value());
 	if (old_type_info->allow_creation() == false) {
@@ -172,10 +262,29 @@ boost::optional<csg::NodeId> csg::Graph::duplicate(const NodeId node_id)
 		return boost::none;
 	}
 
-	const NodeId new_node_id{ add(old_node->type(), old_node->position + duplicate_offset) };
-	const std::shared_ptr<Node> new_node{ nodes_by_id[new_node_id] };
-	new_node->copy_from(*old_node);
-	return new_node_id;
+	// Adding a node can move the others, so the copy is made before it is added
+	while (true) {
+		Node new_node{ old_node->type(), old_node->position + duplicate_offset };
+		new_node.copy_from(*old_node);
+		const NodeId new_node_id{ new_node.id() };
+		if (add(std::move(new_node))) {
+			return new_node_id;
+		}
+	}
+}
+
+bool csg::Graph::copy_node(const NodeId dest_id, const Node& source)
+{
+	const Node* const old_node{ get(dest_id) };
+	if (old_node == nullptr) {
+		return false;
+	}
+
+	const uint64_t old_node_hash{ node_hash(*old_node) };
+	Node* const dest_node{ get_mutable(dest_id) };
+	dest_node->copy_from(source);
+	node_changed(old_node_hash, *dest_node);
+	return true;
 }
 
 bool csg::Graph::add_connection(const SlotId source, const SlotId dest)
@@ -183,9 +292,9 @@ bool csg::Graph::add_connection(const SlotId source, const SlotId dest)
 	if (source.node_id() == dest.node_id()) {
 		return false;
 	}
-	const std::shared_ptr<const Node> source_node = get(source.node_id());
-	const std::shared_ptr<const Node> dest_node = get(dest.node_id());
-	if (source_node.use_count() == 0 || dest_node.use_count() == 0) {
+	const Node* const source_node{ get(source.node_id()) };
+	const Node* const dest_node{ get(dest.node_id()) };
+	if (source_node == nullptr || dest_node == nullptr) {
 		return false;
 	}
 	if (source_node->has_pin(source.index(), SlotDirection::OUTPUT) == false) {
@@ -195,125 +304,389 @@ bool csg::Graph::add_connection(const SlotId source, const SlotId dest)
 		return false;
 	}
 
+	// Connecting the same slots again changes nothing
+	const boost::optional<Connection> existing{ connection_to(dest) };
+	if (existing.has_value() && existing->source() == source) {
+		return true;
+	}
+
+	// Checked before the old connection is removed, so a rejected connection leaves the graph as it was
+	if (order_connection(source.node_id(), dest.node_id()) == false) {
+		return false;
+	}
+
 	// Add new connection
-	boost::optional<Connection> removed_connection{ remove_connection(dest) };
-	_connections.push_back(Connection{ source, dest });
+	remove_connection(dest);
+	ConnectionTable& connection_data{ mutable_connection_table() };
+	const size_t index{ connection_data.connections.size() };
+	connection_data.connections.push_back(Connection{ source, dest });
+	_structure_hash += connection_hash(connection_data.connections.back());
+	changed();
+	connection_data.by_node.find(dest.node_id())->incoming.push_back(index);
+	std::vector<size_t>& source_outgoing{ connection_data.by_node.find(source.node_id())->outgoing };
+	connection_data.outgoing_positions.push_back(source_outgoing.size());
+	source_outgoing.push_back(index);
+	if (reaches_output(dest.node_id())) {
+		change_live_outgoing(source.node_id(), true);
+	}
 
 	return true;
 }
 
 boost::optional<csg::Connection> csg::Graph::remove_connection(const SlotId dest)
 {
-	for (auto conn_iter{ _connections.begin() }; conn_iter != _connections.end(); conn_iter++) {
-		if (conn_iter->dest() == dest) {
-			Connection result = *conn_iter;
-			_connections.erase(conn_iter);
-			return result;
+	const boost::optional<size_t> index{ connection_index_to(dest) };
+	if (index.has_value() == false) {
+		return boost::none;
+	}
+	const Connection result{ connection_table->connections[*index] };
+	remove_connection_at(*index);
+	return result;
+}
+
+boost::optional<csg::Connection> csg::Graph::connection_to(const SlotId dest) const
+{
+	const boost::optional<size_t> index{ connection_index_to(dest) };
+	if (index.has_value() == false) {
+		return boost::none;
+	}
+	return connection_table->connections[*index];
+}
+
+std::vector<csg::Connection> csg::Graph::connections_from(const NodeId id) const
+{
+	std::vector<Connection> result;
+	const NodeConnections* const node_connections{ connection_table->by_node.find(id) };
+	if (node_connections != nullptr) {
+		for (const size_t this_index : node_connections->outgoing) {
+			result.push_back(connection_table->connections[this_index]);
 		}
 	}
-	return boost::none;
+	return result;
+}
+
+std::vector<csg::Connection> csg::Graph::connections_to(const NodeId id) const
+{
+	std::vector<Connection> result;
+	const NodeConnections* const node_connections{ connection_table->by_node.find(id) };
+	if (node_connections != nullptr) {
+		for (const size_t this_index : node_connections->incoming) {
+			result.push_back(connection_table->connections[this_index]);
+		}
+	}
+	return result;
 }
 
 bool csg::Graph::set_bool(const SlotId slot_id, const bool new_value)
 {
-	return set_graph_value<BoolSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<BoolSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_color(const SlotId slot_id, const csc::Float3 new_value)
 {
-	return set_graph_value<ColorSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<ColorSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_enum(const SlotId slot_id, const size_t new_value)
 {
-	return set_graph_value<EnumSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<EnumSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_float(const SlotId slot_id, const float new_value)
 {
-	return set_graph_value<FloatSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<FloatSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_int(const SlotId slot_id, const int new_value)
 {
-	return set_graph_value<IntSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<IntSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_vector(const SlotId slot_id, const csc::Float3 new_value)
 {
-	return set_graph_value<VectorSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<VectorSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_color_ramp(const SlotId slot_id, const ColorRampSlotValue& new_value)
 {
-	return set_graph_value<ColorRampSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<ColorRampSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_curve_rgb(const SlotId slot_id, const RGBCurveSlotValue& new_value)
 {
-	return set_graph_value<RGBCurveSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<RGBCurveSlotValue>(slot_id, new_value);
 }
 
 bool csg::Graph::set_curve_vec(const SlotId slot_id, const VectorCurveSlotValue& new_value)
 {
-	return set_graph_value<VectorCurveSlotValue>(nodes_by_id, slot_id, new_value);
+	return set_slot_value<VectorCurveSlotValue>(slot_id, new_value);
 }
 
 void csg::Graph::move(const std::set<NodeId>& ids, const csc::Float2 delta)
 {
 	for (const NodeId id : ids) {
-		if (nodes_by_id.count(id)) {
-			const auto ptr{ nodes_by_id[id] };
-			const csc::Float2 current_pos{ ptr->position };
+		const Node* const node{ get(id) };
+		if (node != nullptr) {
+			const csc::Float2 current_pos{ node->position };
 			const csc::Float2 new_pos{ current_pos + delta };
-			ptr->position = csc::Int2{ new_pos };
+			set_position(id, csc::Int2{ new_pos });
 		}
 	}
 }
 
+bool csg::Graph::set_position(const NodeId id, const csc::Int2 position)
+{
+	const Node* const node{ get(id) };
+	if (node == nullptr) {
+		return false;
+	}
+	if (node->position != position) {
+		const uint64_t old_node_hash{ node_hash(*node) };
+		Node* const mutable_node{ get_mutable(id) };
+		mutable_node->position = position;
+		node_changed(old_node_hash, *mutable_node);
+	}
+	return true;
+}
+
 void csg::Graph::raise(const NodeId id)
 {
-	if (contains(id) == false) {
-		return;
+	const csc::SlotMap<std::shared_ptr<Node>>::Handle* const handle{ node_table->handles_by_id.find(id) };
+	// Draw order is not part of the hash, but it is saved so it still counts as a change
+	if (handle != nullptr && node_table->nodes.handle_at(node_table->nodes.size() - 1) != *handle) {
+		const csc::SlotMap<std::shared_ptr<Node>>::Handle node_handle{ *handle };
+		mutable_node_table().nodes.move_to_back(node_handle);
+		changed();
+	}
+}
+
+uint64_t csg::Graph::new_version()
+{
+	static std::atomic<uint64_t> next_version{ 1 };
+	return next_version.fetch_add(1, std::memory_order_relaxed);
+}
+
+void csg::Graph::node_changed(const uint64_t old_node_hash, const Node& node)
+{
+	_structure_hash += node_hash(node) - old_node_hash;
+	changed();
+}
+
+boost::optional<size_t> csg::Graph::connection_index_to(const SlotId dest) const
+{
+	const NodeConnections* const node_connections{ connection_table->by_node.find(dest.node_id()) };
+	if (node_connections == nullptr) {
+		return boost::none;
+	}
+	for (const size_t this_index : node_connections->incoming) {
+		if (connection_table->connections[this_index].dest() == dest) {
+			return this_index;
+		}
+	}
+	return boost::none;
+}
+
+void csg::Graph::remove_connection_at(const size_t index)
+{
+	ConnectionTable& connection_data{ mutable_connection_table() };
+	assert(index < connection_data.connections.size());
+
+	// Replace one index with another in a list of connection indices
+	const auto replace_index = [](std::vector<size_t>& indices, const size_t old_index, const size_t new_index) {
+		for (size_t& this_index : indices) {
+			if (this_index == old_index) {
+				this_index = new_index;
+				return;
+			}
+		}
+		assert(false);
+	};
+	const Connection removed{ connection_data.connections[index] };
+	_structure_hash -= connection_hash(removed);
+	changed();
+	if (reaches_output(removed.dest().node_id())) {
+		change_live_outgoing(removed.source().node_id(), false);
+	}
+	{
+		std::vector<size_t>& dest_incoming{ connection_data.by_node.find(removed.dest().node_id())->incoming };
+		replace_index(dest_incoming, index, dest_incoming.back());
+		dest_incoming.pop_back();
+	}
+	{
+		std::vector<size_t>& source_outgoing{ connection_data.by_node.find(removed.source().node_id())->outgoing };
+		const size_t position{ connection_data.outgoing_positions[index] };
+		assert(source_outgoing[position] == index);
+		source_outgoing[position] = source_outgoing.back();
+		connection_data.outgoing_positions[source_outgoing[position]] = position;
+		source_outgoing.pop_back();
+	}
+
+	// Fill the gap with the last connection and point its node entries at the new index
+	const size_t last_index{ connection_data.connections.size() - 1 };
+	if (index != last_index) {
+		const Connection moved{ connection_data.connections[last_index] };
+		connection_data.connections[index] = moved;
+		connection_data.outgoing_positions[index] = connection_data.outgoing_positions[last_index];
+		replace_index(connection_data.by_node.find(moved.dest().node_id())->incoming, last_index, index);
+		connection_data.by_node.find(moved.source().node_id())->outgoing[connection_data.outgoing_positions[index]] = index;
 	}
-	std::shared_ptr<Node> the_node;
-	for (auto iter{ _nodes.begin() }; iter != _nodes.end(); iter++) {
-		const NodeId this_id{ (*iter)->id() };
-		if (this_id == id) {
-			the_node = *iter;
-			_nodes.erase(iter);
-			break;
+	connection_data.connections.pop_back();
+	connection_data.outgoing_positions.pop_back();
+}
+
+void csg::Graph::remove_connections_of(const NodeId id)
+{
+	while (true) {
+		const NodeConnections* const node_connections{ connection_table->by_node.find(id) };
+		if (node_connections == nullptr || (node_connections->incoming.empty() && node_connections->outgoing.empty())) {
+			return;
+		}
+		const size_t index{ node_connections->incoming.empty() ? node_connections->outgoing.back() : node_connections->incoming.back() };
+		remove_connection_at(index);
+	}
+}
+
+bool csg::Graph::order_connection(const NodeId source, const NodeId dest)
+{
+	ConnectionTable& connection_data{ mutable_connection_table() };
+	const size_t lower{ connection_data.by_node.find(dest)->order_position };
+	const size_t upper{ connection_data.by_node.find(source)->order_position };
+	if (upper < lower) {
+		// Already in order
+		return true;
+	}
+
+	// Returns true the first time a node is visited in this search
+	const uint64_t search_count{ ++connection_data.search_count };
+	const auto visit = [search_count](NodeConnections& node_connections) {
+		if (node_connections.search_mark == search_count) {
+			return false;
+		}
+		node_connections.search_mark = search_count;
+		return true;
+	};
+
+	// Only nodes ordered between dest and source can be out of order after this connection is added
+	// Collect the positions of those downstream of dest, reaching source here means the connection would make a cycle
+	// Nothing is added to by_node during the search, so pointers into it stay valid
+	std::vector<size_t> downstream;
+	std::vector<NodeConnections*> pending{ connection_data.by_node.find(dest) };
+	visit(*pending.back());
+	while (pending.empty() == false) {
+		const NodeConnections* const this_connections{ pending.back() };
+		pending.pop_back();
+		downstream.push_back(this_connections->order_position);
+		for (const size_t this_index : this_connections->outgoing) {
+			const NodeId next_id{ connection_data.connections[this_index].dest().node_id() };
+			if (next_id == source) {
+				return false;
+			}
+			NodeConnections* const next_connections{ connection_data.by_node.find(next_id) };
+			if (next_connections->order_position < upper && visit(*next_connections)) {
+				pending.push_back(next_connections);
+			}
 		}
 	}
-	if (the_node) {
-		_nodes.push_front(the_node);
+
+	// Then those upstream of source
+	std::vector<size_t> upstream;
+	pending.push_back(connection_data.by_node.find(source));
+	visit(*pending.back());
+	while (pending.empty() == false) {
+		const NodeConnections* const this_connections{ pending.back() };
+		pending.pop_back();
+		upstream.push_back(this_connections->order_position);
+		for (const size_t this_index : this_connections->incoming) {
+			NodeConnections* const next_connections{ connection_data.by_node.find(connection_data.connections[this_index].source().node_id()) };
+			if (next_connections->order_position > lower && visit(*next_connections)) {
+				pending.push_back(next_connections);
+			}
+		}
+	}
+
+	// Hand the positions these nodes held back out with everything upstream first, each group keeps its own order
+	std::sort(upstream.begin(), upstream.end());
+	std::sort(downstream.begin(), downstream.end());
+	std::vector<NodeId> moved_ids;
+	moved_ids.reserve(upstream.size() + downstream.size());
+	for (const size_t this_position : upstream) {
+		moved_ids.push_back(connection_data.topological_order[this_position]);
 	}
+	for (const size_t this_position : downstream) {
+		moved_ids.push_back(connection_data.topological_order[this_position]);
+	}
+	std::vector<size_t> positions(moved_ids.size());
+	std::merge(upstream.cbegin(), upstream.cend(), downstream.cbegin(), downstream.cend(), positions.begin());
+
+	for (size_t i = 0; i < moved_ids.size(); i++) {
+		connection_data.by_node.find(moved_ids[i])->order_position = positions[i];
+		connection_data.topological_order[positions[i]] = moved_ids[i];
+	}
+	return true;
+}
+
+void csg::Graph::change_live_outgoing(const NodeId id, const bool increase)
+{
+	ConnectionTable& connection_data{ mutable_connection_table() };
+	// A graph has no cycles, so a node can never keep itself reaching an output
+	std::vector<NodeId> pending{ id };
+	while (pending.empty() == false) {
+		NodeConnections& node_connections{ *connection_data.by_node.find(pending.back()) };
+		pending.pop_back();
+		const bool was_live{ node_connections.is_output || node_connections.live_outgoing > 0 };
+		if (increase) {
+			node_connections.live_outgoing++;
+		}
+		else {
+			assert(node_connections.live_outgoing > 0);
+			node_connections.live_outgoing--;
+		}
+		const bool is_live{ node_connections.is_output || node_connections.live_outgoing > 0 };
+		if (was_live != is_live) {
+			for (const size_t this_index : node_connections.incoming) {
+				pending.push_back(connection_data.connections[this_index].source().node_id());
+			}
+		}
+	}
+}
+
+bool csg::Graph::reaches_output(const NodeId id) const
+{
+	const NodeConnections* const node_connections{ connection_table->by_node.find(id) };
+	return node_connections != nullptr && (node_connections->is_output || node_connections->live_outgoing > 0);
 }
 
 bool csg::Graph::contains(const NodeId id) const
 {
-	return (nodes_by_id.count(id) > 0);
+	return node_table->handles_by_id.contains(id);
 }
 
-std::string csg::Graph::serialize() const
+std::string csg::Graph::serialize(const SerializedFormat format) const
 {
-	return csg::serialize_graph(*this);
+	return csg::serialize_graph(*this, format);
 }
 
 bool csg::Graph::operator==(const Graph& other) const
 {
-	const bool size_match_nodes{ _nodes.size() == other._nodes.size() };
-	const bool size_match_conns{ _connections.size() == other._connections.size() };
+	if (_version == other._version) {
+		return true;
+	}
+	if (_structure_hash != other._structure_hash) {
+		return false;
+	}
+
+	const bool size_match_nodes{ node_table->nodes.size() == other.node_table->nodes.size() };
+	const bool size_match_conns{ connection_table->connections.size() == other.connection_table->connections.size() };
 	if (!size_match_nodes || !size_match_conns) {
 		return false;
 	}
 
 	// Check that all connections match (order does not matter)
+	// An input has at most one connection, so each one is found by its destination
 	{
-		const std::set<Connection> source_connections{ _connections.cbegin(), _connections.cend() };
-		// For each connection in other, make sure it exists in the source set
-		for (const Connection this_conn : other._connections) {
-			if (source_connections.count(this_conn) == 0) {
+		for (const Connection this_conn : other.connection_table->connections) {
+			const boost::optional<Connection> source_conn{ connection_to(this_conn.dest()) };
+			if (source_conn.has_value() == false || source_conn->source() != this_conn.source()) {
 				return false;
 			}
 		}
@@ -321,12 +694,13 @@ bool csg::Graph::operator==(const Graph& other) const
 
 	// Check that all nodes match (order does not matter)
 	{
-		for (const std::shared_ptr<Node>& this_node : _nodes) {
-			const std::shared_ptr<const Node> other_node{ other.get(this_node->id()) };
-			if (other_node.use_count() == 0) {
+		for (const std::shared_ptr<Node>& this_node : node_table->nodes.values()) {
+			const Node* const other_node{ other.get(this_node->id()) };
+			if (other_node == nullptr) {
 				return false;
 			}
-			if (*this_node != *other_node) {
+			// Nodes still shared with a copy of this graph are equal without looking inside them
+			if (other_node != this_node.get() && *this_node != *other_node) {
 				return false;
 			}
 		}
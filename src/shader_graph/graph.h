@@ -6,16 +6,25 @@
  */
 
 #include <cstddef>
-#include <list>
-#include <map>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
+#include <boost/iterator/indirect_iterator.hpp>
 #include <boost/optional.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include "shader_core/id_map.h"
+#include "shader_core/slot_map.h"
+
+#include "node.h"
 
 #include "node_id.h"
 #include "node_type.h"
+#include "serialize.h"
 #include "slot.h"
 #include "slot_id.h"
 
@@ -26,8 +35,6 @@ namespace csc {
 }
 
 namespace csg {
-	class Node;
-
 	enum class GraphType {
 		EMPTY,
 		MATERIAL,
@@ -52,36 +59,54 @@ namespace csg {
 
 	/**
 	 * @brief Class to manage and operate on a shader graph.
+	 * Copies of a graph share their nodes, a node is only copied when one of the graphs changes it.
+	 * Copying a graph only copies two pointers, the first change after that copies the table of nodes or of connections it touches.
 	 */
 	class Graph {
 	public:
-		// Deserialize a graph
-		static boost::optional<Graph> from(const std::string& graph_string);
+		// Nodes in draw order, the first node is drawn on top of every other
+		typedef boost::iterator_range<boost::indirect_iterator<std::vector<std::shared_ptr<Node>>::const_reverse_iterator, const Node>> NodeRange;
 
-		Graph(GraphType type);
+		// Deserialize a graph from either the text or binary format
+		static boost::optional<Graph> from(boost::string_view graph_string);
 
-		// Copy constructor and copy assignment operator, constructor defers to assignment
-		Graph(const Graph& other) { this->operator=(other); }
-		Graph& operator=(const Graph& other);
+		Graph(GraphType type);
 
-		std::shared_ptr<const Node> get(NodeId id) const;
+		// Copy constructor and copy assignment operator, both tables are shared rather than copied
+		Graph(const Graph& other) = default;
+		Graph& operator=(const Graph& other) = default;
+		// Move constructor and move assignment operator, these transfer nodes without copying them
+		// The moved from graph is left empty with a new version
+		Graph(Graph&& other) { this->operator=(std::move(other)); }
+		Graph& operator=(Graph&& other);
+
+		// Returns nullptr if there is no node with this id
+		// The pointer is only valid until the graph is next changed, a change can replace a node shared with another graph
+		const Node* get(NodeId id) const;
 		boost::optional<SlotValue> get_slot_value(SlotId slot_id) const;
-		template <typename T> boost::optional<T> get_slot_value_as(SlotId slot_id) const
+		// Returns nullptr if the slot does not hold a T, the pointer is only valid until the graph is next changed
+		template <typename T> const T* get_slot_value_ptr(const SlotId slot_id) const
+		{
+			const Node* const node{ get(slot_id.node_id()) };
+			return (node == nullptr) ? nullptr : node->slot_value_ptr<T>(slot_id.index());
+		}
+		template <typename T> boost::optional<T> get_slot_value_as(const SlotId slot_id) const
 		{
-			const boost::optional<SlotValue> opt_value{ get_slot_value(slot_id) };
-			if (opt_value) {
-				return opt_value->as<T>();
-			}
-			else {
-				return boost::none;
-			}
+			const T* const value{ get_slot_value_ptr<T>(slot_id) };
+			return (value == nullptr) ? boost::none : boost::optional<T>{ *value };
 		}
 
 		NodeId add(NodeType type, csc::Int2 pos);
 		bool add(NodeType type, csc::Int2 pos, NodeId id);
+		// Add a node that was built outside of the graph, returns false if its id is already used
+		bool add(Node node);
 		void remove(const std::set<NodeId>& ids);
 		boost::optional<NodeId> duplicate(NodeId node_id);
+		// Copy everything except id and position from source to the node with the given id, connections are kept
+		bool copy_node(NodeId dest_id, const Node& source);
 
+		// Any connection already going into dest is replaced
+		// Fails if the source node is already connected downstream of the dest node, a graph never has a cycle
 		bool add_connection(SlotId source, SlotId dest);
 		boost::optional<Connection> remove_connection(SlotId dest);
 
@@ -96,22 +121,102 @@ namespace csg {
 		bool set_curve_vec(SlotId slot_id, const VectorCurveSlotValue& new_value);
 
 		void move(const std::set<NodeId>& ids, csc::Float2 delta);
+		bool set_position(NodeId id, csc::Int2 position);
 		void raise(NodeId id);
 
 		bool contains(NodeId id) const;
 
-		const std::list<std::shared_ptr<Node>>& nodes() const { return _nodes; }
-		const std::list<Connection> connections() const { return _connections; }
-
-		std::string serialize() const;
-
+		NodeRange nodes() const
+		{
+			return NodeRange{
+				boost::indirect_iterator<std::vector<std::shared_ptr<Node>>::const_reverse_iterator, const Node>{ node_table->nodes.values().crbegin() },
+				boost::indirect_iterator<std::vector<std::shared_ptr<Node>>::const_reverse_iterator, const Node>{ node_table->nodes.values().crend() }
+			};
+		}
+		// In no particular order, removing a connection can move another one into its place
+		const std::vector<Connection>& connections() const { return connection_table->connections; }
+		// The connection going into an input slot, if there is one
+		boost::optional<Connection> connection_to(SlotId dest) const;
+		// Connections from any output of the node and into any input of the node
+		std::vector<Connection> connections_from(NodeId id) const;
+		std::vector<Connection> connections_to(NodeId id) const;
+
+		// Every node, each one before all of the nodes it connects into
+		// Kept up to date as connections change, adding a connection only reorders the nodes between its two ends
+		const std::vector<NodeId>& topological_order() const { return connection_table->topological_order; }
+		// True for output nodes and every node connected to one through any number of other nodes
+		bool reaches_output(NodeId id) const;
+
+		std::string serialize(SerializedFormat format = SerializedFormat::TEXT) const;
+
+		// Changes whenever the graph is changed and is never reused by another graph
+		// Two graphs with the same version are copies of each other that have not changed since
+		uint64_t version() const { return _version; }
+		// Hash of everything operator== compares exactly: node ids, types and positions, connections, and bool, enum and int values
+		// Float values compare within a tolerance so they are left out, equal graphs always have the same hash
+		uint64_t structure_hash() const { return _structure_hash; }
+
+		// Constant time when the versions match or the hashes differ, otherwise compares every node not shared by both graphs
 		bool operator==(const Graph& other) const;
 		bool operator!=(const Graph& other) const { return (operator==(other) == false); }
 
 	private:
-		std::list<std::shared_ptr<Node>> _nodes;
-		std::list<Connection> _connections;
-
-		std::map<NodeId, std::shared_ptr<Node>> nodes_by_id;
+		// Connections and ordering of one node, every node in the graph has one
+		struct NodeConnections {
+			// Indices into _connections of the connections touching this node
+			// A node has at most one incoming connection per input, so only outgoing connections can be numerous
+			std::vector<size_t> incoming;
+			std::vector<size_t> outgoing;
+			size_t order_position{ 0 };
+			// Number of outgoing connections into nodes that reach an output
+			size_t live_outgoing{ 0 };
+			bool is_output{ false };
+			// Equal to search_count once order_connection has visited this node
+			uint64_t search_mark{ 0 };
+		};
+
+		// Stored bottom to top, the reverse of draw order, so adding a node on top is an append
+		// A node is never changed while another graph holds it, so every const access is safe to share between threads
+		struct NodeTable {
+			csc::SlotMap<std::shared_ptr<Node>> nodes;
+			csc::IdMap<NodeId, csc::SlotMap<std::shared_ptr<Node>>::Handle> handles_by_id;
+		};
+
+		struct ConnectionTable {
+			std::vector<Connection> connections;
+			// Position of each connection in the outgoing list of its source node, so removal never searches that list
+			std::vector<size_t> outgoing_positions;
+			csc::IdMap<NodeId, NodeConnections> by_node;
+			std::vector<NodeId> topological_order;
+			uint64_t search_count{ 0 };
+		};
+
+		static uint64_t new_version();
+		// Called after every change, with the node's hash from before the change if it was a node that changed
+		void changed() { _version = new_version(); }
+		void node_changed(uint64_t old_node_hash, const Node& node);
+
+		// These copy the node or table first if it is shared with another graph, so the change is only seen by this one
+		Node* get_mutable(NodeId id);
+		NodeTable& mutable_node_table();
+		ConnectionTable& mutable_connection_table();
+		template <typename TSlot, typename TRaw> bool set_slot_value(SlotId slot_id, const TRaw& new_value);
+
+		boost::optional<size_t> connection_index_to(SlotId dest) const;
+		void remove_connection_at(size_t index);
+		void remove_connections_of(NodeId id);
+		// Reorders nodes so source comes before dest, returns false if dest already reaches source
+		bool order_connection(NodeId source, NodeId dest);
+		// Adds or takes away one live outgoing connection and passes on any change in reaches_output to the node's sources
+		void change_live_outgoing(NodeId id, bool increase);
+
+		// Shared with copies of this graph, a value change copies the node table and a connection change the connection table
+		// Either copy is one pass over the nodes, so the first change after a copy is still linear in the size of the graph
+		std::shared_ptr<NodeTable> node_table{ std::make_shared<NodeTable>() };
+		std::shared_ptr<ConnectionTable> connection_table{ std::make_shared<ConnectionTable>() };
+
+		uint64_t _version{ new_version() };
+		// Sum of the hash of every node and connection, so each one can be added or taken out on its own
+		uint64_t _structure_hash{ 0 };
 	};
 }
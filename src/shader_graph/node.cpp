@@ -1,684 +1,898 @@
 #include "node.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <cfloat>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <random>
+#include <utility>
+
+#include "shader_core/hash.h"
+#include "shader_core/string_table.h"
 
 #include "node_enums.h"
+#include "serialize.h"
+
+// Set by seed_ids, a thread starts a new id stream whenever the seed version changes
+// Version 0 means ids have never been seeded and each stream starts from random_node_id_seed
+static std::atomic<uint64_t> node_id_seed{ 0 };
+static std::atomic<uint64_t> node_id_seed_version{ 0 };
+static std::atomic<uint64_t> node_id_next_stream{ 0 };
 
-static std::mutex node_id_rng_mutex;
-static std::mt19937 node_id_rng;
+// splitmix64 state of this thread
+struct NodeIdGenerator {
+	uint64_t state{ 0 };
+	uint64_t seed_version{ 0 };
+	bool started{ false };
+};
+static thread_local NodeIdGenerator node_id_generator;
+
+static uint64_t random_node_id_seed()
+{
+	static const uint64_t seed{ [] {
+		std::random_device device;
+		const uint64_t device_bits{ (static_cast<uint64_t>(device()) << 32) ^ device() };
+		return csc::combine_hash(device_bits, static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+	}() };
+	return seed;
+}
 
 static const float MY_PI{ static_cast<float>(acos(-1.0)) };
 
-csg::Node::Node(const NodeType type, const csc::Int2 position) : position{ position }, _type{ type }
+// Every slot of a node type, along with the default value of each input
+struct csg::Node::Schema {
+	static constexpr size_t NO_VALUE{ std::numeric_limits<size_t>::max() };
+
+	explicit Schema(NodeType type);
+
+	std::vector<Slot> slots;
+	// Index in default_values of each slot, NO_VALUE for slots that do not hold a value
+	std::vector<size_t> value_indices;
+	std::vector<SlotValue> default_values;
+
+	csc::StringTable<size_t> input_names;
+	csc::StringTable<size_t> output_names;
+	csc::StringTable<size_t> input_disp_names;
+	csc::StringTable<size_t> output_disp_names;
+
+private:
+	void add(const char* disp_name, const char* name, SlotDirection dir, SlotType type, bool has_pin = true);
+	// A slot with a value is always an input, and only some types of value get a pin by default
+	void add(const char* disp_name, const char* name, BoolSlotValue value, bool has_pin = false) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, ColorSlotValue value, bool has_pin = true) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, EnumSlotValue value, bool has_pin = false) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, FloatSlotValue value, bool has_pin = true) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, IntSlotValue value, bool has_pin = false) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, VectorSlotValue value, bool has_pin = true) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, const RGBCurveSlotValue& value, bool has_pin = false) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, const VectorCurveSlotValue& value, bool has_pin = false) { add_value(disp_name, name, value, has_pin); }
+	void add(const char* disp_name, const char* name, const ColorRampSlotValue& value, bool has_pin = false) { add_value(disp_name, name, value, has_pin); }
+	void add_value(const char* disp_name, const char* name, const SlotValue& value, bool has_pin);
+	// Lets a slot also be found by an older name, the alias is only used for inputs or outputs named name
+	void add_alias(const char* alias, const char* name) { aliases.push_back(std::make_pair(alias, name)); }
+	void build_name_tables();
+
+	std::vector<std::pair<const char*, const char*>> aliases;
+};
+
+constexpr size_t csg::Node::Schema::NO_VALUE;
+
+struct csg::Node::UndecodedValue {
+	UndecodedValue(const boost::string_view text, const size_t max_curve_points) : text{ text.to_string() }, max_curve_points{ max_curve_points } {}
+
+	// Decodes on the first call from any thread, text that does not decode gives the value as it was before loading
+	const SlotValue& get(const SlotValue& default_value) const
+	{
+		std::call_once(decoded, [&]() {
+			const boost::optional<SlotValue> opt_value{ decode_slot_value(default_value, text, max_curve_points) };
+			value = opt_value ? *opt_value : default_value;
+		});
+		return *value;
+	}
+
+	const std::string text;
+	const size_t max_curve_points;
+
+private:
+	mutable std::once_flag decoded;
+	mutable boost::optional<SlotValue> value;
+};
+
+csg::Node::Node(const NodeType type, const csc::Int2 position) :
+	Node(type, position, roll_id())
+{
+
+}
+
+csg::Node::Node(const NodeType type, const csc::Int2 position, const NodeId id) :
+	position{ position },
+	_id{ id },
+	_type{ type },
+	_schema{ &schema_for(type) }
+{
+
+}
+
+csg::Node::Node(const Node& other) :
+	position{ other.position },
+	_id{ other._id },
+	_type{ other._type },
+	_schema{ other._schema },
+	_values{ other._values },
+	_undecoded_values{ other._undecoded_values },
+	_serialized_values{ other.serialized_values() }
+{
+
+}
+
+csg::Node& csg::Node::operator=(const Node& other)
+{
+	position = other.position;
+	_id = other._id;
+	_type = other._type;
+	_schema = other._schema;
+	_values = other._values;
+	_undecoded_values = other._undecoded_values;
+	set_serialized_values(other.serialized_values());
+	return *this;
+}
+
+csg::Node::Schema::Schema(const NodeType type)
 {
 	switch (type) {
 		//////
 		// Output
 		//////
 	case NodeType::MATERIAL_OUTPUT:
-		_slots.push_back(Slot{ "Surface",      "surface",      SlotDirection::INPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Volume",       "volume",       SlotDirection::INPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Displacement", "displacement", SlotDirection::INPUT, SlotType::VECTOR });
+		add("Surface",      "surface",      SlotDirection::INPUT, SlotType::CLOSURE);
+		add("Volume",       "volume",       SlotDirection::INPUT, SlotType::CLOSURE);
+		add("Displacement", "displacement", SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 		//////
 		// Color
 		//////
 	case NodeType::BRIGHTNESS_CONTRAST:
-		_slots.push_back(Slot{ "Color",    "color",    SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Color",    "color",    ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} } });
-		_slots.push_back(Slot{ "Bright",   "bright",   FloatSlotValue{ 0.0f, -100.0f, 100.0f } });
-		_slots.push_back(Slot{ "Contrast", "contrast", FloatSlotValue{ 0.0f, -100.0f, 100.0f } });
+		add("Color",    "color",    SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Color",    "color",    ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} });
+		add("Bright",   "bright",   FloatSlotValue{ 0.0f, -100.0f, 100.0f });
+		add("Contrast", "contrast", FloatSlotValue{ 0.0f, -100.0f, 100.0f });
 		break;
 	case NodeType::GAMMA:
-		_slots.push_back(Slot{ "Color", "color", SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Color", "color", ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} } });
-		_slots.push_back(Slot{ "Gamma", "gamma", FloatSlotValue{ 1.0f, 0.01f, 10.0f } });
+		add("Color", "color", SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Color", "color", ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} });
+		add("Gamma", "gamma", FloatSlotValue{ 1.0f, 0.01f, 10.0f });
 		break;
 	case NodeType::HSV:
-		_slots.push_back(Slot{ "Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Hue",        "hue",        FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Saturation", "saturation", FloatSlotValue{ 1.0f, 0.0f, 2.0f } });
-		_slots.push_back(Slot{ "Value",      "value",      FloatSlotValue{ 1.0f, 0.0f, 2.0f } });
-		_slots.push_back(Slot{ "Fac",        "fac",        FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Color",      "color",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} } });
+		add("Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Hue",        "hue",        FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Saturation", "saturation", FloatSlotValue{ 1.0f, 0.0f, 2.0f });
+		add("Value",      "value",      FloatSlotValue{ 1.0f, 0.0f, 2.0f });
+		add("Fac",        "fac",        FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Color",      "color",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} });
 		break;
 	case NodeType::INVERT:
-		_slots.push_back(Slot{ "Color", "color", SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Fac",   "fac",   FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Color", "color", ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} } });
+		add("Color", "color", SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Fac",   "fac",   FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Color", "color", ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} });
 		break;
 	case NodeType::LIGHT_FALLOFF:
-		_slots.push_back(Slot{ "Quadratic", "quadratic", SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Linear",    "linear",    SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Constant",  "constant",  SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Strength",  "strength",  FloatSlotValue{ 100.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Smooth",    "smooth",    FloatSlotValue{ 0.0f, 0.0f, FLT_MAX } });
+		add("Quadratic", "quadratic", SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Linear",    "linear",    SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Constant",  "constant",  SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Strength",  "strength",  FloatSlotValue{ 100.0f, 0.0f, FLT_MAX });
+		add("Smooth",    "smooth",    FloatSlotValue{ 0.0f, 0.0f, FLT_MAX });
 		break;
 	case NodeType::MIX_RGB:
-		_slots.push_back(Slot{ "Color",    "color",     SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Mix Type", "mix_type",  EnumSlotValue{ MixRGBType::MIX } });
-		_slots.push_back(Slot{ "Clamp",    "use_clamp", BoolSlotValue{ false } });
-		_slots.push_back(Slot{ "Fac",      "fac",       FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Color1",   "color1",    ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Color2",   "color2",    ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slot_aliases.push_back(std::make_pair("type", "mix_type"));
+		add("Color",    "color",     SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Mix Type", "mix_type",  EnumSlotValue{ MixRGBType::MIX });
+		add("Clamp",    "use_clamp", BoolSlotValue{ false });
+		add("Fac",      "fac",       FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Color1",   "color1",    ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Color2",   "color2",    ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add_alias("type", "mix_type");
 		break;
 	case NodeType::RGB_CURVES:
-		_slots.push_back(Slot{ "Color",  "color",  SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Curves", "curves", RGBCurveSlotValue{} });
-		_slots.push_back(Slot{ "Fac",    "fac",    FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Color",  "color",  ColorSlotValue{ csc::Float3{ 0.0f, 0.0f, 0.0f} } });
+		add("Color",  "color",  SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Curves", "curves", RGBCurveSlotValue{});
+		add("Fac",    "fac",    FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Color",  "color",  ColorSlotValue{ csc::Float3{ 0.0f, 0.0f, 0.0f} });
 		break;
 		//////
 		// Converter
 		//////
 	case NodeType::BLACKBODY:
-		_slots.push_back(Slot{ "Color",       "color",       SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Temperature", "temperature", FloatSlotValue{ 1500.0f, 800.0f, 20000.0f } });
+		add("Color",       "color",       SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Temperature", "temperature", FloatSlotValue{ 1500.0f, 800.0f, 20000.0f });
 		break;
 	case NodeType::CLAMP:
-		_slots.push_back(Slot{ "Result", "result",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Type",   "clamp_type", EnumSlotValue{ ClampType::MINMAX } });
-		_slots.push_back(Slot{ "Value",  "value",      FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX} });
-		_slots.push_back(Slot{ "Min",    "min",        FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX} });
-		_slots.push_back(Slot{ "Max",    "max",        FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX} });
-		_slot_aliases.push_back(std::make_pair("type", "clamp_type"));
+		add("Result", "result",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Type",   "clamp_type", EnumSlotValue{ ClampType::MINMAX });
+		add("Value",  "value",      FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX});
+		add("Min",    "min",        FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX});
+		add("Max",    "max",        FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX});
+		add_alias("type", "clamp_type");
 		break;
 	case NodeType::COLOR_RAMP:
-		_slots.push_back(Slot{ "Color",  "color",  SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Alpha",  "alpha",  SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Ramp",   "ramp",   ColorRampSlotValue{} });
-		_slots.push_back(Slot{ "Fac",    "fac",    FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
+		add("Color",  "color",  SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Alpha",  "alpha",  SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Ramp",   "ramp",   ColorRampSlotValue{});
+		add("Fac",    "fac",    FloatSlotValue{ 0.5f, 0.0f, 1.0f });
 		break;
 	case NodeType::COMBINE_HSV:
-		_slots.push_back(Slot{ "Color", "color", SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "H",     "h",     FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "S",     "s",     FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "V",     "v",     FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
+		add("Color", "color", SlotDirection::OUTPUT, SlotType::COLOR);
+		add("H",     "h",     FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("S",     "s",     FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("V",     "v",     FloatSlotValue{ 0.0f, 0.0f, 1.0f });
 		break;
 	case NodeType::COMBINE_RGB:
-		_slots.push_back(Slot{ "Image", "image", SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "R",     "r",     FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "G",     "g",     FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "B",     "b",     FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
+		add("Image", "image", SlotDirection::OUTPUT, SlotType::COLOR);
+		add("R",     "r",     FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("G",     "g",     FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("B",     "b",     FloatSlotValue{ 0.0f, 0.0f, 1.0f });
 		break;
 	case NodeType::COMBINE_XYZ:
-		_slots.push_back(Slot{ "Vector", "vector", SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "X",      "x",      FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Y",      "y",      FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Z",      "z",      FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
+		add("Vector", "vector", SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("X",      "x",      FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Y",      "y",      FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Z",      "z",      FloatSlotValue{ 0.0f, 0.0f, 1.0f });
 		break;
 	case NodeType::MAP_RANGE:
-		_slots.push_back(Slot{ "Result",     "result",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Range Type", "range_type", EnumSlotValue{ MapRangeType::LINEAR } });
-		_slots.push_back(Slot{ "Clamp",      "clamp",      BoolSlotValue{ true } });
-		_slots.push_back(Slot{ "Value",      "value",      FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "From Min",   "from_min",   FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "From Max",   "from_max",   FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "To Min",     "to_min",     FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "To Max",     "to_max",     FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Steps",      "steps",      FloatSlotValue{ 4.0f, 0.0f, FLT_MAX } });
-		_slot_aliases.push_back(std::make_pair("type", "range_type"));
+		add("Result",     "result",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Range Type", "range_type", EnumSlotValue{ MapRangeType::LINEAR });
+		add("Clamp",      "clamp",      BoolSlotValue{ true });
+		add("Value",      "value",      FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("From Min",   "from_min",   FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("From Max",   "from_max",   FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX });
+		add("To Min",     "to_min",     FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("To Max",     "to_max",     FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX });
+		add("Steps",      "steps",      FloatSlotValue{ 4.0f, 0.0f, FLT_MAX });
+		add_alias("type", "range_type");
 		break;
 	case NodeType::MATH:
-		_slots.push_back(Slot{ "Value",     "value",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Math Type", "math_type", EnumSlotValue{ MathType::ADD } });
-		_slots.push_back(Slot{ "Clamp",     "use_clamp", BoolSlotValue{ false } });
-		_slots.push_back(Slot{ "Value1",    "value1",    FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Value2",    "value2",    FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Value3",    "value3",    FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slot_aliases.push_back(std::make_pair("type", "math_type"));
+		add("Value",     "value",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Math Type", "math_type", EnumSlotValue{ MathType::ADD });
+		add("Clamp",     "use_clamp", BoolSlotValue{ false });
+		add("Value1",    "value1",    FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("Value2",    "value2",    FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("Value3",    "value3",    FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add_alias("type", "math_type");
 		break;
 	case NodeType::RGB_TO_BW:
-		_slots.push_back(Slot{ "Val",   "val",   SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Color", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
+		add("Val",   "val",   SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Color", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
 		break;
 	case NodeType::SEPARATE_HSV:
-		_slots.push_back(Slot{ "H",     "h",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "S",     "s",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "V",     "v",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Color", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
+		add("H",     "h",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("S",     "s",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("V",     "v",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Color", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
 		break;
 	case NodeType::SEPARATE_RGB:
-		_slots.push_back(Slot{ "R",     "r",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "G",     "g",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "B",     "b",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Image", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
+		add("R",     "r",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("G",     "g",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("B",     "b",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Image", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
 		break;
 	case NodeType::SEPARATE_XYZ:
-		_slots.push_back(Slot{ "X",      "x",      SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Y",      "y",      SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Z",      "z",      SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Vector", "vector", VectorSlotValue{
+		add("X",      "x",      SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Y",      "y",      SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Z",      "z",      SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Vector", "vector", VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
+		});
 		break;
 	case NodeType::VECTOR_MATH:
-		_slots.push_back(Slot{ "Vector",    "vector",    SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Math Type", "math_type", EnumSlotValue{ VectorMathType::ADD } });
-		_slots.push_back(Slot{ "Vector1",   "vector1",   VectorSlotValue{
+		add("Vector",    "vector",    SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Math Type", "math_type", EnumSlotValue{ VectorMathType::ADD });
+		add("Vector1",   "vector1",   VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Vector2",   "vector2",   VectorSlotValue{
+		});
+		add("Vector2",   "vector2",   VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Vector3",   "vector3",   VectorSlotValue{
+		});
+		add("Vector3",   "vector3",   VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Scale",     "scale",     FloatSlotValue{ 1.0f,  -FLT_MAX, FLT_MAX } });
-		_slot_aliases.push_back(std::make_pair("type", "math_type"));
+		});
+		add("Scale",     "scale",     FloatSlotValue{ 1.0f,  -FLT_MAX, FLT_MAX });
+		add_alias("type", "math_type");
 		break;
 	case NodeType::WAVELENGTH:
-		_slots.push_back(Slot{ "Color",      "color",        SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Wavelength", "wavelength",   FloatSlotValue{ 500.0f,  380.0f, 780.0f } });
+		add("Color",      "color",        SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Wavelength", "wavelength",   FloatSlotValue{ 500.0f,  380.0f, 780.0f });
 		break;
 		//////
 		// Input
 		//////
 	case NodeType::AMBIENT_OCCLUSION:
-		_slots.push_back(Slot{ "Color",       "color",      SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "AO",          "ao",         SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Samples",     "samples",    IntSlotValue{ 16,  1, 128 } });
-		_slots.push_back(Slot{ "Inside",      "inside",     BoolSlotValue{ false } });
-		_slots.push_back(Slot{ "Only Local",  "only_local", BoolSlotValue{ false } });
-		_slots.push_back(Slot{ "Color",       "color",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} } });
-		_slots.push_back(Slot{ "Distance",    "distance",   FloatSlotValue{ 1.0f,  0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Normal",      "normal",     SlotDirection::INPUT, SlotType::VECTOR });
+		add("Color",       "color",      SlotDirection::OUTPUT, SlotType::COLOR);
+		add("AO",          "ao",         SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Samples",     "samples",    IntSlotValue{ 16,  1, 128 });
+		add("Inside",      "inside",     BoolSlotValue{ false });
+		add("Only Local",  "only_local", BoolSlotValue{ false });
+		add("Color",       "color",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f} });
+		add("Distance",    "distance",   FloatSlotValue{ 1.0f,  0.0f, FLT_MAX });
+		add("Normal",      "normal",     SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::BEVEL:
-		_slots.push_back(Slot{ "Normal",  "normal",  SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Samples", "samples", IntSlotValue{ 4,  2, 16 } });
-		_slots.push_back(Slot{ "Radius",  "radius",  FloatSlotValue{ 0.5f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Normal",  "normal",  SlotDirection::INPUT, SlotType::VECTOR });
+		add("Normal",  "normal",  SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Samples", "samples", IntSlotValue{ 4,  2, 16 });
+		add("Radius",  "radius",  FloatSlotValue{ 0.5f, 0.0f, FLT_MAX });
+		add("Normal",  "normal",  SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::CAMERA_DATA:
-		_slots.push_back(Slot{ "View Vector",   "view_vector",    SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "View Z Depth",  "view_z_depth",   SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "View Distance", "view_distance",  SlotDirection::OUTPUT, SlotType::FLOAT });
+		add("View Vector",   "view_vector",    SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("View Z Depth",  "view_z_depth",   SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("View Distance", "view_distance",  SlotDirection::OUTPUT, SlotType::FLOAT);
 		break;
 	case NodeType::FRESNEL:
-		_slots.push_back(Slot{ "Fac",    "fac",    SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "IOR",    "IOR",    FloatSlotValue{ 1.45f, 0.0f, 100.0f } });
-		_slots.push_back(Slot{ "Normal", "normal", SlotDirection::INPUT, SlotType::VECTOR });
+		add("Fac",    "fac",    SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("IOR",    "IOR",    FloatSlotValue{ 1.45f, 0.0f, 100.0f });
+		add("Normal", "normal", SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::GEOMETRY:
-		_slots.push_back(Slot{ "Position",           "position",           SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Normal",             "normal",             SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Tangent",            "tangent",            SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "True Normal",        "true_normal",        SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Incoming",           "incoming",           SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Parametric",         "parametric",         SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Backfacing",         "backfacing",         SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Pointiness",         "pointiness",         SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Random Per Island",  "random_per_island",  SlotDirection::OUTPUT, SlotType::FLOAT });
+		add("Position",           "position",           SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Normal",             "normal",             SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Tangent",            "tangent",            SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("True Normal",        "true_normal",        SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Incoming",           "incoming",           SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Parametric",         "parametric",         SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Backfacing",         "backfacing",         SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Pointiness",         "pointiness",         SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Random Per Island",  "random_per_island",  SlotDirection::OUTPUT, SlotType::FLOAT);
 		break;
 	case NodeType::LAYER_WEIGHT:
-		_slots.push_back(Slot{ "Fresnel", "fresnel", SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Facing",  "facing",  SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Blend",   "blend",   FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal",  "normal",  SlotDirection::INPUT, SlotType::VECTOR });
+		add("Fresnel", "fresnel", SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Facing",  "facing",  SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Blend",   "blend",   FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Normal",  "normal",  SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::LIGHT_PATH:
-		_slots.push_back(Slot{ "Is Camera Ray",       "is_camera_ray",       SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Is Shadow Ray",       "is_shadow_ray",       SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Is Diffuse Ray",      "is_diffuse_ray",      SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Is Glossy Ray",       "is_glossy_ray",       SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Is Singular Ray",     "is_singular_ray",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Is Reflection Ray",   "is_reflection_ray",   SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Is Transmission Ray", "is_transmission_ray", SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Ray Length",          "ray_length",          SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Ray Depth",           "ray_depth",           SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Diffuse Depth",       "diffuse_depth",       SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Glossy Depth",        "glossy_depth",        SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Transparent Depth",   "transparent_depth",   SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Transmission Depth",  "transmission_depth",  SlotDirection::OUTPUT, SlotType::FLOAT });
+		add("Is Camera Ray",       "is_camera_ray",       SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Is Shadow Ray",       "is_shadow_ray",       SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Is Diffuse Ray",      "is_diffuse_ray",      SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Is Glossy Ray",       "is_glossy_ray",       SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Is Singular Ray",     "is_singular_ray",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Is Reflection Ray",   "is_reflection_ray",   SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Is Transmission Ray", "is_transmission_ray", SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Ray Length",          "ray_length",          SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Ray Depth",           "ray_depth",           SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Diffuse Depth",       "diffuse_depth",       SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Glossy Depth",        "glossy_depth",        SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Transparent Depth",   "transparent_depth",   SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Transmission Depth",  "transmission_depth",  SlotDirection::OUTPUT, SlotType::FLOAT);
 		break;
 	case NodeType::OBJECT_INFO:
-		_slots.push_back(Slot{ "Location",       "location",     SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Color",          "color",        SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Object Index",   "object_index", SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Material Index", "material",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Random",         "random",       SlotDirection::OUTPUT, SlotType::FLOAT });
+		add("Location",       "location",     SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Color",          "color",        SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Object Index",   "object_index", SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Material Index", "material",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Random",         "random",       SlotDirection::OUTPUT, SlotType::FLOAT);
 		break;
 	case NodeType::RGB:
-		_slots.push_back(Slot{ "Color", "color", SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Value", "value", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
+		add("Color", "color", SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Value", "value", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
 		break;
 	case NodeType::TANGENT:
-		_slots.push_back(Slot{ "Tangent",     "tangent",   SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Direction",   "direction", EnumSlotValue{ TangentDirection::RADIAL } });
-		_slots.push_back(Slot{ "Radial Axis", "axis",      EnumSlotValue{ TangentAxis::Z } });
+		add("Tangent",     "tangent",   SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Direction",   "direction", EnumSlotValue{ TangentDirection::RADIAL });
+		add("Radial Axis", "axis",      EnumSlotValue{ TangentAxis::Z });
 		break;
 	case NodeType::TEXTURE_COORDINATE:
-		_slots.push_back(Slot{ "Generated",  "generated",  SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Normal",     "normal",     SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "UV",         "UV",         SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Object",     "object",     SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Camera",     "camera",     SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Window",     "window",     SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Reflection", "reflection", SlotDirection::OUTPUT, SlotType::VECTOR });
+		add("Generated",  "generated",  SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Normal",     "normal",     SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("UV",         "UV",         SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Object",     "object",     SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Camera",     "camera",     SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Window",     "window",     SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Reflection", "reflection", SlotDirection::OUTPUT, SlotType::VECTOR);
 		break;
 	case NodeType::VALUE:
-		_slots.push_back(Slot{ "Value", "value", SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Value", "value", FloatSlotValue{ 0.0f,  -FLT_MAX, FLT_MAX } });
+		add("Value", "value", SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Value", "value", FloatSlotValue{ 0.0f,  -FLT_MAX, FLT_MAX });
 		break;
 	case NodeType::WIREFRAME:
-		_slots.push_back(Slot{ "Fac",            "fac",              SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Use Pixel Size", "use_pixel_size",   BoolSlotValue{ false } });
-		_slots.push_back(Slot{ "Size",           "size",             FloatSlotValue{ 0.1f,  0.0f, FLT_MAX } });
+		add("Fac",            "fac",              SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Use Pixel Size", "use_pixel_size",   BoolSlotValue{ false });
+		add("Size",           "size",             FloatSlotValue{ 0.1f,  0.0f, FLT_MAX });
 		break;
 		//////
 		// Shader
 		//////
 	case NodeType::ADD_SHADER:
-		_slots.push_back(Slot{ "Closure",  "closure",  SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Closure1", "closure1", SlotDirection::INPUT,  SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Closure2", "closure2", SlotDirection::INPUT,  SlotType::CLOSURE });
+		add("Closure",  "closure",  SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Closure1", "closure1", SlotDirection::INPUT,  SlotType::CLOSURE);
+		add("Closure2", "closure2", SlotDirection::INPUT,  SlotType::CLOSURE);
 		break;
 	case NodeType::ANISOTROPIC_BSDF:
-		_slots.push_back(Slot{ "BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Distribution", "distribution", EnumSlotValue{ AnisotropicDistribution::GGX } });
-		_slots.push_back(Slot{ "Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Roughness",    "roughness",    FloatSlotValue{ 0.0f,  0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Anisotropy",   "anisotropy",   FloatSlotValue{ 0.5f, -1.0f, 1.0f } });
-		_slots.push_back(Slot{ "Rotation",     "rotation",     FloatSlotValue{ 0.0f,  0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Tangent",      "tangent",      SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Distribution", "distribution", EnumSlotValue{ AnisotropicDistribution::GGX });
+		add("Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Roughness",    "roughness",    FloatSlotValue{ 0.0f,  0.0f, 1.0f });
+		add("Anisotropy",   "anisotropy",   FloatSlotValue{ 0.5f, -1.0f, 1.0f });
+		add("Rotation",     "rotation",     FloatSlotValue{ 0.0f,  0.0f, 1.0f });
+		add("Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR);
+		add("Tangent",      "tangent",      SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::DIFFUSE_BSDF:
-		_slots.push_back(Slot{ "BSDF",      "BSDF",      SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color",     "color",     ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Roughness", "roughness", FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal",    "normal",    SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",      "BSDF",      SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color",     "color",     ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Roughness", "roughness", FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Normal",    "normal",    SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::EMISSION:
-		_slots.push_back(Slot{ "Emission", "emission", SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color",    "color",    ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Strength", "strength", FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
+		add("Emission", "emission", SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color",    "color",    ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Strength", "strength", FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
 		break;
 	case NodeType::GLASS_BSDF:
-		_slots.push_back(Slot{ "BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Distribution", "distribution", EnumSlotValue{ GlassDistribution::GGX } });
-		_slots.push_back(Slot{ "Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Roughness",    "roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "IOR",          "IOR",          FloatSlotValue{ 1.45f, 0.0f, 100.0f } });
-		_slots.push_back(Slot{ "Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Distribution", "distribution", EnumSlotValue{ GlassDistribution::GGX });
+		add("Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Roughness",    "roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("IOR",          "IOR",          FloatSlotValue{ 1.45f, 0.0f, 100.0f });
+		add("Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::GLOSSY_BSDF:
-		_slots.push_back(Slot{ "BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Distribution", "distribution", EnumSlotValue{ GlossyDistribution::GGX } });
-		_slots.push_back(Slot{ "Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Roughness",    "roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Distribution", "distribution", EnumSlotValue{ GlossyDistribution::GGX });
+		add("Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Roughness",    "roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::HAIR_BSDF:
-		_slots.push_back(Slot{ "BSDF",       "BSDF",        SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Component",  "component",   EnumSlotValue{ HairComponent::REFLECTION } });
-		_slots.push_back(Slot{ "Color",      "color",       ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Offset",     "offset",      FloatSlotValue{ 0.0f, -90.0f, 90.0f, 2 } });
-		_slots.push_back(Slot{ "RoughnessU", "roughness_u", FloatSlotValue{ 0.1f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "RoughnessV", "roughness_v", FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Tangent",    "tangent",     SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",       "BSDF",        SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Component",  "component",   EnumSlotValue{ HairComponent::REFLECTION });
+		add("Color",      "color",       ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Offset",     "offset",      FloatSlotValue{ 0.0f, -90.0f, 90.0f, 2 });
+		add("RoughnessU", "roughness_u", FloatSlotValue{ 0.1f, 0.0f, 1.0f });
+		add("RoughnessV", "roughness_v", FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Tangent",    "tangent",     SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::HOLDOUT:
-		_slots.push_back(Slot{ "Holdout", "holdout", SlotDirection::OUTPUT, SlotType::CLOSURE });
+		add("Holdout", "holdout", SlotDirection::OUTPUT, SlotType::CLOSURE);
 		break;
 	case NodeType::MIX_SHADER:
-		_slots.push_back(Slot{ "Closure",  "closure",  SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Fac",      "fac",      FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Closure1", "closure1", SlotDirection::INPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Closure2", "closure2", SlotDirection::INPUT, SlotType::CLOSURE });
+		add("Closure",  "closure",  SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Fac",      "fac",      FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Closure1", "closure1", SlotDirection::INPUT, SlotType::CLOSURE);
+		add("Closure2", "closure2", SlotDirection::INPUT, SlotType::CLOSURE);
 		break;
 	case NodeType::PRINCIPLED_BSDF:
-		_slots.push_back(Slot{ "BSDF",                "BSDF",                 SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Distribution",        "distribution",         EnumSlotValue{ PrincipledBSDFDistribution::GGX } });
-		_slots.push_back(Slot{ "Base Color",          "base_color",           ColorSlotValue{ csc::Float3{ 0.8f, 0.8f, 0.8f} } });
-		_slots.push_back(Slot{ "Subsurface Method",   "subsurface_method",    EnumSlotValue{ PrincipledBSDFSubsurfaceMethod::BURLEY } });
-		_slots.push_back(Slot{ "Subsurface",          "subsurface",           FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Subsurface Radius",   "subsurface_radius",    VectorSlotValue{
+		add("BSDF",                "BSDF",                 SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Distribution",        "distribution",         EnumSlotValue{ PrincipledBSDFDistribution::GGX });
+		add("Base Color",          "base_color",           ColorSlotValue{ csc::Float3{ 0.8f, 0.8f, 0.8f} });
+		add("Subsurface Method",   "subsurface_method",    EnumSlotValue{ PrincipledBSDFSubsurfaceMethod::BURLEY });
+		add("Subsurface",          "subsurface",           FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Subsurface Radius",   "subsurface_radius",    VectorSlotValue{
 			csc::Float3{ 1.0f, 0.2f, 0.1f }, csc::Float3{ 0.0f, 0.0f, 0.0f } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		}});
-		_slots.push_back(Slot{ "Subsurface Color",       "subsurface_color",       ColorSlotValue{ csc::Float3{ 0.7f, 1.0f, 1.0f} } });
-		_slots.push_back(Slot{ "Metallic",               "metallic",               FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Specular",               "specular",               FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Specular Tint",          "specular_tint",          FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Roughness",              "roughness",              FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Anisotropic",            "anisotropic",            FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Anisotropic Rotation",   "anisotropic_rotation",   FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Sheen",                  "sheen",                  FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Sheen Tint",             "sheen_tint",             FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Clearcoat",              "clearcoat",              FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Clearcoat Roughness",    "clearcoat_roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "IOR",                    "ior",                    FloatSlotValue{ 1.45f, 0.0f, 100.0f } });
-		_slots.push_back(Slot{ "Transmission",           "transmission",           FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Transmission Roughness", "transmission_roughness", FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Emission",               "emission",               ColorSlotValue{ csc::Float3{ 0.0f, 0.0f, 0.0f } } });
-		_slots.push_back(Slot{ "Emission Strength",      "emission_strength",      FloatSlotValue{ 1.0f, 0.0f, 10000.0f } });
-		_slots.push_back(Slot{ "Alpha",                  "alpha",                  FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal",                 "normal",                 SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Clearcoat Normal",       "clearcoat_normal",       SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Tangent",                "tangent",                SlotDirection::INPUT, SlotType::VECTOR });
+		});
+		add("Subsurface Color",       "subsurface_color",       ColorSlotValue{ csc::Float3{ 0.7f, 1.0f, 1.0f} });
+		add("Metallic",               "metallic",               FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Specular",               "specular",               FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Specular Tint",          "specular_tint",          FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Roughness",              "roughness",              FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Anisotropic",            "anisotropic",            FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Anisotropic Rotation",   "anisotropic_rotation",   FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Sheen",                  "sheen",                  FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Sheen Tint",             "sheen_tint",             FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Clearcoat",              "clearcoat",              FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Clearcoat Roughness",    "clearcoat_roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("IOR",                    "ior",                    FloatSlotValue{ 1.45f, 0.0f, 100.0f });
+		add("Transmission",           "transmission",           FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Transmission Roughness", "transmission_roughness", FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Emission",               "emission",               ColorSlotValue{ csc::Float3{ 0.0f, 0.0f, 0.0f } });
+		add("Emission Strength",      "emission_strength",      FloatSlotValue{ 1.0f, 0.0f, 10000.0f });
+		add("Alpha",                  "alpha",                  FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Normal",                 "normal",                 SlotDirection::INPUT, SlotType::VECTOR);
+		add("Clearcoat Normal",       "clearcoat_normal",       SlotDirection::INPUT, SlotType::VECTOR);
+		add("Tangent",                "tangent",                SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::PRINCIPLED_HAIR:
-		_slots.push_back(Slot{ "BSDF",                   "BSDF",                   SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Coloring",               "coloring",               EnumSlotValue{ PrincipledHairColoring::DIRECT_COLORING } });
-		_slots.push_back(Slot{ "Color",                  "color",                  ColorSlotValue{ csc::Float3{ 0.017513f, 0.005763f, 0.002059f } } });
-		_slots.push_back(Slot{ "Melanin",                "melanin",                FloatSlotValue{ 0.8f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Melanin Redness",        "melanin_redness",        FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Tint",                   "tint",                   ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f } } });
-		_slots.push_back(Slot{ "Absorption Coefficient", "absorption_coefficient", VectorSlotValue{
+		add("BSDF",                   "BSDF",                   SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Coloring",               "coloring",               EnumSlotValue{ PrincipledHairColoring::DIRECT_COLORING });
+		add("Color",                  "color",                  ColorSlotValue{ csc::Float3{ 0.017513f, 0.005763f, 0.002059f } });
+		add("Melanin",                "melanin",                FloatSlotValue{ 0.8f, 0.0f, 1.0f });
+		add("Melanin Redness",        "melanin_redness",        FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Tint",                   "tint",                   ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f } });
+		add("Absorption Coefficient", "absorption_coefficient", VectorSlotValue{
 			csc::Float3{ 0.245531f, 0.52f, 1.365f }, csc::Float3{ 0.0f, 0.0f, 0.0f } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Roughness",              "roughness",              FloatSlotValue{ 0.3f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Radial Roughness",       "radial_roughness",       FloatSlotValue{ 0.3f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Coat",                   "coat",                   FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "IOR",                    "ior",                    FloatSlotValue{ 1.55f, 0.0f, 1000.0f } });
-		_slots.push_back(Slot{ "Offset",                 "offset",                 FloatSlotValue{ 2 * MY_PI / 180.0f, MY_PI / -2.0f , MY_PI / 2.0f } });
-		_slots.push_back(Slot{ "Random Roughness",       "random_roughness",       FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Random Color",           "random_color",           FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Random",                 "random",                 FloatSlotValue{ 0.0f, 0.0f, FLT_MAX } });
+		});
+		add("Roughness",              "roughness",              FloatSlotValue{ 0.3f, 0.0f, 1.0f });
+		add("Radial Roughness",       "radial_roughness",       FloatSlotValue{ 0.3f, 0.0f, 1.0f });
+		add("Coat",                   "coat",                   FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("IOR",                    "ior",                    FloatSlotValue{ 1.55f, 0.0f, 1000.0f });
+		add("Offset",                 "offset",                 FloatSlotValue{ 2 * MY_PI / 180.0f, MY_PI / -2.0f , MY_PI / 2.0f });
+		add("Random Roughness",       "random_roughness",       FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Random Color",           "random_color",           FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Random",                 "random",                 FloatSlotValue{ 0.0f, 0.0f, FLT_MAX });
 		break;
 	case NodeType::PRINCIPLED_VOLUME:
-		_slots.push_back(Slot{ "Volume",              "volume",              SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color",               "color",               ColorSlotValue{ csc::Float3{ 0.5f, 0.5f, 0.5f } } });
-		_slots.push_back(Slot{ "Density",             "density",             FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Anisotropy",          "anisotropy",          FloatSlotValue{ 0.0f, -1.0f, 1.0f } });
-		_slots.push_back(Slot{ "Absorption Color",    "absorption_color",    ColorSlotValue{ csc::Float3{ 0.0f, 0.0f, 0.0f } } });
-		_slots.push_back(Slot{ "Emission Strength",   "emission_strength",   FloatSlotValue{ 0.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Emission Color",      "emission_color",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f } } });
-		_slots.push_back(Slot{ "Blackbody Intensity", "blackbody_intensity", FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Blackbody Tint",      "blackbody_tint",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f } } });
-		_slots.push_back(Slot{ "Temperature",         "temperature",         FloatSlotValue{ 1000.0f, 0.0f, 8000.0f } });
+		add("Volume",              "volume",              SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color",               "color",               ColorSlotValue{ csc::Float3{ 0.5f, 0.5f, 0.5f } });
+		add("Density",             "density",             FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
+		add("Anisotropy",          "anisotropy",          FloatSlotValue{ 0.0f, -1.0f, 1.0f });
+		add("Absorption Color",    "absorption_color",    ColorSlotValue{ csc::Float3{ 0.0f, 0.0f, 0.0f } });
+		add("Emission Strength",   "emission_strength",   FloatSlotValue{ 0.0f, 0.0f, FLT_MAX });
+		add("Emission Color",      "emission_color",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f } });
+		add("Blackbody Intensity", "blackbody_intensity", FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Blackbody Tint",      "blackbody_tint",      ColorSlotValue{ csc::Float3{ 1.0f, 1.0f, 1.0f } });
+		add("Temperature",         "temperature",         FloatSlotValue{ 1000.0f, 0.0f, 8000.0f });
 		break;
 	case NodeType::REFRACTION_BSDF:
-		_slots.push_back(Slot{ "BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Distribution", "distribution", EnumSlotValue{ RefractionDistribution::GGX } });
-		_slots.push_back(Slot{ "Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Roughness",    "roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "IOR",          "IOR",          FloatSlotValue{ 1.45f, 0.0f, 100.0f } });
-		_slots.push_back(Slot{ "Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",         "BSDF",         SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Distribution", "distribution", EnumSlotValue{ RefractionDistribution::GGX });
+		add("Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Roughness",    "roughness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("IOR",          "IOR",          FloatSlotValue{ 1.45f, 0.0f, 100.0f });
+		add("Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::SUBSURFACE_SCATTER:
-		_slots.push_back(Slot{ "BSSRDF",       "BSSRDF",       SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Falloff",      "falloff",      EnumSlotValue{ SubsurfaceScatterFalloff::BURLEY } });
-		_slots.push_back(Slot{ "Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Scale",        "scale",        FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Radius",       "radius",       VectorSlotValue{
+		add("BSSRDF",       "BSSRDF",       SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Falloff",      "falloff",      EnumSlotValue{ SubsurfaceScatterFalloff::BURLEY });
+		add("Color",        "color",        ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Scale",        "scale",        FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
+		add("Radius",       "radius",       VectorSlotValue{
 			csc::Float3{ 1.0f, 1.0f, 1.0f }, csc::Float3{ 0.0f, 0.0f, 0.0f } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Sharpness",    "sharpness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Texture Blur", "texture_blur", FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR });
+		});
+		add("Sharpness",    "sharpness",    FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Texture Blur", "texture_blur", FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::TOON_BSDF:
-		_slots.push_back(Slot{ "BSDF",      "BSDF",      SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Component", "component", EnumSlotValue{ ToonComponent::DIFFUSE } });
-		_slots.push_back(Slot{ "Color",     "color",     ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Size",      "size",      FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Smooth",    "smooth",    FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal",    "normal",    SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",      "BSDF",      SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Component", "component", EnumSlotValue{ ToonComponent::DIFFUSE });
+		add("Color",     "color",     ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Size",      "size",      FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Smooth",    "smooth",    FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Normal",    "normal",    SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::TRANSLUCENT_BSDF:
-		_slots.push_back(Slot{ "BSDF",   "BSDF",   SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color",  "color",  ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Normal", "normal", SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",   "BSDF",   SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color",  "color",  ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Normal", "normal", SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::TRANSPARENT_BSDF:
-		_slots.push_back(Slot{ "BSDF",  "BSDF",  SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
+		add("BSDF",  "BSDF",  SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color", "color", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
 		break;
 	case NodeType::VELVET_BSDF:
-		_slots.push_back(Slot{ "BSDF",   "BSDF",   SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color",  "color",  ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Sigma",  "sigma",  FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Normal", "normal", SlotDirection::INPUT, SlotType::VECTOR });
+		add("BSDF",   "BSDF",   SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color",  "color",  ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Sigma",  "sigma",  FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Normal", "normal", SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::VOL_ABSORPTION:
-		_slots.push_back(Slot{ "Volume",  "volume",  SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color",   "color",   ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Density", "density", FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
+		add("Volume",  "volume",  SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color",   "color",   ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Density", "density", FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
 		break;
 	case NodeType::VOL_SCATTER:
-		_slots.push_back(Slot{ "Volume",     "volume",     SlotDirection::OUTPUT, SlotType::CLOSURE });
-		_slots.push_back(Slot{ "Color",      "color",      ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Density",    "density",    FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Anisotropy", "anisotropy", FloatSlotValue{ 0.0f, -1.0f, 1.0f } });
+		add("Volume",     "volume",     SlotDirection::OUTPUT, SlotType::CLOSURE);
+		add("Color",      "color",      ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Density",    "density",    FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
+		add("Anisotropy", "anisotropy", FloatSlotValue{ 0.0f, -1.0f, 1.0f });
 		break;
 		//////
 		// Texture
 		//////
 	case NodeType::MAX_TEXMAP:
-		_slots.push_back(Slot{ "Color",     "color",     SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Alpha",     "alpha",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Slot",      "slot",      IntSlotValue{ 1,  1, 32 } });
-		_slots.push_back(Slot{ "Auto-size", "autosize",  BoolSlotValue{ true } });
-		_slots.push_back(Slot{ "Width",     "width",     IntSlotValue{ 512,  1, 32768 } });
-		_slots.push_back(Slot{ "Height",    "height",    IntSlotValue{ 512,  1, 32768 } });
-		_slots.push_back(Slot{ "Precision", "precision", EnumSlotValue{ MaxTexmapPrecision::UCHAR } });
-		_slots.push_back(Slot{ "Vector",    "vector",    SlotDirection::INPUT, SlotType::VECTOR });
+		add("Color",     "color",     SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Alpha",     "alpha",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Slot",      "slot",      IntSlotValue{ 1,  1, 32 });
+		add("Auto-size", "autosize",  BoolSlotValue{ true });
+		add("Width",     "width",     IntSlotValue{ 512,  1, 32768 });
+		add("Height",    "height",    IntSlotValue{ 512,  1, 32768 });
+		add("Precision", "precision", EnumSlotValue{ MaxTexmapPrecision::UCHAR });
+		add("Vector",    "vector",    SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::BRICK_TEX:
-		_slots.push_back(Slot{ "Color",            "color",               SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Fac",              "fac",                 SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Offset",           "offset",              FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Offset Frequency", "offset_frequency",    IntSlotValue{ 2, 1, 99 } });
-		_slots.push_back(Slot{ "Squash",           "squash",              FloatSlotValue{ 0.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Squash Frequency", "squash_frequency",    IntSlotValue{ 2, 1, 99 } });
-		_slots.push_back(Slot{ "Vector",           "vector",              SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Color1",           "color1",              ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Color2",           "color2",              ColorSlotValue{ csc::Float3{ 0.4f, 0.4f, 0.4f} } });
-		_slots.push_back(Slot{ "Mortar",           "mortar",              ColorSlotValue{ csc::Float3{ 0.4f, 0.4f, 0.4f} } });
-		_slots.push_back(Slot{ "Scale",            "scale",               FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Mortar Size",      "mortar_size",         FloatSlotValue{ 0.08f, 0.0f, 5.0f } });
-		_slots.push_back(Slot{ "Mortar Smooth",    "mortar_smooth",       FloatSlotValue{ 0.1f, 0.0f, 10.0f } });
-		_slots.push_back(Slot{ "Bias",             "bias",                FloatSlotValue{ 0.0f, -10.0f, 10.0f } });
-		_slots.push_back(Slot{ "Brick Width",      "brick_width",         FloatSlotValue{ 0.5f, 0.0f, 10.0f } });
-		_slots.push_back(Slot{ "Row Height",       "row_height",          FloatSlotValue{ 0.25f, 0.0f, 10.0f } });
+		add("Color",            "color",               SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Fac",              "fac",                 SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Offset",           "offset",              FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Offset Frequency", "offset_frequency",    IntSlotValue{ 2, 1, 99 });
+		add("Squash",           "squash",              FloatSlotValue{ 0.0f, 0.0f, 1.0f });
+		add("Squash Frequency", "squash_frequency",    IntSlotValue{ 2, 1, 99 });
+		add("Vector",           "vector",              SlotDirection::INPUT, SlotType::VECTOR);
+		add("Color1",           "color1",              ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Color2",           "color2",              ColorSlotValue{ csc::Float3{ 0.4f, 0.4f, 0.4f} });
+		add("Mortar",           "mortar",              ColorSlotValue{ csc::Float3{ 0.4f, 0.4f, 0.4f} });
+		add("Scale",            "scale",               FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX });
+		add("Mortar Size",      "mortar_size",         FloatSlotValue{ 0.08f, 0.0f, 5.0f });
+		add("Mortar Smooth",    "mortar_smooth",       FloatSlotValue{ 0.1f, 0.0f, 10.0f });
+		add("Bias",             "bias",                FloatSlotValue{ 0.0f, -10.0f, 10.0f });
+		add("Brick Width",      "brick_width",         FloatSlotValue{ 0.5f, 0.0f, 10.0f });
+		add("Row Height",       "row_height",          FloatSlotValue{ 0.25f, 0.0f, 10.0f });
 		break;
 	case NodeType::CHECKER_TEX:
-		_slots.push_back(Slot{ "Color",  "color",  SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Fac",    "fac",    SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Vector", "vector", SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Color1", "color1", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} } });
-		_slots.push_back(Slot{ "Color2", "color2", ColorSlotValue{ csc::Float3{ 0.4f, 0.4f, 0.4f} } });
-		_slots.push_back(Slot{ "Scale",  "scale",  FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX } });
+		add("Color",  "color",  SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Fac",    "fac",    SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Vector", "vector", SlotDirection::INPUT, SlotType::VECTOR);
+		add("Color1", "color1", ColorSlotValue{ csc::Float3{ 0.9f, 0.9f, 0.9f} });
+		add("Color2", "color2", ColorSlotValue{ csc::Float3{ 0.4f, 0.4f, 0.4f} });
+		add("Scale",  "scale",  FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX });
 		break;
 	case NodeType::GRADIENT_TEX:
-		_slots.push_back(Slot{ "Color",  "color",         SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Fac",    "fac",           SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Type",   "gradient_type", EnumSlotValue{ GradientTexType::LINEAR } });
-		_slots.push_back(Slot{ "Vector", "vector",        SlotDirection::INPUT, SlotType::VECTOR });
-		_slot_aliases.push_back(std::make_pair("type", "gradient_type"));
+		add("Color",  "color",         SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Fac",    "fac",           SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Type",   "gradient_type", EnumSlotValue{ GradientTexType::LINEAR });
+		add("Vector", "vector",        SlotDirection::INPUT, SlotType::VECTOR);
+		add_alias("type", "gradient_type");
 		break;
 	case NodeType::MAGIC_TEX:
-		_slots.push_back(Slot{ "Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Fac",        "fac",        SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Depth",      "depth",      IntSlotValue{ 2, 0, 10 } });
-		_slots.push_back(Slot{ "Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Scale",      "scale",      FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Distortion", "distortion", FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX } });
+		add("Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Fac",        "fac",        SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Depth",      "depth",      IntSlotValue{ 2, 0, 10 });
+		add("Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR);
+		add("Scale",      "scale",      FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX });
+		add("Distortion", "distortion", FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX });
 		break;
 	case NodeType::MUSGRAVE_TEX:
-		_slots.push_back(Slot{ "Fac",        "fac",           SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Dimensions", "dimensions",    EnumSlotValue{ MusgraveTexDimensions::THREE } });
-		_slots.push_back(Slot{ "Type",       "musgrave_type", EnumSlotValue{ MusgraveTexType::FBM } });
-		_slots.push_back(Slot{ "Vector",     "vector",        SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "W",          "w",             FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Scale",      "scale",         FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Detail",     "detail",        FloatSlotValue{ 2.0f, 0.0f, 16.0f } });
-		_slots.push_back(Slot{ "Dimension",  "dimension",     FloatSlotValue{ 2.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Lacunarity", "lacunarity",    FloatSlotValue{ 2.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Offset",     "offset",        FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Gain",       "gain",          FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
-		_slot_aliases.push_back(std::make_pair("type", "musgrave_type"));
+		add("Fac",        "fac",           SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Dimensions", "dimensions",    EnumSlotValue{ MusgraveTexDimensions::THREE });
+		add("Type",       "musgrave_type", EnumSlotValue{ MusgraveTexType::FBM });
+		add("Vector",     "vector",        SlotDirection::INPUT, SlotType::VECTOR);
+		add("W",          "w",             FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("Scale",      "scale",         FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX });
+		add("Detail",     "detail",        FloatSlotValue{ 2.0f, 0.0f, 16.0f });
+		add("Dimension",  "dimension",     FloatSlotValue{ 2.0f, 0.0f, FLT_MAX });
+		add("Lacunarity", "lacunarity",    FloatSlotValue{ 2.0f, 0.0f, FLT_MAX });
+		add("Offset",     "offset",        FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("Gain",       "gain",          FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
+		add_alias("type", "musgrave_type");
 		break;
 	case NodeType::NOISE_TEX:
-		_slots.push_back(Slot{ "Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Fac",        "fac",        SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Dimensions", "dimensions", EnumSlotValue{ NoiseTexDimensions::THREE } });
-		_slots.push_back(Slot{ "Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "W",          "w",          FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Scale",      "scale",      FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Detail",     "detail",     FloatSlotValue{ 2.0f, 0.0f, 16.0f } });
-		_slots.push_back(Slot{ "Roughness",  "roughness",  FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Distortion", "distortion", FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
+		add("Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Fac",        "fac",        SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Dimensions", "dimensions", EnumSlotValue{ NoiseTexDimensions::THREE });
+		add("Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR);
+		add("W",          "w",          FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("Scale",      "scale",      FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX });
+		add("Detail",     "detail",     FloatSlotValue{ 2.0f, 0.0f, 16.0f });
+		add("Roughness",  "roughness",  FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Distortion", "distortion", FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
 		break;
 	case NodeType::VORONOI_TEX:
-		_slots.push_back(Slot{ "Distance",   "distance",   SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Position",   "position",   SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "W",          "w",          SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Radius",     "radius",     SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Dimensions", "dimensions", EnumSlotValue{ VoronoiTexDimensions::THREE } });
-		_slots.push_back(Slot{ "Feature",    "feature",    EnumSlotValue{ VoronoiTexFeature::F1 } });
-		_slots.push_back(Slot{ "Metric",     "metric",     EnumSlotValue{ VoronoiTexMetric::EUCLIDEAN } });
-		_slots.push_back(Slot{ "Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "W",          "w",          FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Scale",      "scale",      FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Smoothness", "smoothness", FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Exponent",   "exponent",   FloatSlotValue{ 0.5f, 0.0f, 32.0f } });
-		_slots.push_back(Slot{ "Randomness", "randomness", FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
+		add("Distance",   "distance",   SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Position",   "position",   SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("W",          "w",          SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Radius",     "radius",     SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Dimensions", "dimensions", EnumSlotValue{ VoronoiTexDimensions::THREE });
+		add("Feature",    "feature",    EnumSlotValue{ VoronoiTexFeature::F1 });
+		add("Metric",     "metric",     EnumSlotValue{ VoronoiTexMetric::EUCLIDEAN });
+		add("Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR);
+		add("W",          "w",          FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("Scale",      "scale",      FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX });
+		add("Smoothness", "smoothness", FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Exponent",   "exponent",   FloatSlotValue{ 0.5f, 0.0f, 32.0f });
+		add("Randomness", "randomness", FloatSlotValue{ 1.0f, 0.0f, 1.0f });
 		break;
 	case NodeType::WAVE_TEX:
-		_slots.push_back(Slot{ "Color",            "color",            SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Fac",              "fac",              SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Type",             "wave_type",        EnumSlotValue{ WaveTexType::BANDS } });
-		_slots.push_back(Slot{ "Direction",        "direction",        EnumSlotValue{ WaveTexDirection::X } });
-		_slots.push_back(Slot{ "Profile",          "profile",          EnumSlotValue{ WaveTexProfile::SINE } });
-		_slots.push_back(Slot{ "Vector",           "vector",           SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Scale",            "scale",            FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Distortion",       "distortion",       FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Detail",           "detail",           FloatSlotValue{ 2.0f, 0.0f, 16.0f } });
-		_slots.push_back(Slot{ "Detail Scale",     "detail_scale",     FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX } });
-		_slots.push_back(Slot{ "Detail Roughness", "detail_roughness", FloatSlotValue{ 0.5f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Phase Offset",     "phase",            FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
-		_slot_aliases.push_back(std::make_pair("type", "wave_type"));
+		add("Color",            "color",            SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Fac",              "fac",              SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Type",             "wave_type",        EnumSlotValue{ WaveTexType::BANDS });
+		add("Direction",        "direction",        EnumSlotValue{ WaveTexDirection::X });
+		add("Profile",          "profile",          EnumSlotValue{ WaveTexProfile::SINE });
+		add("Vector",           "vector",           SlotDirection::INPUT, SlotType::VECTOR);
+		add("Scale",            "scale",            FloatSlotValue{ 5.0f, -FLT_MAX, FLT_MAX });
+		add("Distortion",       "distortion",       FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add("Detail",           "detail",           FloatSlotValue{ 2.0f, 0.0f, 16.0f });
+		add("Detail Scale",     "detail_scale",     FloatSlotValue{ 1.0f, -FLT_MAX, FLT_MAX });
+		add("Detail Roughness", "detail_roughness", FloatSlotValue{ 0.5f, 0.0f, 1.0f });
+		add("Phase Offset",     "phase",            FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
+		add_alias("type", "wave_type");
 		break;
 	case NodeType::WHITE_NOISE_TEX:
-		_slots.push_back(Slot{ "Value",      "value",      SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Dimensions", "dimensions", EnumSlotValue{ WhiteNoiseTexDimensions::THREE } });
-		_slots.push_back(Slot{ "Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "W",          "w",          FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX } });
+		add("Value",      "value",      SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Color",      "color",      SlotDirection::OUTPUT, SlotType::COLOR);
+		add("Dimensions", "dimensions", EnumSlotValue{ WhiteNoiseTexDimensions::THREE });
+		add("Vector",     "vector",     SlotDirection::INPUT, SlotType::VECTOR);
+		add("W",          "w",          FloatSlotValue{ 0.0f, -FLT_MAX, FLT_MAX });
 		break;
 		//////
 		// Vector
 		//////
 	case NodeType::BUMP:
-		_slots.push_back(Slot{ "Normal",   "normal",   SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Invert",   "invert",   BoolSlotValue{ false } });
-		_slots.push_back(Slot{ "Strength", "strength", FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Distance", "distance", FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Height",   "height",   SlotDirection::INPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Normal",   "normal",   SlotDirection::INPUT, SlotType::VECTOR });
+		add("Normal",   "normal",   SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Invert",   "invert",   BoolSlotValue{ false });
+		add("Strength", "strength", FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Distance", "distance", FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
+		add("Height",   "height",   SlotDirection::INPUT, SlotType::FLOAT);
+		add("Normal",   "normal",   SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::DISPLACEMENT:
-		_slots.push_back(Slot{ "Displacement", "displacement", SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Space",        "space",        EnumSlotValue{ DisplacementSpace::OBJECT } });
-		_slots.push_back(Slot{ "Height",       "height",       FloatSlotValue{ 0.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Midlevel",     "midlevel",     FloatSlotValue{ 0.5f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Scale",        "scale",        FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR });
+		add("Displacement", "displacement", SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Space",        "space",        EnumSlotValue{ DisplacementSpace::OBJECT });
+		add("Height",       "height",       FloatSlotValue{ 0.0f, 0.0f, FLT_MAX });
+		add("Midlevel",     "midlevel",     FloatSlotValue{ 0.5f, 0.0f, FLT_MAX });
+		add("Scale",        "scale",        FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
+		add("Normal",       "normal",       SlotDirection::INPUT, SlotType::VECTOR);
 		break;
 	case NodeType::MAPPING:
-		_slots.push_back(Slot{ "Vector",   "vector",       SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Type",     "mapping_type", EnumSlotValue{ VectorMappingType::POINT } });
-		_slots.push_back(Slot{ "Vector",   "vector",       VectorSlotValue{
+		add("Vector",   "vector",       SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Type",     "mapping_type", EnumSlotValue{ VectorMappingType::POINT });
+		add("Vector",   "vector",       VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Location", "location",     VectorSlotValue{
+		});
+		add("Location", "location",     VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Rotation", "rotation",     VectorSlotValue{
+		});
+		add("Rotation", "rotation",     VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slots.push_back(Slot{ "Scale", "scale",           VectorSlotValue{
+		});
+		add("Scale", "scale",           VectorSlotValue{
 			csc::Float3{ 1.0f, 1.0f, 1.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slot_aliases.push_back(std::make_pair("type", "mapping_type"));
+		});
+		add_alias("type", "mapping_type");
 		break;
 	case NodeType::NORMAL:
-		_slots.push_back(Slot{ "Normal",    "normal",    SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Dot",       "dot",       SlotDirection::OUTPUT, SlotType::FLOAT });
-		_slots.push_back(Slot{ "Direction", "direction", VectorSlotValue{
+		add("Normal",    "normal",    SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Dot",       "dot",       SlotDirection::OUTPUT, SlotType::FLOAT);
+		add("Direction", "direction", VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f },  csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		}, false });
-		_slots.push_back(Slot{ "Normal",    "normal",    VectorSlotValue{
+		}, false);
+		add("Normal",    "normal",    VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
+		});
 		break;
 	case NodeType::NORMAL_MAP:
-		_slots.push_back(Slot{ "Normal",   "normal",   SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Space",    "space",    EnumSlotValue{ NormalMapSpace::TANGENT } });
-		_slots.push_back(Slot{ "Strength", "strength", FloatSlotValue{ 1.0f, 0.0f, 10.0f } });
-		_slots.push_back(Slot{ "Color",    "color",    ColorSlotValue{ csc::Float3{ 0.5f, 0.5f, 1.0f} } });
+		add("Normal",   "normal",   SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Space",    "space",    EnumSlotValue{ NormalMapSpace::TANGENT });
+		add("Strength", "strength", FloatSlotValue{ 1.0f, 0.0f, 10.0f });
+		add("Color",    "color",    ColorSlotValue{ csc::Float3{ 0.5f, 0.5f, 1.0f} });
 		break;
 	case NodeType::VECTOR_CURVES:
-		_slots.push_back(Slot{ "Vector", "vector", SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Curves", "curves", VectorCurveSlotValue{ csc::Float2{ -1.0f, -1.0f }, csc::Float2{ 1.0f, 1.0f} } });
-		_slots.push_back(Slot{ "Fac",    "fac",    FloatSlotValue{ 1.0f, 0.0f, 1.0f } });
-		_slots.push_back(Slot{ "Vector", "vector", VectorSlotValue{
+		add("Vector", "vector", SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Curves", "curves", VectorCurveSlotValue{ csc::Float2{ -1.0f, -1.0f }, csc::Float2{ 1.0f, 1.0f} });
+		add("Fac",    "fac",    FloatSlotValue{ 1.0f, 0.0f, 1.0f });
+		add("Vector", "vector", VectorSlotValue{
 			csc::Float3{ 0.0f, 0.0f, 0.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
+		});
 		break;
 	case NodeType::VECTOR_DISPLACEMENT:
-		_slots.push_back(Slot{ "Displacement", "displacement", SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Space",        "space",        EnumSlotValue{ VectorDisplacementSpace::TANGENT } });
-		_slots.push_back(Slot{ "Vector",       "vector",       SlotDirection::INPUT, SlotType::COLOR });
-		_slots.push_back(Slot{ "Midlevel",     "midlevel",     FloatSlotValue{ 0.0f, 0.0f, FLT_MAX } });
-		_slots.push_back(Slot{ "Scale",        "scale",        FloatSlotValue{ 1.0f, 0.0f, FLT_MAX } });
+		add("Displacement", "displacement", SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Space",        "space",        EnumSlotValue{ VectorDisplacementSpace::TANGENT });
+		add("Vector",       "vector",       SlotDirection::INPUT, SlotType::COLOR);
+		add("Midlevel",     "midlevel",     FloatSlotValue{ 0.0f, 0.0f, FLT_MAX });
+		add("Scale",        "scale",        FloatSlotValue{ 1.0f, 0.0f, FLT_MAX });
 		break;
 	case NodeType::VECTOR_TRANSFORM:
-		_slots.push_back(Slot{ "Vector",       "vector",         SlotDirection::OUTPUT, SlotType::VECTOR });
-		_slots.push_back(Slot{ "Type",         "transform_type", EnumSlotValue{ VectorTransformType::VECTOR } });
-		_slots.push_back(Slot{ "Convert From", "convert_from",   EnumSlotValue{ VectorTransformSpace::WORLD } });
-		_slots.push_back(Slot{ "Convert To",   "convert_to",     EnumSlotValue{ VectorTransformSpace::OBJECT } });
-		_slots.push_back(Slot{ "Vector",       "vector",         VectorSlotValue{
+		add("Vector",       "vector",         SlotDirection::OUTPUT, SlotType::VECTOR);
+		add("Type",         "transform_type", EnumSlotValue{ VectorTransformType::VECTOR });
+		add("Convert From", "convert_from",   EnumSlotValue{ VectorTransformSpace::WORLD });
+		add("Convert To",   "convert_to",     EnumSlotValue{ VectorTransformSpace::OBJECT });
+		add("Vector",       "vector",         VectorSlotValue{
 			csc::Float3{ 1.0f, 1.0f, 1.0f }, csc::Float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } , csc::Float3{ FLT_MAX, FLT_MAX, FLT_MAX }
-		} });
-		_slot_aliases.push_back(std::make_pair("type", "transform_type"));
+		});
+		add_alias("type", "transform_type");
 		break;
 	default:
 		// Uncomment the below assert once all node types have been implemented
 		assert(false);
 	}
-	roll_id();
+
+	build_name_tables();
 }
 
-csg::Node::Node(const NodeType type, const csc::Int2 position, const NodeId id) :
-	Node(type, position)
+void csg::Node::Schema::add(const char* const disp_name, const char* const name, const SlotDirection dir, const SlotType type, const bool has_pin)
 {
-	_id = id;
+	slots.push_back(Slot{ disp_name, name, dir, type, has_pin });
+	value_indices.push_back(NO_VALUE);
 }
 
-boost::optional<size_t> csg::Node::slot_index(const SlotDirection dir, const boost::string_view& slot_name) const
+void csg::Node::Schema::add_value(const char* const disp_name, const char* const name, const SlotValue& value, const bool has_pin)
 {
-	for (size_t i = 0; i < _slots.size(); i++)
-	{
-		if (_slots[i].dir() == dir && _slots[i].name() == slot_name) {
-			return i;
+	slots.push_back(Slot{ disp_name, name, SlotDirection::INPUT, value.type(), has_pin });
+	value_indices.push_back(default_values.size());
+	default_values.push_back(value);
+}
+
+void csg::Node::Schema::build_name_tables()
+{
+	std::vector<std::pair<boost::string_view, size_t>> input_name_list;
+	std::vector<std::pair<boost::string_view, size_t>> output_name_list;
+	std::vector<std::pair<boost::string_view, size_t>> input_disp_name_list;
+	std::vector<std::pair<boost::string_view, size_t>> output_disp_name_list;
+	for (size_t i = 0; i < slots.size(); i++) {
+		if (slots[i].dir() == SlotDirection::INPUT) {
+			input_name_list.push_back(std::make_pair(boost::string_view{ slots[i].name() }, i));
+			input_disp_name_list.push_back(std::make_pair(boost::string_view{ slots[i].disp_name() }, i));
+		}
+		else {
+			output_name_list.push_back(std::make_pair(boost::string_view{ slots[i].name() }, i));
+			output_disp_name_list.push_back(std::make_pair(boost::string_view{ slots[i].disp_name() }, i));
 		}
 	}
-	for (const auto this_pair : _slot_aliases) {
-		if (slot_name == this_pair.first) {
-			return slot_index(dir, this_pair.second);
+
+	// Aliases go after every real name so a real name always wins
+	const csc::StringTable<size_t> real_input_names{ input_name_list };
+	const csc::StringTable<size_t> real_output_names{ output_name_list };
+	for (const auto& this_alias : aliases) {
+		const size_t* const input_index{ real_input_names.find(this_alias.second) };
+		if (input_index != nullptr) {
+			input_name_list.push_back(std::make_pair(boost::string_view{ this_alias.first }, *input_index));
+		}
+		const size_t* const output_index{ real_output_names.find(this_alias.second) };
+		if (output_index != nullptr) {
+			output_name_list.push_back(std::make_pair(boost::string_view{ this_alias.first }, *output_index));
 		}
 	}
+
+	input_names = csc::StringTable<size_t>{ input_name_list };
+	output_names = csc::StringTable<size_t>{ output_name_list };
+	input_disp_names = csc::StringTable<size_t>{ input_disp_name_list };
+	output_disp_names = csc::StringTable<size_t>{ output_disp_name_list };
+}
+
+const csg::Node::Schema& csg::Node::schema_for(const NodeType type)
+{
+	constexpr size_t TYPE_COUNT{ static_cast<size_t>(NodeType::COUNT) };
+	static std::array<std::once_flag, TYPE_COUNT> schemas_built;
+	static std::array<std::unique_ptr<const Schema>, TYPE_COUNT> schemas;
+
+	const size_t type_index{ static_cast<size_t>(type) };
+	assert(type_index < TYPE_COUNT);
+
+	std::call_once(schemas_built[type_index], [type, type_index]() {
+		schemas[type_index] = std::make_unique<const Schema>(type);
+	});
+
+	return *schemas[type_index];
+}
+
+const std::vector<csg::Slot>& csg::Node::slots_of(const NodeType type)
+{
+	return schema_for(type).slots;
+}
+
+const csg::SlotValue* csg::Node::default_value_of(const NodeType type, const size_t index)
+{
+	const Schema& schema{ schema_for(type) };
+	if (index >= schema.slots.size() || schema.value_indices[index] == Schema::NO_VALUE) {
+		return nullptr;
+	}
+	return &schema.default_values[schema.value_indices[index]];
+}
+
+const std::vector<csg::Slot>& csg::Node::slots() const
+{
+	return _schema->slots;
+}
+
+boost::optional<size_t> csg::Node::slot_index(const SlotDirection dir, const boost::string_view& slot_name) const
+{
+	const size_t* const index{ (dir == SlotDirection::INPUT ? _schema->input_names : _schema->output_names).find(slot_name) };
+	if (index != nullptr) {
+		assert(*index < slot_count());
+		return *index;
+	}
+	return boost::none;
+}
+
+boost::optional<size_t> csg::Node::slot_index_by_disp_name(const SlotDirection dir, const boost::string_view& disp_name) const
+{
+	const size_t* const index{ (dir == SlotDirection::INPUT ? _schema->input_disp_names : _schema->output_disp_names).find(disp_name) };
+	if (index != nullptr) {
+		assert(*index < slot_count());
+		return *index;
+	}
 	return boost::none;
 }
 
 boost::optional<csg::Slot> csg::Node::slot(const size_t index) const
 {
-	if (index >= _slots.size()) {
+	if (index >= slot_count()) {
 		return boost::none;
 	}
-	return _slots.at(index);
+	return _schema->slots[index];
 }
 
 boost::optional<csg::Slot> csg::Node::slot(const SlotDirection dir, const boost::string_view& slot_name) const
@@ -694,9 +908,9 @@ boost::optional<csg::Slot> csg::Node::slot(const SlotDirection dir, const boost:
 
 boost::optional<csg::SlotValue> csg::Node::slot_value(const size_t index) const
 {
-	const boost::optional<csg::Slot> the_slot{ slot(index) };
-	if (the_slot) {
-		return the_slot->value;
+	const SlotValue* const value{ slot_value_ptr(index) };
+	if (value != nullptr) {
+		return *value;
 	}
 	else {
 		return boost::none;
@@ -714,11 +928,109 @@ boost::optional <csg::SlotValue> csg::Node::slot_value(const boost::string_view&
 	}
 }
 
+const csg::SlotValue* csg::Node::slot_value_ptr(const size_t index) const
+{
+	const SlotValue* const value{ slot_value_ptr_without_decoding(index) };
+	const UndecodedValue* const undecoded{ find_undecoded(index) };
+	return (undecoded == nullptr) ? value : &undecoded->get(*value);
+}
+
+const csg::SlotValue* csg::Node::slot_value_ptr(const boost::string_view& slot_name) const
+{
+	const boost::optional<size_t> opt_index{ slot_index(csg::SlotDirection::INPUT, slot_name) };
+	return opt_index ? slot_value_ptr(*opt_index) : nullptr;
+}
+
+const csg::SlotValue* csg::Node::slot_value_ptr_without_decoding(const size_t index) const
+{
+	if (index >= slot_count() || _schema->value_indices[index] == Schema::NO_VALUE) {
+		return nullptr;
+	}
+	return &values()[_schema->value_indices[index]];
+}
+
+csg::SlotValue* csg::Node::mutable_slot_value(const size_t index)
+{
+	set_serialized_values(nullptr);
+	if (index >= slot_count() || _schema->value_indices[index] == Schema::NO_VALUE) {
+		return nullptr;
+	}
+	SlotValue& value{ own_values()[_schema->value_indices[index]] };
+	// The decoded value moves into this node, the shared one may still be read through other copies
+	for (auto iter{ _undecoded_values.begin() }; iter != _undecoded_values.end(); ++iter) {
+		if (iter->first == index) {
+			value = iter->second->get(value);
+			_undecoded_values.erase(iter);
+			break;
+		}
+	}
+	return &value;
+}
+
 void csg::Node::copy_from(const Node& other)
 {
 	// Copy everything except id
 	_type = other._type;
-	_slots = other._slots;
+	_schema = other._schema;
+	_values = other._values;
+	_undecoded_values = other._undecoded_values;
+	// The cached values do not include id or position, so they are still correct for the new slots
+	set_serialized_values(other.serialized_values());
+}
+
+void csg::Node::set_undecoded_value(const size_t index, const boost::string_view text, const size_t max_curve_points)
+{
+	assert(slot_value_ptr_without_decoding(index) != nullptr);
+	set_serialized_values(nullptr);
+	const std::shared_ptr<const UndecodedValue> undecoded{ std::make_shared<const UndecodedValue>(text, max_curve_points) };
+	for (auto& this_pair : _undecoded_values) {
+		if (this_pair.first == index) {
+			this_pair.second = undecoded;
+			return;
+		}
+	}
+	_undecoded_values.push_back(std::make_pair(index, undecoded));
+}
+
+boost::optional<boost::string_view> csg::Node::undecoded_value(const size_t index) const
+{
+	const UndecodedValue* const undecoded{ find_undecoded(index) };
+	return (undecoded == nullptr) ? boost::none : boost::optional<boost::string_view>{ undecoded->text };
+}
+
+const csg::Node::UndecodedValue* csg::Node::find_undecoded(const size_t index) const
+{
+	for (const auto& this_pair : _undecoded_values) {
+		if (this_pair.first == index) {
+			return this_pair.second.get();
+		}
+	}
+	return nullptr;
+}
+
+const std::vector<csg::SlotValue>& csg::Node::values() const
+{
+	return _values.empty() ? _schema->default_values : _values;
+}
+
+std::vector<csg::SlotValue>& csg::Node::own_values()
+{
+	// Every schema with values has at least one, so a node that owns its values never goes back to sharing
+	if (_values.empty()) {
+		_values = _schema->default_values;
+	}
+	return _values;
+}
+
+size_t csg::Node::memory_usage() const
+{
+	size_t result{ sizeof(Node) };
+	result += _values.capacity() * sizeof(SlotValue);
+	result += _undecoded_values.capacity() * sizeof(_undecoded_values[0]);
+	for (const auto& this_pair : _undecoded_values) {
+		result += this_pair.second->text.capacity();
+	}
+	return result;
 }
 
 bool csg::Node::operator==(const Node& other) const
@@ -735,12 +1047,18 @@ bool csg::Node::operator==(const Node& other) const
 		return false;
 	}
 
-	if (_slots.size() != other._slots.size()) {
-		return false;
-	}
-
-	for (size_t i = 0; i < _slots.size(); i++) {
-		if (_slots[i] != other._slots[i]) {
+	// Nodes of the same type share a schema, so each value is at the same index in both
+	for (size_t i = 0; i < slot_count(); i++) {
+		if (_schema->value_indices[i] == Schema::NO_VALUE) {
+			continue;
+		}
+		// Identical undecoded text always decodes to the same value, this keeps copies of a loaded graph undecoded
+		const boost::optional<boost::string_view> undecoded{ undecoded_value(i) };
+		const boost::optional<boost::string_view> other_undecoded{ other.undecoded_value(i) };
+		if (undecoded && other_undecoded && *undecoded == *other_undecoded) {
+			continue;
+		}
+		if (*slot_value_ptr(i) != *other.slot_value_ptr(i)) {
 			return false;
 		}
 	}
@@ -748,12 +1066,28 @@ bool csg::Node::operator==(const Node& other) const
 	return true;
 }
 
+void csg::Node::seed_ids(const uint64_t seed)
+{
+	node_id_seed.store(seed, std::memory_order_relaxed);
+	node_id_next_stream.store(0, std::memory_order_relaxed);
+	node_id_seed_version.fetch_add(1, std::memory_order_release);
+}
+
 csg::NodeId csg::Node::roll_id()
 {
-	static_assert(sizeof(uint32_t) * 2 == sizeof(NodeId), "NodeId should be twice the size of uint32_t");
-	uint32_t* const id_ptr{ reinterpret_cast<uint32_t*>(&_id) };
-	std::lock_guard<std::mutex> lock{ node_id_rng_mutex };
-	id_ptr[0] = node_id_rng();
-	id_ptr[1] = node_id_rng();
-	return _id;
+	static_assert(sizeof(uint64_t) == sizeof(NodeId), "NodeId should be the size of uint64_t");
+
+	// Only a read of the shared version here, the counters below are touched once per thread and seed
+	NodeIdGenerator& generator{ node_id_generator };
+	const uint64_t seed_version{ node_id_seed_version.load(std::memory_order_acquire) };
+	if (generator.started == false || generator.seed_version != seed_version) {
+		const uint64_t seed{ seed_version == 0 ? random_node_id_seed() : node_id_seed.load(std::memory_order_relaxed) };
+		const uint64_t stream{ node_id_next_stream.fetch_add(1, std::memory_order_relaxed) };
+		generator.state = csc::combine_hash(seed, stream);
+		generator.seed_version = seed_version;
+		generator.started = true;
+	}
+
+	generator.state += 0x9e3779b97f4a7c15ull;
+	return static_cast<NodeId>(csc::mix_hash(generator.state));
 }
@@ -6,6 +6,7 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -27,45 +28,113 @@ namespace csg {
 	 */
 	class Node {
 	public:
+		// Ids are drawn from a generator owned by the calling thread, so nodes can be made on many threads at once
+		// They are random and only almost certainly unique, Graph::add rejects a node whose id is already used
 		Node(NodeType type, csc::Int2 position);
 		Node(NodeType type, csc::Int2 position, NodeId id);
 
+		// Makes every thread restart its ids from seed, so a run that makes nodes in the same order gets the same ids
+		// Threads are given their own stream in the order they next make a node, so only single threaded runs repeat exactly
+		static void seed_ids(uint64_t seed);
+
+		// Copies read the serialized values cache atomically, it can be filled in by another thread while the node is shared
+		Node(const Node& other);
+		Node(Node&& other) = default;
+		Node& operator=(const Node& other);
+		Node& operator=(Node&& other) = default;
+
 		NodeId id() const { return _id; }
 		NodeType type() const { return _type; }
-		const std::vector<Slot>& slots() const { return _slots; }
-		
+		// Slots of a node type and their default values, read without building a node
+		static const std::vector<Slot>& slots_of(NodeType type);
+		// Returns nullptr for slots that do not hold a value
+		static const SlotValue* default_value_of(NodeType type, size_t index);
+
+		// Slots of this node's type, shared by every node of the type
+		const std::vector<Slot>& slots() const;
+		size_t slot_count() const { return slots().size(); }
+
 		boost::optional<size_t> slot_index(SlotDirection dir, const boost::string_view& slot_name) const;
+		boost::optional<size_t> slot_index_by_disp_name(SlotDirection dir, const boost::string_view& disp_name) const;
 		boost::optional<Slot> slot(size_t index) const;
 		boost::optional<Slot> slot(SlotDirection dir, const boost::string_view& slot_name) const;
 		boost::optional<SlotValue> slot_value(size_t index) const;
 		boost::optional<SlotValue> slot_value(const boost::string_view& slot_name) const;
-		Slot& slot_ref(size_t index) { return _slots[index]; }
+		// Returns nullptr if the slot has no value, the pointer is only valid until the node is next changed
+		const SlotValue* slot_value_ptr(size_t index) const;
+		const SlotValue* slot_value_ptr(const boost::string_view& slot_name) const;
+		// Value as stored, a slot with an undecoded_value() still holds its default value
+		const SlotValue* slot_value_ptr_without_decoding(size_t index) const;
+		// Any mutable access to a slot value discards the serialized values below
+		SlotValue* mutable_slot_value(size_t index);
+
+		// Typed versions of the above, nullptr if the slot has no value or holds a different type
+		template <typename T> const T* slot_value_ptr(const size_t index) const
+		{
+			const SlotValue* const value{ slot_value_ptr(index) };
+			return (value == nullptr) ? nullptr : value->as_ptr<T>();
+		}
 
-		template <typename T> boost::optional<T> slot_value_as(size_t index) const
+		template <typename T> const T* slot_value_ptr(const boost::string_view& slot_name) const
 		{
-			const boost::optional<SlotValue> opt_value{ slot_value(index) };
-			if (opt_value) {
-				return opt_value->as<T>();
-			}
-			else {
-				return boost::none;
-			}
+			const SlotValue* const value{ slot_value_ptr(slot_name) };
+			return (value == nullptr) ? nullptr : value->as_ptr<T>();
+		}
+
+		template <typename T> T* mutable_slot_value_ptr(const size_t index)
+		{
+			SlotValue* const value{ mutable_slot_value(index) };
+			return (value == nullptr) ? nullptr : value->as_ptr<T>();
 		}
 
-		template <typename T> boost::optional<T> slot_value_as(const std::string& slot_name) const
+		// Calls TSlot::set on a copy of the value and stores it, returns true only if the value changed
+		// Nothing is touched when the value stays the same, so the serialized values are kept
+		template <typename TSlot, typename TRaw> bool set_slot_value(const size_t index, const TRaw& new_value)
 		{
-			const boost::optional<SlotValue> opt_value{ slot_value(slot_name) };
-			if (opt_value) {
-				return opt_value->as<T>();
+			const TSlot* const old_value{ slot_value_ptr<TSlot>(index) };
+			if (old_value == nullptr) {
+				return false;
 			}
-			else {
-				return boost::none;
+			TSlot maybe_new_value{ *old_value };
+			maybe_new_value.set(new_value);
+			if (maybe_new_value == *old_value) {
+				return false;
 			}
+			*mutable_slot_value_ptr<TSlot>(index) = std::move(maybe_new_value);
+			return true;
+		}
+
+		template <typename T> boost::optional<T> slot_value_as(const size_t index) const
+		{
+			const T* const value{ slot_value_ptr<T>(index) };
+			return (value == nullptr) ? boost::none : boost::optional<T>{ *value };
+		}
+
+		template <typename T> boost::optional<T> slot_value_as(const boost::string_view& slot_name) const
+		{
+			const T* const value{ slot_value_ptr<T>(slot_name) };
+			return (value == nullptr) ? boost::none : boost::optional<T>{ *value };
 		}
 
 		void copy_from(const Node& other);
 
-		bool has_pin(size_t index, SlotDirection direction) const { return index < _slots.size() && _slots[index].dir() == direction; }
+		// Slot values as written by the text serializer, cached between saves
+		// Position is not part of this so moving a node keeps the cache valid
+		// Graphs share nodes between copies, so a save on another thread may fill this in at any time
+		std::shared_ptr<const std::string> serialized_values() const { return std::atomic_load(&_serialized_values); }
+		void set_serialized_values(const std::shared_ptr<const std::string>& values) const { std::atomic_store(&_serialized_values, values); }
+
+		// Serialized text of a slot value that is only decoded once the slot is first accessed
+		// Copies of the node share the text and the decoded value, decoding happens once and is safe from any thread
+		// max_curve_points is the limit the text was loaded with, decoding applies it as loading would have
+		void set_undecoded_value(size_t index, boost::string_view text, size_t max_curve_points);
+		// The text is kept after it is decoded, until the value is changed
+		boost::optional<boost::string_view> undecoded_value(size_t index) const;
+
+		bool has_pin(size_t index, SlotDirection direction) const { return index < slot_count() && slots()[index].dir() == direction; }
+
+		// Bytes used by this node and the arrays it owns, slots and default values shared with other nodes of the type are not counted
+		size_t memory_usage() const;
 
 		bool operator==(const Node& other) const;
 		bool operator!=(const Node& other) const { return operator==(other) == false; }
@@ -73,11 +142,26 @@ namespace csg {
 		csc::Int2 position;
 
 	private:
-		NodeId roll_id();
+		struct Schema;
+		// Built the first time a node of the type is made and shared by every node of that type
+		static const Schema& schema_for(NodeType type);
+
+		struct UndecodedValue;
+
+		static NodeId roll_id();
+		const UndecodedValue* find_undecoded(size_t index) const;
+		// The schema's default values are shared until this node first changes a value
+		const std::vector<SlotValue>& values() const;
+		std::vector<SlotValue>& own_values();
 
 		NodeId _id;
 		NodeType _type;
-		std::vector<Slot> _slots;
-		std::vector<std::pair<const char*, const char*>> _slot_aliases;
+		const Schema* _schema;
+		// One value for each slot of the schema that has a value, in slot order, empty while every value is the default
+		// Values with an undecoded value keep the default here, the decoded value is held by the UndecodedValue
+		std::vector<SlotValue> _values;
+		std::vector<std::pair<size_t, std::shared_ptr<const UndecodedValue>>> _undecoded_values;
+
+		mutable std::shared_ptr<const std::string> _serialized_values;
 	};
 }
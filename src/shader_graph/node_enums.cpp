@@ -1,108 +1,414 @@
 #include "node_enums.h"
 
+#include <cassert>
 #include <utility>
+#include <vector>
 
 #include <boost/optional.hpp>
 
-template <typename T> static boost::optional<T> as_enum(const size_t option)
-{
-	if (option >= static_cast<size_t>(T::COUNT)) {
-		return boost::none;
-	}
-	return static_cast<T>(option);
-}
+#include "shader_core/string_table.h"
 
-template <typename T> static size_t get_count()
-{
-	return static_cast<size_t>(T::COUNT);
-}
+// Names of one enum option
+struct OptionNames {
+	const char* disp_name;
+	const char* internal_name;
+	// Another name the option is found by when loading, such as the name used by older versions
+	const char* alt_name{ nullptr };
+};
 
-boost::optional<csg::NodeEnumInfo> csg::NodeEnumInfo::from(const NodeMetaEnum meta_enum)
+// Names of every option of each enum, in the same order as the enum
+
+//////
+// Color
+//////
+constexpr OptionNames MIX_RGB_TYPE_NAMES[]{
+	{ "Mix",          "mix" },
+	{ "Darken",       "darken" },
+	{ "Multiply",     "multiply" },
+	{ "Burn",         "burn" },
+	{ "Lighten",      "lighten" },
+	{ "Screen",       "screen" },
+	{ "Dodge",        "dodge" },
+	{ "Add",          "add" },
+	{ "Overlay",      "overlay" },
+	{ "Soft Light",   "soft_light" },
+	{ "Linear Light", "linear_light" },
+	{ "Difference",   "difference" },
+	{ "Subtract",     "subtract" },
+	{ "Divide",       "divide" },
+	{ "Hue",          "hue" },
+	{ "Saturation",   "saturation" },
+	{ "Color",        "color" },
+	{ "Value",        "value" },
+};
+
+//////
+// Converter
+//////
+constexpr OptionNames CLAMP_TYPE_NAMES[]{
+	{ "Min Max", "minmax" },
+	{ "Range",   "range" },
+};
+
+constexpr OptionNames MAP_RANGE_TYPE_NAMES[]{
+	{ "Linear",        "linear" },
+	{ "Stepped",       "stepped" },
+	{ "Smooth Step",   "smoothstep" },
+	{ "Smoother Step", "smootherstep" },
+};
+
+constexpr OptionNames MATH_TYPE_NAMES[]{
+	{ "Add (2)",                "add" },
+	{ "Subtract (2)",           "subtract" },
+	{ "Multiply (2)",           "multiply" },
+	{ "Divide (2)",             "divide" },
+	{ "Multiply Add (2)",       "multiply_add" },
+	{ "Sine (1)",               "sine" },
+	{ "Cosine (1)",             "cosine" },
+	{ "Tangent (1)",            "tangent" },
+	{ "Arcsine (1)",            "arcsine" },
+	{ "Arccosine (1)",          "arccosine" },
+	{ "Arctangent (1)",         "arctangent" },
+	{ "Arctan2 (2)",            "arctan2" },
+	{ "Hyperbolic Sine (1)",    "sinh" },
+	{ "Hyperbolic Cosine (1)",  "cosh" },
+	{ "Hyperbolic Tangent (1)", "tanh" },
+	{ "Power (2)",              "power" },
+	{ "Logarithm (2)",          "logarithm" },
+	{ "Maximum (2)",            "maximum" },
+	{ "Minimum (2)",            "minimum" },
+	{ "Less Than (2)",          "less_than" },
+	{ "Greater Than (2)",       "greater_than" },
+	{ "Modulo (2)",             "modulo" },
+	{ "Absolute (1)",           "absolute" },
+	{ "Round (1)",              "round" },
+	{ "Floor (1)",              "floor" },
+	{ "Ceil (1)",               "ceil" },
+	{ "Fraction (1)",           "fraction" },
+	{ "Square Root (1)",        "sqrt" },
+	{ "Inverse Sqrt (1)",       "inverse_sqrt" },
+	{ "Sign (1)",               "sign" },
+	{ "Exponent (1)",           "exponent" },
+	{ "To Radians (1)",         "radians" },
+	{ "To Degrees (1)",         "degrees" },
+	{ "Truncate (1)",           "truncate" },
+	{ "Snap (2)",               "snap" },
+	{ "Wrap (3)",               "wrap" },
+	{ "Compare (3)",            "compare" },
+	{ "Ping Pong (3)",          "pingpong" },
+	{ "Smooth Min (3)",         "smooth_min" },
+	{ "Smooth Max (3)",         "smooth_max" },
+};
+
+constexpr OptionNames VECTOR_MATH_TYPE_NAMES[]{
+	{ "Add (2)",           "add" },
+	{ "Subtract (2)",      "subtract" },
+	{ "Multiply (2)",      "multiply" },
+	{ "Divide (2)",        "divide" },
+	{ "Cross Product (2)", "cross_product" },
+	{ "Project (2)",       "project" },
+	{ "Reflect (2)",       "reflect" },
+	{ "Dot Product (2)",   "dot_product" },
+	{ "Distance (2)",      "distance" },
+	{ "Length (1)",        "length" },
+	{ "Scale (1)",         "scale" },
+	{ "Normalize (1)",     "normalize" },
+	{ "Snap (2)",          "snap" },
+	{ "Floor (1)",         "floor" },
+	{ "Ceil (1)",          "ceil" },
+	{ "Modulo (2)",        "modulo" },
+	{ "Fraction (1)",      "fraction" },
+	{ "Absolute (1)",      "absolute" },
+	{ "Minimum (2)",       "minimum" },
+	{ "Maximum (2)",       "maximum" },
+	{ "Wrap (3)",          "wrap" },
+	{ "Sine (1)",          "sine" },
+	{ "Cosine (1)",        "cosine" },
+	{ "Tangent (1)",       "tangent" },
+};
+
+//////
+// Input
+//////
+constexpr OptionNames TANGENT_DIRECTION_NAMES[]{
+	{ "Radial", "radial" },
+	{ "UV Map", "uv_map" },
+};
+
+constexpr OptionNames TANGENT_AXIS_NAMES[]{
+	{ "X", "x" },
+	{ "Y", "y" },
+	{ "Z", "z" },
+};
+
+//////
+// Shader
+//////
+constexpr OptionNames ANISOTROPIC_DISTRIBUTION_NAMES[]{
+	{ "Ashikhmin-Shirley", "ashikhmin_shirley" },
+	{ "Beckmann",          "beckmann" },
+	{ "GGX",               "ggx" },
+	{ "Multiscatter GGX",  "multi_ggx",         "multiscatter_ggx" },
+};
+
+constexpr OptionNames GLASS_DISTRIBUTION_NAMES[]{
+	{ "Beckmann",         "beckmann" },
+	{ "GGX",              "ggx" },
+	{ "Multiscatter GGX", "multi_ggx", "multiscatter_ggx" },
+	{ "Sharp",            "sharp" },
+};
+
+constexpr OptionNames GLOSSY_DISTRIBUTION_NAMES[]{
+	{ "Ashikhmin-Shirley", "ashikhmin_shirley" },
+	{ "Beckmann",          "beckmann" },
+	{ "GGX",               "ggx" },
+	{ "Multiscatter GGX",  "multi_ggx",         "multiscatter_ggx" },
+	{ "Sharp",             "sharp" },
+};
+
+constexpr OptionNames HAIR_COMPONENT_NAMES[]{
+	{ "Transmission", "transmission" },
+	{ "Reflection",   "reflection" },
+};
+
+constexpr OptionNames PRINCIPLED_BSDF_DISTRIBUTION_NAMES[]{
+	{ "GGX",              "ggx" },
+	{ "Multiscatter GGX", "multi_ggx", "multiscatter_ggx" },
+};
+
+constexpr OptionNames PRINCIPLED_BSDF_SSS_NAMES[]{
+	{ "Burley",      "burley" },
+	{ "Random Walk", "random_walk" },
+};
+
+constexpr OptionNames PRINCIPLED_HAIR_COLORING_NAMES[]{
+	{ "Absorption coefficient", "absorption", "absorption_coefficient" },
+	{ "Melanin concentration",  "melanin",    "melanin_concentration" },
+	{ "Direct coloring",        "color",      "direct_coloring" },
+};
+
+constexpr OptionNames REFRACTION_DISTRIBUTION_NAMES[]{
+	{ "Beckmann", "beckmann" },
+	{ "GGX",      "ggx" },
+	{ "Sharp",    "sharp" },
+};
+
+constexpr OptionNames SSS_FALLOFF_NAMES[]{
+	{ "Burley",      "burley" },
+	{ "Cubic",       "cubic" },
+	{ "Gaussian",    "gaussian" },
+	{ "Random Walk", "random_walk" },
+};
+
+constexpr OptionNames TOON_COMPONENT_NAMES[]{
+	{ "Diffuse", "diffuse" },
+	{ "Glossy",  "glossy" },
+};
+
+//////
+// Texmap
+//////
+constexpr OptionNames MAX_TEXMAP_PRECISION_NAMES[]{
+	{ "8-bit/Channel Char",   "uchar" },
+	{ "32-bit/Channel Float", "float" },
+};
+
+constexpr OptionNames GRADIENT_TEX_TYPE_NAMES[]{
+	{ "Linear",           "linear" },
+	{ "Quadratic",        "quadratic" },
+	{ "Easing",           "easing" },
+	{ "Diagonal",         "diagonal" },
+	{ "Radial",           "radial" },
+	{ "Quadratic Shpere", "quadratic_sphere" },
+	{ "Shperical",        "spherical" },
+};
+
+constexpr OptionNames MUSGRAVE_TEX_DIMENSIONS_NAMES[]{
+	{ "1D", "1D" },
+	{ "2D", "2D" },
+	{ "3D", "3D" },
+	{ "4D", "4D" },
+};
+
+constexpr OptionNames MUSGRAVE_TEX_TYPE_NAMES[]{
+	{ "Multifractal",        "multifractal" },
+	{ "Ridged Multifractal", "ridged_multifractal" },
+	{ "Hyvrid Multifractal", "hybrid_multifractal" },
+	{ "fBM",                 "fbm" },
+	{ "Hetero Terrain",      "hetero_terrain" },
+};
+
+constexpr OptionNames NOISE_TEX_DIMENSIONS_NAMES[]{
+	{ "1D", "1D" },
+	{ "2D", "2D" },
+	{ "3D", "3D" },
+	{ "4D", "4D" },
+};
+
+constexpr OptionNames VORONOI_TEX_DIMENSIONS_NAMES[]{
+	{ "1D", "1D" },
+	{ "2D", "2D" },
+	{ "3D", "3D" },
+	{ "4D", "4D" },
+};
+
+constexpr OptionNames VORONOI_TEX_FEATURE_NAMES[]{
+	{ "F1",               "f1" },
+	{ "F2",               "f2" },
+	{ "Smooth F1",        "smooth_f1" },
+	{ "Distance to Edge", "distance_to_edge" },
+	{ "N-Sphere Radius",  "n_sphere_radius" },
+};
+
+constexpr OptionNames VORONOI_TEX_METRIC_NAMES[]{
+	{ "Euclidean", "euclidean" },
+	{ "Manhattan", "manhattan" },
+	{ "Chebychev", "chebychev" },
+	{ "Minkowski", "minkowski" },
+};
+
+constexpr OptionNames WAVE_TEX_TYPE_NAMES[]{
+	{ "Bands", "bands" },
+	{ "Rings", "rings" },
+};
+
+constexpr OptionNames WAVE_TEX_DIRECTION_NAMES[]{
+	{ "X",        "x" },
+	{ "Y",        "y" },
+	{ "Z",        "z" },
+	{ "Diagonal", "diagonal" },
+};
+
+constexpr OptionNames WAVE_TEX_PROFILE_NAMES[]{
+	{ "Sine",     "sine" },
+	{ "Saw",      "saw" },
+	{ "Triangle", "triangle" },
+};
+
+constexpr OptionNames WHITE_NOISE_TEX_DIMENSIONS_NAMES[]{
+	{ "1D", "1D" },
+	{ "2D", "2D" },
+	{ "3D", "3D" },
+	{ "4D", "4D" },
+};
+
+//////
+// Vector
+//////
+constexpr OptionNames DISPLACEMENT_SPACE_NAMES[]{
+	{ "Object", "object" },
+	{ "World",  "world" },
+};
+
+constexpr OptionNames VECTOR_MAPPING_TYPE_NAMES[]{
+	{ "Point",   "point" },
+	{ "Texture", "texture" },
+	{ "Vector",  "vector" },
+	{ "Normal",  "normal" },
+};
+
+constexpr OptionNames NORMAL_MAP_SPACE_NAMES[]{
+	{ "Tangent", "tangent" },
+	{ "Object",  "object" },
+	{ "World",   "world" },
+};
+
+constexpr OptionNames VECTOR_DISPLACEMENT_SPACE_NAMES[]{
+	{ "Tangent", "tangent" },
+	{ "Object",  "object" },
+	{ "World",   "world" },
+};
+
+constexpr OptionNames VECTOR_TRANSFORM_TYPE_NAMES[]{
+	{ "Point",  "point" },
+	{ "Vector", "vector" },
+	{ "Normal", "normal" },
+};
+
+constexpr OptionNames VECTOR_TRANSFORM_SPACE_NAMES[]{
+	{ "Camera", "camera" },
+	{ "Object", "object" },
+	{ "World",  "world" },
+};
+
+struct EnumEntry {
+	csg::NodeMetaEnum meta_enum;
+	const OptionNames* options;
+	size_t count;
+};
+
+// Checks at compile time that every option of T is named
+template <typename T, size_t N> constexpr EnumEntry enum_entry(const csg::NodeMetaEnum meta_enum, const OptionNames (&options)[N])
 {
-	if (meta_enum >= NodeMetaEnum::COUNT) {
-		return boost::none;
-	}
+	static_assert(N == static_cast<size_t>(T::COUNT), "Each option of an enum needs one entry in its names table");
+	return EnumEntry{ meta_enum, options, N };
+}
 
-	switch (meta_enum) {
+// One entry per NodeMetaEnum, indexed by NodeMetaEnum
+constexpr EnumEntry ENUM_TABLE[]{
 	// Color
-	case NodeMetaEnum::MIX_RGB_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<MixRGBType>() };
+	enum_entry<csg::MixRGBType>(csg::NodeMetaEnum::MIX_RGB_TYPE, MIX_RGB_TYPE_NAMES),
 	// Converter
-	case NodeMetaEnum::CLAMP_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<ClampType>() };
-	case NodeMetaEnum::MAP_RANGE_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<MapRangeType>() };
-	case NodeMetaEnum::MATH_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<MathType>() };
-	case NodeMetaEnum::VECTOR_MATH_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<VectorMathType>() };
+	enum_entry<csg::ClampType>(csg::NodeMetaEnum::CLAMP_TYPE, CLAMP_TYPE_NAMES),
+	enum_entry<csg::MapRangeType>(csg::NodeMetaEnum::MAP_RANGE_TYPE, MAP_RANGE_TYPE_NAMES),
+	enum_entry<csg::MathType>(csg::NodeMetaEnum::MATH_TYPE, MATH_TYPE_NAMES),
+	enum_entry<csg::VectorMathType>(csg::NodeMetaEnum::VECTOR_MATH_TYPE, VECTOR_MATH_TYPE_NAMES),
 	// Input
-	case NodeMetaEnum::TANGENT_DIRECTION:
-		return NodeEnumInfo{ meta_enum, get_count<TangentDirection>() };
-	case NodeMetaEnum::TANGENT_AXIS:
-		return NodeEnumInfo{ meta_enum, get_count<TangentAxis>() };
+	enum_entry<csg::TangentDirection>(csg::NodeMetaEnum::TANGENT_DIRECTION, TANGENT_DIRECTION_NAMES),
+	enum_entry<csg::TangentAxis>(csg::NodeMetaEnum::TANGENT_AXIS, TANGENT_AXIS_NAMES),
 	// Shader
-	case NodeMetaEnum::ANISOTROPIC_DISTRIBUTION:
-		return NodeEnumInfo{ meta_enum, get_count<AnisotropicDistribution>() };
-	case NodeMetaEnum::GLASS_DISTRIBUTION:
-		return NodeEnumInfo{ meta_enum, get_count<GlassDistribution>() };
-	case NodeMetaEnum::GLOSSY_DISTRIBUTION:
-		return NodeEnumInfo{ meta_enum, get_count<GlossyDistribution>() };
-	case NodeMetaEnum::HAIR_COMPONENT:
-		return NodeEnumInfo{ meta_enum, get_count<HairComponent>() };
-	case NodeMetaEnum::PRINCIPLED_BSDF_DISTRIBUTION:
-		return NodeEnumInfo{ meta_enum, get_count<PrincipledBSDFDistribution>() };
-	case NodeMetaEnum::PRINCIPLED_BSDF_SSS:
-		return NodeEnumInfo{ meta_enum, get_count<PrincipledBSDFSubsurfaceMethod>() };
-	case NodeMetaEnum::PRINCIPLED_HAIR_COLORING:
-		return NodeEnumInfo{ meta_enum, get_count<PrincipledHairColoring>() };
-	case NodeMetaEnum::REFRACTION_DISTRIBUTION:
-		return NodeEnumInfo{ meta_enum, get_count<RefractionDistribution>() };
-	case NodeMetaEnum::SSS_FALLOFF:
-		return NodeEnumInfo{ meta_enum, get_count<SubsurfaceScatterFalloff>() };
-	case NodeMetaEnum::TOON_COMPONENT:
-		return NodeEnumInfo{ meta_enum, get_count<ToonComponent>() };
-	// Texture
-	case NodeMetaEnum::MAX_TEXMAP_PRECISION:
-		return NodeEnumInfo{ meta_enum, get_count<MaxTexmapPrecision>() };
-	case NodeMetaEnum::GRADIENT_TEX_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<GradientTexType>() };
-	case NodeMetaEnum::MUSGRAVE_TEX_DIMENSIONS:
-		return NodeEnumInfo{ meta_enum, get_count<MusgraveTexDimensions>() };
-	case NodeMetaEnum::MUSGRAVE_TEX_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<MusgraveTexType>() };
-	case NodeMetaEnum::NOISE_TEX_DIMENSIONS:
-		return NodeEnumInfo{ meta_enum, get_count<NoiseTexDimensions>() };
-	case NodeMetaEnum::VORONOI_TEX_DIMENSIONS:
-		return NodeEnumInfo{ meta_enum, get_count<VoronoiTexDimensions>() };
-	case NodeMetaEnum::VORONOI_TEX_FEATURE:
-		return NodeEnumInfo{ meta_enum, get_count<VoronoiTexFeature>() };
-	case NodeMetaEnum::VORONOI_TEX_METRIC:
-		return NodeEnumInfo{ meta_enum, get_count<VoronoiTexMetric>() };
-	case NodeMetaEnum::WAVE_TEX_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<WaveTexType>() };
-	case NodeMetaEnum::WAVE_TEX_DIRECTION:
-		return NodeEnumInfo{ meta_enum, get_count<WaveTexDirection>() };
-	case NodeMetaEnum::WAVE_TEX_PROFILE:
-		return NodeEnumInfo{ meta_enum, get_count<WaveTexProfile>() };
-	case NodeMetaEnum::WHITE_NOISE_TEX_DIMENSIONS:
-		return NodeEnumInfo{ meta_enum, get_count<WhiteNoiseTexDimensions>() };
+	enum_entry<csg::AnisotropicDistribution>(csg::NodeMetaEnum::ANISOTROPIC_DISTRIBUTION, ANISOTROPIC_DISTRIBUTION_NAMES),
+	enum_entry<csg::GlassDistribution>(csg::NodeMetaEnum::GLASS_DISTRIBUTION, GLASS_DISTRIBUTION_NAMES),
+	enum_entry<csg::GlossyDistribution>(csg::NodeMetaEnum::GLOSSY_DISTRIBUTION, GLOSSY_DISTRIBUTION_NAMES),
+	enum_entry<csg::HairComponent>(csg::NodeMetaEnum::HAIR_COMPONENT, HAIR_COMPONENT_NAMES),
+	enum_entry<csg::PrincipledBSDFDistribution>(csg::NodeMetaEnum::PRINCIPLED_BSDF_DISTRIBUTION, PRINCIPLED_BSDF_DISTRIBUTION_NAMES),
+	enum_entry<csg::PrincipledBSDFSubsurfaceMethod>(csg::NodeMetaEnum::PRINCIPLED_BSDF_SSS, PRINCIPLED_BSDF_SSS_NAMES),
+	enum_entry<csg::PrincipledHairColoring>(csg::NodeMetaEnum::PRINCIPLED_HAIR_COLORING, PRINCIPLED_HAIR_COLORING_NAMES),
+	enum_entry<csg::RefractionDistribution>(csg::NodeMetaEnum::REFRACTION_DISTRIBUTION, REFRACTION_DISTRIBUTION_NAMES),
+	enum_entry<csg::SubsurfaceScatterFalloff>(csg::NodeMetaEnum::SSS_FALLOFF, SSS_FALLOFF_NAMES),
+	enum_entry<csg::ToonComponent>(csg::NodeMetaEnum::TOON_COMPONENT, TOON_COMPONENT_NAMES),
+	// Texmap
+	enum_entry<csg::MaxTexmapPrecision>(csg::NodeMetaEnum::MAX_TEXMAP_PRECISION, MAX_TEXMAP_PRECISION_NAMES),
+	enum_entry<csg::GradientTexType>(csg::NodeMetaEnum::GRADIENT_TEX_TYPE, GRADIENT_TEX_TYPE_NAMES),
+	enum_entry<csg::MusgraveTexDimensions>(csg::NodeMetaEnum::MUSGRAVE_TEX_DIMENSIONS, MUSGRAVE_TEX_DIMENSIONS_NAMES),
+	enum_entry<csg::MusgraveTexType>(csg::NodeMetaEnum::MUSGRAVE_TEX_TYPE, MUSGRAVE_TEX_TYPE_NAMES),
+	enum_entry<csg::NoiseTexDimensions>(csg::NodeMetaEnum::NOISE_TEX_DIMENSIONS, NOISE_TEX_DIMENSIONS_NAMES),
+	enum_entry<csg::VoronoiTexDimensions>(csg::NodeMetaEnum::VORONOI_TEX_DIMENSIONS, VORONOI_TEX_DIMENSIONS_NAMES),
+	enum_entry<csg::VoronoiTexFeature>(csg::NodeMetaEnum::VORONOI_TEX_FEATURE, VORONOI_TEX_FEATURE_NAMES),
+	enum_entry<csg::VoronoiTexMetric>(csg::NodeMetaEnum::VORONOI_TEX_METRIC, VORONOI_TEX_METRIC_NAMES),
+	enum_entry<csg::WaveTexType>(csg::NodeMetaEnum::WAVE_TEX_TYPE, WAVE_TEX_TYPE_NAMES),
+	enum_entry<csg::WaveTexDirection>(csg::NodeMetaEnum::WAVE_TEX_DIRECTION, WAVE_TEX_DIRECTION_NAMES),
+	enum_entry<csg::WaveTexProfile>(csg::NodeMetaEnum::WAVE_TEX_PROFILE, WAVE_TEX_PROFILE_NAMES),
+	enum_entry<csg::WhiteNoiseTexDimensions>(csg::NodeMetaEnum::WHITE_NOISE_TEX_DIMENSIONS, WHITE_NOISE_TEX_DIMENSIONS_NAMES),
 	// Vector
-	case NodeMetaEnum::DISPLACEMENT_SPACE:
-		return NodeEnumInfo{ meta_enum, get_count<DisplacementSpace>() };
-	case NodeMetaEnum::VECTOR_MAPPING_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<VectorMappingType>() };
-	case NodeMetaEnum::NORMAL_MAP_SPACE:
-		return NodeEnumInfo{ meta_enum, get_count<NormalMapSpace>() };
-	case NodeMetaEnum::VECTOR_DISPLACEMENT_SPACE:
-		return NodeEnumInfo{ meta_enum, get_count<VectorDisplacementSpace>() };
-	case NodeMetaEnum::VECTOR_TRANSFORM_TYPE:
-		return NodeEnumInfo{ meta_enum, get_count<VectorTransformType>() };
-	case NodeMetaEnum::VECTOR_TRANSFORM_SPACE:
-		return NodeEnumInfo{ meta_enum, get_count<VectorTransformSpace>() };
-	default:
+	enum_entry<csg::DisplacementSpace>(csg::NodeMetaEnum::DISPLACEMENT_SPACE, DISPLACEMENT_SPACE_NAMES),
+	enum_entry<csg::VectorMappingType>(csg::NodeMetaEnum::VECTOR_MAPPING_TYPE, VECTOR_MAPPING_TYPE_NAMES),
+	enum_entry<csg::NormalMapSpace>(csg::NodeMetaEnum::NORMAL_MAP_SPACE, NORMAL_MAP_SPACE_NAMES),
+	enum_entry<csg::VectorDisplacementSpace>(csg::NodeMetaEnum::VECTOR_DISPLACEMENT_SPACE, VECTOR_DISPLACEMENT_SPACE_NAMES),
+	enum_entry<csg::VectorTransformType>(csg::NodeMetaEnum::VECTOR_TRANSFORM_TYPE, VECTOR_TRANSFORM_TYPE_NAMES),
+	enum_entry<csg::VectorTransformSpace>(csg::NodeMetaEnum::VECTOR_TRANSFORM_SPACE, VECTOR_TRANSFORM_SPACE_NAMES),
+};
+
+template <size_t N> constexpr bool enum_table_in_order(const EnumEntry (&table)[N])
+{
+	for (size_t i = 0; i < N; i++) {
+		if (static_cast<size_t>(table[i].meta_enum) != i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static_assert(sizeof(ENUM_TABLE) / sizeof(ENUM_TABLE[0]) == static_cast<size_t>(csg::NodeMetaEnum::COUNT), "ENUM_TABLE needs one entry per NodeMetaEnum");
+static_assert(enum_table_in_order(ENUM_TABLE), "ENUM_TABLE must be in the same order as NodeMetaEnum");
+
+boost::optional<csg::NodeEnumInfo> csg::NodeEnumInfo::from(const NodeMetaEnum meta_enum)
+{
+	const size_t meta_index{ static_cast<size_t>(meta_enum) };
+	if (meta_index >= static_cast<size_t>(NodeMetaEnum::COUNT)) {
 		return boost::none;
 	}
+	return NodeEnumInfo{ meta_enum, ENUM_TABLE[meta_index].count };
 }
 
 csg::NodeEnumInfo csg::NodeEnumInfo::from_assert(const NodeMetaEnum meta_enum)
@@ -112,7 +418,7 @@ csg::NodeEnumInfo csg::NodeEnumInfo::from_assert(const NodeMetaEnum meta_enum)
 	return *result;
 }
 
-boost::optional<csg::NodeEnumOptionInfo> csg::NodeEnumOptionInfo::from(NodeMetaEnum meta_enum, size_t option)
+boost::optional<csg::NodeEnumOptionInfo> csg::NodeEnumOptionInfo::from(const NodeMetaEnum meta_enum, const size_t option)
 {
 	const boost::optional<NodeEnumInfo> enum_info{ NodeEnumInfo::from(meta_enum) };
 	if (enum_info.has_value() == false) {
@@ -125,709 +431,12 @@ boost::optional<csg::NodeEnumOptionInfo> csg::NodeEnumOptionInfo::from(NodeMetaE
 	return NodeEnumOptionInfo{ meta_enum, option };
 }
 
-struct NameHolder {
-	NameHolder(const char* disp_name, const char* internal_name, const char* alt_name = nullptr) :
-		disp_name{ disp_name }, internal_name{ internal_name }, alt_name{ alt_name }
-	{}
-
-	const char* const disp_name;
-	const char* const internal_name;
-	const char* const alt_name;
-};
-
-// Tiny macro to make it easier to copy paste all these definitions
-#define CASE_NAMES(ENUM, DISP, INT) case ENUM: return NameHolder{ DISP, INT };
-#define CASE_NAMES_ALT(ENUM, DISP, INT, ALT) case ENUM: return NameHolder{ DISP, INT, ALT };
-
-static NameHolder get_option_names(csg::NodeMetaEnum meta_enum, size_t option)
+// Only valid for options that NodeEnumOptionInfo::from accepts
+static const OptionNames& get_option_names(const csg::NodeMetaEnum meta_enum, const size_t option)
 {
-	using namespace csg;
-
-	switch (meta_enum) {
-
-	//////
-	// Color
-	//////
-	case NodeMetaEnum::MIX_RGB_TYPE:
-	{
-		const auto opt_enum{ as_enum<MixRGBType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(MixRGBType::MIX,          "Mix",          "mix");
-				CASE_NAMES(MixRGBType::DARKEN,       "Darken",       "darken");
-				CASE_NAMES(MixRGBType::MULTIPLY,     "Multiply",     "multiply");
-				CASE_NAMES(MixRGBType::BURN,         "Burn",         "burn");
-				CASE_NAMES(MixRGBType::LIGHTEN,      "Lighten",      "lighten");
-				CASE_NAMES(MixRGBType::SCREEN,       "Screen",       "screen");
-				CASE_NAMES(MixRGBType::DODGE,        "Dodge",        "dodge");
-				CASE_NAMES(MixRGBType::ADD,          "Add",          "add");
-				CASE_NAMES(MixRGBType::OVERLAY,      "Overlay",      "overlay");
-				CASE_NAMES(MixRGBType::SOFT_LIGHT,   "Soft Light",   "soft_light");
-				CASE_NAMES(MixRGBType::LINEAR_LIGHT, "Linear Light", "linear_light");
-				CASE_NAMES(MixRGBType::DIFFERENCE,   "Difference",   "difference");
-				CASE_NAMES(MixRGBType::SUBTRACT,     "Subtract",     "subtract");
-				CASE_NAMES(MixRGBType::DIVIDE,       "Divide",       "divide");
-				CASE_NAMES(MixRGBType::HUE,          "Hue",          "hue");
-				CASE_NAMES(MixRGBType::SATURATION,   "Saturation",   "saturation");
-				CASE_NAMES(MixRGBType::COLOR,        "Color",        "color");
-				CASE_NAMES(MixRGBType::VALUE,        "Value",        "value");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	//////
-	// Converter
-	//////
-	case NodeMetaEnum::CLAMP_TYPE:
-	{
-		const auto opt_enum{ as_enum<ClampType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(ClampType::MINMAX, "Min Max", "minmax");
-				CASE_NAMES(ClampType::RANGE,  "Range",   "range");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::MAP_RANGE_TYPE:
-	{
-		const auto opt_enum{ as_enum<MapRangeType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(MapRangeType::LINEAR,        "Linear",        "linear");
-				CASE_NAMES(MapRangeType::STEPPED,       "Stepped",       "stepped");
-				CASE_NAMES(MapRangeType::SMOOTH_STEP,   "Smooth Step",   "smoothstep");
-				CASE_NAMES(MapRangeType::SMOOTHER_STEP, "Smoother Step", "smootherstep");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::MATH_TYPE:
-	{
-		const auto opt_enum{ as_enum<MathType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(MathType::ADD,          "Add (2)",                "add");
-				CASE_NAMES(MathType::SUBTRACT,     "Subtract (2)",           "subtract");
-				CASE_NAMES(MathType::MULTIPLY,     "Multiply (2)",           "multiply");
-				CASE_NAMES(MathType::DIVIDE,       "Divide (2)",             "divide");
-				CASE_NAMES(MathType::MULTIPLY_ADD, "Multiply Add (2)",       "multiply_add");
-				CASE_NAMES(MathType::SINE,         "Sine (1)",               "sine");
-				CASE_NAMES(MathType::COSINE,       "Cosine (1)",             "cosine");
-				CASE_NAMES(MathType::TANGENT,      "Tangent (1)",            "tangent");
-				CASE_NAMES(MathType::ARCSINE,      "Arcsine (1)",            "arcsine");
-				CASE_NAMES(MathType::ARCCOSINE,    "Arccosine (1)",          "arccosine");
-				CASE_NAMES(MathType::ARCTANGENT,   "Arctangent (1)",         "arctangent");
-				CASE_NAMES(MathType::ARCTAN2,      "Arctan2 (2)",            "arctan2");
-				CASE_NAMES(MathType::SINH,         "Hyperbolic Sine (1)",    "sinh");
-				CASE_NAMES(MathType::COSH,         "Hyperbolic Cosine (1)",  "cosh");
-				CASE_NAMES(MathType::TANH,         "Hyperbolic Tangent (1)", "tanh");
-				CASE_NAMES(MathType::POWER,        "Power (2)",              "power");
-				CASE_NAMES(MathType::LOGARITHM,    "Logarithm (2)",          "logarithm");
-				CASE_NAMES(MathType::MINIMUM,      "Maximum (2)",            "maximum");
-				CASE_NAMES(MathType::MAXIMUM,      "Minimum (2)",            "minimum");
-				CASE_NAMES(MathType::LESS_THAN,    "Less Than (2)",          "less_than");
-				CASE_NAMES(MathType::GREATER_THAN, "Greater Than (2)",       "greater_than");
-				CASE_NAMES(MathType::MODULO,       "Modulo (2)",             "modulo");
-				CASE_NAMES(MathType::ABSOLUTE,     "Absolute (1)",           "absolute");
-				CASE_NAMES(MathType::ROUND,        "Round (1)",              "round");
-				CASE_NAMES(MathType::FLOOR,        "Floor (1)",              "floor");
-				CASE_NAMES(MathType::CEIL,         "Ceil (1)",               "ceil");
-				CASE_NAMES(MathType::FRACTION,     "Fraction (1)",           "fraction");
-				CASE_NAMES(MathType::SQRT,         "Square Root (1)",        "sqrt");
-				CASE_NAMES(MathType::INV_SQRT,     "Inverse Sqrt (1)",       "inverse_sqrt");
-				CASE_NAMES(MathType::SIGN,         "Sign (1)",               "sign");
-				CASE_NAMES(MathType::EXPONENT,     "Exponent (1)",           "exponent");
-				CASE_NAMES(MathType::RADIANS,      "To Radians (1)",         "radians");
-				CASE_NAMES(MathType::DEGREES,      "To Degrees (1)",         "degrees");
-				CASE_NAMES(MathType::TRUNC,        "Truncate (1)",           "truncate");
-				CASE_NAMES(MathType::SNAP,         "Snap (2)",               "snap");
-				CASE_NAMES(MathType::WRAP,         "Wrap (3)",               "wrap");
-				CASE_NAMES(MathType::COMPARE,      "Compare (3)",            "compare");
-				CASE_NAMES(MathType::PINGPONG,     "Ping Pong (3)",          "pingpong");
-				CASE_NAMES(MathType::SMOOTH_MIN,   "Smooth Min (3)",         "smooth_min");
-				CASE_NAMES(MathType::SMOOTH_MAX,   "Smooth Max (3)",         "smooth_max");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VECTOR_MATH_TYPE:
-	{
-		const auto opt_enum{ as_enum<VectorMathType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VectorMathType::ADD,           "Add (2)",           "add");
-				CASE_NAMES(VectorMathType::SUBTRACT,      "Subtract (2)",      "subtract");
-				CASE_NAMES(VectorMathType::MULTIPLY,      "Multiply (2)",      "multiply");
-				CASE_NAMES(VectorMathType::DIVIDE,        "Divide (2)",        "divide");
-				CASE_NAMES(VectorMathType::CROSS_PRODUCT, "Cross Product (2)", "cross_product");
-				CASE_NAMES(VectorMathType::PROJECT,       "Project (2)",       "project");
-				CASE_NAMES(VectorMathType::REFLECT,       "Reflect (2)",       "reflect");
-				CASE_NAMES(VectorMathType::DOT_PRODUCT,   "Dot Product (2)",   "dot_product");
-				CASE_NAMES(VectorMathType::DISTANCE,      "Distance (2)",      "distance");
-				CASE_NAMES(VectorMathType::LENGTH,        "Length (1)",        "length");
-				CASE_NAMES(VectorMathType::SCALE,         "Scale (1)",         "scale");
-				CASE_NAMES(VectorMathType::NORMALIZE,     "Normalize (1)",     "normalize");
-				CASE_NAMES(VectorMathType::SNAP,          "Snap (2)",          "snap");
-				CASE_NAMES(VectorMathType::FLOOR,         "Floor (1)",         "floor");
-				CASE_NAMES(VectorMathType::CEIL,          "Ceil (1)",          "ceil");
-				CASE_NAMES(VectorMathType::MODULO,        "Modulo (2)",        "modulo");
-				CASE_NAMES(VectorMathType::FRACTION,      "Fraction (1)",      "fraction");
-				CASE_NAMES(VectorMathType::ABSOLUTE,      "Absolute (1)",      "absolute");
-				CASE_NAMES(VectorMathType::MINIMUM,       "Minimum (2)",       "minimum");
-				CASE_NAMES(VectorMathType::MAXIMUM,       "Maximum (2)",       "maximum");
-				CASE_NAMES(VectorMathType::WRAP,          "Wrap (3)",          "wrap");
-				CASE_NAMES(VectorMathType::SINE,          "Sine (1)",          "sine");
-				CASE_NAMES(VectorMathType::COSINE,        "Cosine (1)",        "cosine");
-				CASE_NAMES(VectorMathType::TANGENT,       "Tangent (1)",       "tangent");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	//////
-	// Input
-	//////
-	case NodeMetaEnum::TANGENT_DIRECTION:
-	{
-		const auto opt_enum{ as_enum<TangentDirection>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(TangentDirection::RADIAL, "Radial", "radial");
-				CASE_NAMES(TangentDirection::UV_MAP, "UV Map", "uv_map");
-			default:
-				return NameHolder{ "[Unknown Direction]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Direction]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::TANGENT_AXIS:
-	{
-		const auto opt_enum{ as_enum<TangentAxis>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(TangentAxis::X, "X", "x");
-				CASE_NAMES(TangentAxis::Y, "Y", "y");
-				CASE_NAMES(TangentAxis::Z, "Z", "z");
-			default:
-				return NameHolder{ "[Unknown Axis]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Axis]", "ERROR" };
-		}
-	}
-	//////
-	// Shader
-	//////
-	case NodeMetaEnum::ANISOTROPIC_DISTRIBUTION:
-	{
-		const auto opt_enum{ as_enum<AnisotropicDistribution>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(AnisotropicDistribution::ASHIKHMIN_SHIRLEY, "Ashikhmin-Shirley", "ashikhmin_shirley");
-				CASE_NAMES(AnisotropicDistribution::BECKMANN,          "Beckmann",          "beckmann");
-				CASE_NAMES(AnisotropicDistribution::GGX,               "GGX",               "ggx");
-				CASE_NAMES_ALT(AnisotropicDistribution::MULTISCATTER_GGX, "Multiscatter GGX", "multi_ggx", "multiscatter_ggx");
-			default:
-				return NameHolder{ "[Unknown Distribution]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Distribution]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::GLASS_DISTRIBUTION:
-	{
-		const auto opt_enum{ as_enum<GlassDistribution>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(GlassDistribution::GGX,              "GGX",              "ggx");
-				CASE_NAMES(GlassDistribution::BECKMANN,         "Beckmann",         "beckmann");
-				CASE_NAMES(GlassDistribution::SHARP,            "Sharp",            "sharp");
-				CASE_NAMES_ALT(GlassDistribution::MULTISCATTER_GGX, "Multiscatter GGX", "multi_ggx", "multiscatter_ggx");
-			default:
-				return NameHolder{ "[Unknown Distribution]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Distribution]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::GLOSSY_DISTRIBUTION:
-	{
-		const auto opt_enum{ as_enum<GlossyDistribution>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(GlossyDistribution::ASHIKHMIN_SHIRLEY, "Ashikhmin-Shirley", "ashikhmin_shirley");
-				CASE_NAMES(GlossyDistribution::BECKMANN,          "Beckmann",          "beckmann");
-				CASE_NAMES(GlossyDistribution::GGX,               "GGX",               "ggx");
-				CASE_NAMES(GlossyDistribution::SHARP,             "Sharp",             "sharp");
-				CASE_NAMES_ALT(GlossyDistribution::MULTISCATTER_GGX, "Multiscatter GGX", "multi_ggx", "multiscatter_ggx");
-			default:
-				return NameHolder{ "[Unknown Distribution]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Distribution]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::HAIR_COMPONENT:
-	{
-		const auto opt_enum{ as_enum<HairComponent>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(HairComponent::REFLECTION,   "Reflection",   "reflection");
-				CASE_NAMES(HairComponent::TRANSMISSION, "Transmission", "transmission");
-			default:
-				return NameHolder{ "[Unknown Distribution]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Distribution]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::PRINCIPLED_BSDF_DISTRIBUTION:
-	{
-		const auto opt_enum{ as_enum<PrincipledBSDFDistribution>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(PrincipledBSDFDistribution::GGX,              "GGX",              "ggx");
-				CASE_NAMES_ALT(PrincipledBSDFDistribution::MULTISCATTER_GGX, "Multiscatter GGX", "multi_ggx", "multiscatter_ggx");
-			default:
-				return NameHolder{ "[Unknown Distribution]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Distribution]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::PRINCIPLED_BSDF_SSS:
-	{
-		const auto opt_enum{ as_enum<PrincipledBSDFSubsurfaceMethod>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(PrincipledBSDFSubsurfaceMethod::BURLEY,      "Burley",      "burley");
-				CASE_NAMES(PrincipledBSDFSubsurfaceMethod::RANDOM_WALK, "Random Walk", "random_walk");
-			default:
-				return NameHolder{ "[Unknown Method]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Method]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::PRINCIPLED_HAIR_COLORING:
-	{
-		const auto opt_enum{ as_enum<PrincipledHairColoring>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES_ALT(PrincipledHairColoring::ABSORPTION_COEFFICIENT, "Absorption coefficient", "absorption", "absorption_coefficient");
-				CASE_NAMES_ALT(PrincipledHairColoring::MELANIN_CONCENTRATION,  "Melanin concentration",  "melanin",    "melanin_concentration");
-				CASE_NAMES_ALT(PrincipledHairColoring::DIRECT_COLORING,        "Direct coloring",        "color",      "direct_coloring");
-			default:
-				return NameHolder{ "[Unknown Coloring]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Coloring]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::REFRACTION_DISTRIBUTION:
-	{
-		const auto opt_enum{ as_enum<RefractionDistribution>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(RefractionDistribution::BECKMANN, "Beckmann", "beckmann");
-				CASE_NAMES(RefractionDistribution::GGX,      "GGX",      "ggx");
-				CASE_NAMES(RefractionDistribution::SHARP,    "Sharp",    "sharp");
-			default:
-				return NameHolder{ "[Unknown Distribution]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Distribution]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::SSS_FALLOFF:
-	{
-		const auto opt_enum{ as_enum<SubsurfaceScatterFalloff>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(SubsurfaceScatterFalloff::BURLEY,      "Burley",      "burley");
-				CASE_NAMES(SubsurfaceScatterFalloff::CUBIC,       "Cubic",       "cubic");
-				CASE_NAMES(SubsurfaceScatterFalloff::GAUSSIAN,    "Gaussian",    "gaussian");
-				CASE_NAMES(SubsurfaceScatterFalloff::RANDOM_WALK, "Random Walk", "random_walk");
-			default:
-				return NameHolder{ "[Unknown Falloff]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Falloff]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::TOON_COMPONENT:
-	{
-		const auto opt_enum{ as_enum<ToonComponent>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(ToonComponent::DIFFUSE, "Diffuse", "diffuse");
-				CASE_NAMES(ToonComponent::GLOSSY,  "Glossy",  "glossy");
-			default:
-				return NameHolder{ "[Unknown Component]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Component]", "ERROR" };
-		}
-	}
-	//////
-	// Texmap
-	//////
-	case NodeMetaEnum::MAX_TEXMAP_PRECISION:
-	{
-		const auto opt_enum{ as_enum<MaxTexmapPrecision>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(MaxTexmapPrecision::UCHAR, "8-bit/Channel Char",   "uchar");
-				CASE_NAMES(MaxTexmapPrecision::FLOAT, "32-bit/Channel Float", "float");
-			default:
-				return NameHolder{ "[Unknown Precision]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Precision]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::GRADIENT_TEX_TYPE:
-	{
-		const auto opt_enum{ as_enum<GradientTexType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(GradientTexType::LINEAR,           "Linear",           "linear");
-				CASE_NAMES(GradientTexType::QUADRATIC,        "Quadratic",        "quadratic");
-				CASE_NAMES(GradientTexType::EASING,           "Easing",           "easing");
-				CASE_NAMES(GradientTexType::DIAGONAL,         "Diagonal",         "diagonal");
-				CASE_NAMES(GradientTexType::RADIAL,           "Radial",           "radial");
-				CASE_NAMES(GradientTexType::QUADRATIC_SPHERE, "Quadratic Shpere", "quadratic_sphere");
-				CASE_NAMES(GradientTexType::SPHERICAL,        "Shperical",        "spherical");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::MUSGRAVE_TEX_DIMENSIONS:
-	{
-		const auto opt_enum{ as_enum<MusgraveTexDimensions>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(MusgraveTexDimensions::ONE,   "1D", "1D");
-				CASE_NAMES(MusgraveTexDimensions::TWO,   "2D", "2D");
-				CASE_NAMES(MusgraveTexDimensions::THREE, "3D", "3D");
-				CASE_NAMES(MusgraveTexDimensions::FOUR,  "4D", "4D");
-			default:
-				return NameHolder{ "[Unknown Dimensions]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Dimensions]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::MUSGRAVE_TEX_TYPE:
-	{
-		const auto opt_enum{ as_enum<MusgraveTexType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(MusgraveTexType::MULTIFRACTAL,        "Multifractal",        "multifractal");
-				CASE_NAMES(MusgraveTexType::RIDGED_MULTIFRACTAL, "Ridged Multifractal", "ridged_multifractal");
-				CASE_NAMES(MusgraveTexType::HYBRID_MULTIFRACTAL, "Hyvrid Multifractal", "hybrid_multifractal");
-				CASE_NAMES(MusgraveTexType::FBM,                 "fBM",                 "fbm");
-				CASE_NAMES(MusgraveTexType::HETERO_TERRAIN,      "Hetero Terrain",      "hetero_terrain");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::NOISE_TEX_DIMENSIONS:
-	{
-		const auto opt_enum{ as_enum<NoiseTexDimensions>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(NoiseTexDimensions::ONE,   "1D", "1D");
-				CASE_NAMES(NoiseTexDimensions::TWO,   "2D", "2D");
-				CASE_NAMES(NoiseTexDimensions::THREE, "3D", "3D");
-				CASE_NAMES(NoiseTexDimensions::FOUR,  "4D", "4D");
-			default:
-				return NameHolder{ "[Unknown Dimensions]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Dimensions]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VORONOI_TEX_DIMENSIONS:
-	{
-		const auto opt_enum{ as_enum<VoronoiTexDimensions>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VoronoiTexDimensions::ONE,   "1D", "1D");
-				CASE_NAMES(VoronoiTexDimensions::TWO,   "2D", "2D");
-				CASE_NAMES(VoronoiTexDimensions::THREE, "3D", "3D");
-				CASE_NAMES(VoronoiTexDimensions::FOUR,  "4D", "4D");
-			default:
-				return NameHolder{ "[Unknown Dimensions]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Dimensions]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VORONOI_TEX_FEATURE:
-	{
-		const auto opt_enum{ as_enum<VoronoiTexFeature>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VoronoiTexFeature::F1, "F1", "f1");
-				CASE_NAMES(VoronoiTexFeature::F2, "F2", "f2");
-				CASE_NAMES(VoronoiTexFeature::SMOOTH_F1, "Smooth F1", "smooth_f1");
-				CASE_NAMES(VoronoiTexFeature::DISTANCE_TO_EDGE, "Distance to Edge", "distance_to_edge");
-				CASE_NAMES(VoronoiTexFeature::N_SPHERE_RADIUS, "N-Sphere Radius", "n_sphere_radius");
-			default:
-				return NameHolder{ "[Unknown Feature]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Feature]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VORONOI_TEX_METRIC:
-	{
-		const auto opt_enum{ as_enum<VoronoiTexMetric>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VoronoiTexMetric::EUCLIDEAN, "Euclidean", "euclidean");
-				CASE_NAMES(VoronoiTexMetric::MANHATTAN, "Manhattan", "manhattan");
-				CASE_NAMES(VoronoiTexMetric::CHEBYCHEV, "Chebychev", "chebychev");
-				CASE_NAMES(VoronoiTexMetric::MINKOWSKI, "Minkowski", "minkowski");
-			default:
-				return NameHolder{ "[Unknown Feature]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Feature]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::WAVE_TEX_TYPE:
-	{
-		const auto opt_enum{ as_enum<WaveTexType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(WaveTexType::BANDS, "Bands", "bands");
-				CASE_NAMES(WaveTexType::RINGS, "Rings", "rings");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::WAVE_TEX_DIRECTION:
-	{
-		const auto opt_enum{ as_enum<WaveTexDirection>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(WaveTexDirection::X, "X", "x");
-				CASE_NAMES(WaveTexDirection::Y, "Y", "y");
-				CASE_NAMES(WaveTexDirection::Z, "Z", "z");
-				CASE_NAMES(WaveTexDirection::DIAGONAL, "Diagonal", "diagonal");
-			default:
-				return NameHolder{ "[Unknown Direction]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Direction]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::WAVE_TEX_PROFILE:
-	{
-		const auto opt_enum{ as_enum<WaveTexProfile>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(WaveTexProfile::SINE,     "Sine",     "sine");
-				CASE_NAMES(WaveTexProfile::SAW,      "Saw",      "saw");
-				CASE_NAMES(WaveTexProfile::TRIANGLE, "Triangle", "triangle");
-			default:
-				return NameHolder{ "[Unknown Profile]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Profile]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::WHITE_NOISE_TEX_DIMENSIONS:
-	{
-		const auto opt_enum{ as_enum<WhiteNoiseTexDimensions>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(WhiteNoiseTexDimensions::ONE, "1D", "1D");
-				CASE_NAMES(WhiteNoiseTexDimensions::TWO, "2D", "2D");
-				CASE_NAMES(WhiteNoiseTexDimensions::THREE, "3D", "3D");
-				CASE_NAMES(WhiteNoiseTexDimensions::FOUR, "4D", "4D");
-			default:
-				return NameHolder{ "[Unknown Dimensions]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Dimensions]", "ERROR" };
-		}
-	}
-	//////
-	// Vector
-	//////
-	case NodeMetaEnum::DISPLACEMENT_SPACE:
-	{
-		const auto opt_enum{ as_enum<DisplacementSpace>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(DisplacementSpace::OBJECT, "Object", "object");
-				CASE_NAMES(DisplacementSpace::WORLD,  "World",  "world");
-			default:
-				return NameHolder{ "[Unknown Space]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Space]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VECTOR_MAPPING_TYPE:
-	{
-		const auto opt_enum{ as_enum<VectorMappingType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VectorMappingType::POINT,   "Point",   "point");
-				CASE_NAMES(VectorMappingType::TEXTURE, "Texture", "texture");
-				CASE_NAMES(VectorMappingType::VECTOR,  "Vector",  "vector");
-				CASE_NAMES(VectorMappingType::NORMAL,  "Normal",  "normal");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::NORMAL_MAP_SPACE:
-	{
-		const auto opt_enum{ as_enum<NormalMapSpace>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(NormalMapSpace::TANGENT, "Tangent", "tangent");
-				CASE_NAMES(NormalMapSpace::OBJECT,  "Object",  "object");
-				CASE_NAMES(NormalMapSpace::WORLD,   "World",   "world");
-			default:
-				return NameHolder{ "[Unknown Space]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Space]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VECTOR_DISPLACEMENT_SPACE:
-	{
-		const auto opt_enum{ as_enum<VectorDisplacementSpace>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VectorDisplacementSpace::TANGENT, "Tangent", "tangent");
-				CASE_NAMES(VectorDisplacementSpace::OBJECT,  "Object",  "object");
-				CASE_NAMES(VectorDisplacementSpace::WORLD,   "World",   "world");
-			default:
-				return NameHolder{ "[Unknown Space]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Space]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VECTOR_TRANSFORM_TYPE:
-	{
-		const auto opt_enum{ as_enum<VectorTransformType>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VectorTransformType::POINT,  "Point",  "point");
-				CASE_NAMES(VectorTransformType::VECTOR, "Vector", "vector");
-				CASE_NAMES(VectorTransformType::NORMAL, "Normal", "normal");
-			default:
-				return NameHolder{ "[Unknown Type]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Type]", "ERROR" };
-		}
-	}
-	case NodeMetaEnum::VECTOR_TRANSFORM_SPACE:
-	{
-		const auto opt_enum{ as_enum<VectorTransformSpace>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(VectorTransformSpace::CAMERA, "Camera", "camera");
-				CASE_NAMES(VectorTransformSpace::OBJECT, "Object", "object");
-				CASE_NAMES(VectorTransformSpace::WORLD,  "World",  "world");
-			default:
-				return NameHolder{ "[Unknown Space]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad Space]", "ERROR" };
-		}
-	}
-	/*
-	case NodeMetaEnum::COPY_PASTE:
-	{
-		const auto opt_enum{ as_enum<EnumName>(option) };
-		if (opt_enum) {
-			switch (*opt_enum) {
-				CASE_NAMES(Enum::OPTION1, "Option1", "option1");
-				CASE_NAMES(Enum::OPTION2, "Option2", "option2");
-			default:
-				return NameHolder{ "[Unknown]", "ERROR" };
-			}
-		}
-		else {
-			return NameHolder{ "[Bad]", "ERROR" };
-		}
-	}
-	*/
-	default:
-		return NameHolder{ "[Enum Error]", "ERROR" };
-	}
+	const EnumEntry& entry{ ENUM_TABLE[static_cast<size_t>(meta_enum)] };
+	assert(option < entry.count);
+	return entry.options[option];
 }
 
 const char* csg::NodeEnumOptionInfo::display_name() const
@@ -844,3 +453,42 @@ const char* csg::NodeEnumOptionInfo::alt_name() const
 {
 	return get_option_names(_meta_enum, _option).alt_name;
 }
+
+// One table per enum, indexed by NodeMetaEnum
+static std::vector<csc::StringTable<size_t>> make_option_tables()
+{
+	std::vector<csc::StringTable<size_t>> result;
+	for (size_t meta_index = 0; meta_index < static_cast<size_t>(csg::NodeMetaEnum::COUNT); meta_index++) {
+		const csg::NodeMetaEnum meta_enum{ static_cast<csg::NodeMetaEnum>(meta_index) };
+		const boost::optional<csg::NodeEnumInfo> enum_info{ csg::NodeEnumInfo::from(meta_enum) };
+		assert(enum_info.has_value());
+		// Each internal name goes before its alternate so a name matches the same option as checking them in order would
+		std::vector<std::pair<boost::string_view, size_t>> entries;
+		for (size_t option = 0; option < enum_info->count(); option++) {
+			const OptionNames& names{ get_option_names(meta_enum, option) };
+			entries.push_back(std::make_pair(boost::string_view{ names.internal_name }, option));
+			if (names.alt_name != nullptr) {
+				entries.push_back(std::make_pair(boost::string_view{ names.alt_name }, option));
+			}
+		}
+		result.push_back(csc::StringTable<size_t>{ entries });
+	}
+	return result;
+}
+
+boost::optional<size_t> csg::NodeEnumOptionInfo::find(const NodeMetaEnum meta_enum, const boost::string_view name)
+{
+	static const std::vector<csc::StringTable<size_t>> option_tables{ make_option_tables() };
+
+	const size_t meta_index{ static_cast<size_t>(meta_enum) };
+	if (meta_index >= option_tables.size()) {
+		return boost::none;
+	}
+	const size_t* const option{ option_tables[meta_index].find(name) };
+	if (option != nullptr) {
+		return *option;
+	}
+	else {
+		return boost::none;
+	}
+}
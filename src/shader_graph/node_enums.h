@@ -3,6 +3,7 @@
 #include <cstddef>
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 
 namespace csg {
 	enum class NodeMetaEnum {
@@ -434,6 +435,8 @@ namespace csg {
 	class NodeEnumOptionInfo {
 	public:
 		static boost::optional<NodeEnumOptionInfo> from(NodeMetaEnum meta_enum, size_t option);
+		// Find the option with the given internal or alternate name
+		static boost::optional<size_t> find(NodeMetaEnum meta_enum, boost::string_view name);
 
 		const char* display_name() const;
 		const char* internal_name() const;
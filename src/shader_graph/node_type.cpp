@@ -1,31 +1,159 @@
 #include "node_type.h"
 
-#include <atomic>
 #include <cassert>
-#include <map>
-#include <mutex>
-#include <string>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "shader_core/string_table.h"
+
+struct CategoryEntry {
+	csg::NodeCategory category;
+	const char* name;
+	bool allow_creation;
+};
+
+struct TypeEntry {
+	csg::NodeType type;
+	csg::NodeCategory category;
+	const char* disp_name;
+	const char* name;
+	bool allow_creation;
+};
+
+// One entry per NodeCategory, indexed by NodeCategory
+constexpr CategoryEntry CATEGORY_TABLE[]{
+	{ csg::NodeCategory::OUTPUT,    "Output",    false },
+	{ csg::NodeCategory::COLOR,     "Color",     true },
+	{ csg::NodeCategory::CONVERTER, "Converter", true },
+	{ csg::NodeCategory::INPUT,     "Input",     true },
+	{ csg::NodeCategory::SHADER,    "Shader",    true },
+	{ csg::NodeCategory::TEXTURE,   "Texture",   true },
+	{ csg::NodeCategory::VECTOR,    "Vector",    true },
+};
+
+// One entry per NodeType, indexed by NodeType
+constexpr TypeEntry TYPE_TABLE[]{
+	// Output
+	{ csg::NodeType::MATERIAL_OUTPUT,     csg::NodeCategory::OUTPUT,    "Material Output",       "out_material",        false },
+	// Color
+	{ csg::NodeType::BRIGHTNESS_CONTRAST, csg::NodeCategory::COLOR,     "Brightness/Contrast",   "bright_contrast",     true },
+	{ csg::NodeType::GAMMA,               csg::NodeCategory::COLOR,     "Gamma",                 "gamma",               true },
+	{ csg::NodeType::HSV,                 csg::NodeCategory::COLOR,     "HSV",                   "hsv",                 true },
+	{ csg::NodeType::INVERT,              csg::NodeCategory::COLOR,     "Invert",                "invert",              true },
+	{ csg::NodeType::LIGHT_FALLOFF,       csg::NodeCategory::COLOR,     "Light Falloff",         "light_falloff",       true },
+	{ csg::NodeType::MIX_RGB,             csg::NodeCategory::COLOR,     "Mix RGB",               "mix_rgb",             true },
+	{ csg::NodeType::RGB_CURVES,          csg::NodeCategory::COLOR,     "RGB Curves",            "rgb_curves",          true },
+	// Converter
+	{ csg::NodeType::BLACKBODY,           csg::NodeCategory::CONVERTER, "Blackbody",             "blackbody",           true },
+	{ csg::NodeType::CLAMP,               csg::NodeCategory::CONVERTER, "Clamp",                 "clamp",               true },
+	{ csg::NodeType::COLOR_RAMP,          csg::NodeCategory::CONVERTER, "Color Ramp",            "color_ramp",          true },
+	{ csg::NodeType::COMBINE_HSV,         csg::NodeCategory::CONVERTER, "Combine HSV",           "combine_hsv",         true },
+	{ csg::NodeType::COMBINE_RGB,         csg::NodeCategory::CONVERTER, "Combine RGB",           "combine_rgb",         true },
+	{ csg::NodeType::COMBINE_XYZ,         csg::NodeCategory::CONVERTER, "Combine XYZ",           "combine_xyz",         true },
+	{ csg::NodeType::MAP_RANGE,           csg::NodeCategory::CONVERTER, "Map Range",             "map_range",           true },
+	{ csg::NodeType::MATH,                csg::NodeCategory::CONVERTER, "Math",                  "math",                true },
+	{ csg::NodeType::RGB_TO_BW,           csg::NodeCategory::CONVERTER, "RGB to BW",             "rgb_to_bw",           true },
+	{ csg::NodeType::SEPARATE_HSV,        csg::NodeCategory::CONVERTER, "Separate HSV",          "separate_hsv",        true },
+	{ csg::NodeType::SEPARATE_RGB,        csg::NodeCategory::CONVERTER, "Separate RGB",          "separate_rgb",        true },
+	{ csg::NodeType::SEPARATE_XYZ,        csg::NodeCategory::CONVERTER, "Separate XYZ",          "separate_xyz",        true },
+	{ csg::NodeType::VECTOR_MATH,         csg::NodeCategory::CONVERTER, "Vector Math",           "vector_math",         true },
+	{ csg::NodeType::WAVELENGTH,          csg::NodeCategory::CONVERTER, "Wavelength",            "wavelength",          true },
+	// Input
+	{ csg::NodeType::AMBIENT_OCCLUSION,   csg::NodeCategory::INPUT,     "Ambient Occlusion",     "ambient_occlusion",   true },
+	{ csg::NodeType::BEVEL,               csg::NodeCategory::INPUT,     "Bevel",                 "bevel",               true },
+	{ csg::NodeType::CAMERA_DATA,         csg::NodeCategory::INPUT,     "Camera Data",           "camera_data",         true },
+	{ csg::NodeType::FRESNEL,             csg::NodeCategory::INPUT,     "Fresnel",               "fresnel",             true },
+	{ csg::NodeType::GEOMETRY,            csg::NodeCategory::INPUT,     "Geometry",              "geometry",            true },
+	{ csg::NodeType::LAYER_WEIGHT,        csg::NodeCategory::INPUT,     "Layer Weight",          "layer_weight",        true },
+	{ csg::NodeType::LIGHT_PATH,          csg::NodeCategory::INPUT,     "Light Path",            "light_path",          true },
+	{ csg::NodeType::OBJECT_INFO,         csg::NodeCategory::INPUT,     "Object Info",           "object_info",         true },
+	{ csg::NodeType::RGB,                 csg::NodeCategory::INPUT,     "RGB",                   "rgb",                 true },
+	{ csg::NodeType::TANGENT,             csg::NodeCategory::INPUT,     "Tangent",               "tangent",             true },
+	{ csg::NodeType::TEXTURE_COORDINATE,  csg::NodeCategory::INPUT,     "Texture Coordinate",    "texture_coordinate",  true },
+	{ csg::NodeType::VALUE,               csg::NodeCategory::INPUT,     "Value",                 "value",               true },
+	{ csg::NodeType::WIREFRAME,           csg::NodeCategory::INPUT,     "Wireframe",             "wireframe",           true },
+	// Shader
+	{ csg::NodeType::ADD_SHADER,          csg::NodeCategory::SHADER,    "Add Shader",            "add_shader",          true },
+	{ csg::NodeType::ANISOTROPIC_BSDF,    csg::NodeCategory::SHADER,    "Anisotropic BSDF",      "anisotropic_bsdf",    true },
+	{ csg::NodeType::DIFFUSE_BSDF,        csg::NodeCategory::SHADER,    "Diffuse BSDF",          "diffuse_bsdf",        true },
+	{ csg::NodeType::EMISSION,            csg::NodeCategory::SHADER,    "Emission",              "emission",            true },
+	{ csg::NodeType::GLASS_BSDF,          csg::NodeCategory::SHADER,    "Glass BSDF",            "glass_bsdf",          true },
+	{ csg::NodeType::GLOSSY_BSDF,         csg::NodeCategory::SHADER,    "Glossy BSDF",           "glossy_bsdf",         true },
+	{ csg::NodeType::HAIR_BSDF,           csg::NodeCategory::SHADER,    "Hair BSDF",             "hair_bsdf",           true },
+	{ csg::NodeType::HOLDOUT,             csg::NodeCategory::SHADER,    "Holdout",               "holdout",             true },
+	{ csg::NodeType::MIX_SHADER,          csg::NodeCategory::SHADER,    "Mix Shader",            "mix_shader",          true },
+	{ csg::NodeType::PRINCIPLED_BSDF,     csg::NodeCategory::SHADER,    "Principled BSDF",       "principled_bsdf",     true },
+	{ csg::NodeType::PRINCIPLED_HAIR,     csg::NodeCategory::SHADER,    "Principled Hair",       "principled_hair",     true },
+	{ csg::NodeType::PRINCIPLED_VOLUME,   csg::NodeCategory::SHADER,    "Principled Volume",     "principled_volume",   true },
+	{ csg::NodeType::REFRACTION_BSDF,     csg::NodeCategory::SHADER,    "Refraction BSDF",       "refraction_bsdf",     true },
+	{ csg::NodeType::SUBSURFACE_SCATTER,  csg::NodeCategory::SHADER,    "Subsurface Scattering", "subsurface_scatter",  true },
+	{ csg::NodeType::TOON_BSDF,           csg::NodeCategory::SHADER,    "Toon BSDF",             "toon_bsdf",           true },
+	{ csg::NodeType::TRANSLUCENT_BSDF,    csg::NodeCategory::SHADER,    "Translucent BSDF",      "translucent_bsdf",    true },
+	{ csg::NodeType::TRANSPARENT_BSDF,    csg::NodeCategory::SHADER,    "Transparent BSDF",      "transparent_bsdf",    true },
+	{ csg::NodeType::VELVET_BSDF,         csg::NodeCategory::SHADER,    "Velvet BSDF",           "velvet_bsdf",         true },
+	{ csg::NodeType::VOL_ABSORPTION,      csg::NodeCategory::SHADER,    "Volume Absorption",     "vol_absorb",          true },
+	{ csg::NodeType::VOL_SCATTER,         csg::NodeCategory::SHADER,    "Volume Scatter",        "vol_scatter",         true },
+	// Texture
+	{ csg::NodeType::MAX_TEXMAP,          csg::NodeCategory::TEXTURE,   "3ds Max Texmap",        "max_tex",             true },
+	{ csg::NodeType::BRICK_TEX,           csg::NodeCategory::TEXTURE,   "Brick Texture",         "brick_tex",           true },
+	{ csg::NodeType::CHECKER_TEX,         csg::NodeCategory::TEXTURE,   "Checker Texture",       "checker_tex",         true },
+	{ csg::NodeType::GRADIENT_TEX,        csg::NodeCategory::TEXTURE,   "Gradient Texture",      "gradient_tex",        true },
+	{ csg::NodeType::MAGIC_TEX,           csg::NodeCategory::TEXTURE,   "Magic Texture",         "magic_tex",           true },
+	{ csg::NodeType::MUSGRAVE_TEX,        csg::NodeCategory::TEXTURE,   "Musgrave Texture",      "musgrave_tex",        true },
+	{ csg::NodeType::NOISE_TEX,           csg::NodeCategory::TEXTURE,   "Noise Texture",         "noise_tex",           true },
+	{ csg::NodeType::VORONOI_TEX,         csg::NodeCategory::TEXTURE,   "Voronoi Texture",       "voronoi_tex",         true },
+	{ csg::NodeType::WAVE_TEX,            csg::NodeCategory::TEXTURE,   "Wave Texture",          "wave_tex",            true },
+	{ csg::NodeType::WHITE_NOISE_TEX,     csg::NodeCategory::TEXTURE,   "White Noise Texture",   "white_noise_tex",     true },
+	// Vector
+	{ csg::NodeType::BUMP,                csg::NodeCategory::VECTOR,    "Bump",                  "bump",                true },
+	{ csg::NodeType::DISPLACEMENT,        csg::NodeCategory::VECTOR,    "Displacement",          "displacement",        true },
+	{ csg::NodeType::MAPPING,             csg::NodeCategory::VECTOR,    "Mapping",               "mapping",             true },
+	{ csg::NodeType::NORMAL,              csg::NodeCategory::VECTOR,    "Normal",                "normal",              true },
+	{ csg::NodeType::NORMAL_MAP,          csg::NodeCategory::VECTOR,    "Normal Map",            "normal_map",          true },
+	{ csg::NodeType::VECTOR_CURVES,       csg::NodeCategory::VECTOR,    "Vector Curves",         "vector_curves",       true },
+	{ csg::NodeType::VECTOR_DISPLACEMENT, csg::NodeCategory::VECTOR,    "Vector Displacement",   "vector_displacement", true },
+	{ csg::NodeType::VECTOR_TRANSFORM,    csg::NodeCategory::VECTOR,    "Vector Transform",      "vector_transform",    true },
+};
+
+template <typename T, size_t N> constexpr size_t table_size(const T (&)[N])
+{
+	return N;
+}
+
+template <size_t N> constexpr bool category_table_in_order(const CategoryEntry (&table)[N])
+{
+	for (size_t i = 0; i < N; i++) {
+		if (static_cast<size_t>(table[i].category) != i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <size_t N> constexpr bool type_table_in_order(const TypeEntry (&table)[N])
+{
+	for (size_t i = 0; i < N; i++) {
+		if (static_cast<size_t>(table[i].type) != i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static_assert(table_size(CATEGORY_TABLE) == static_cast<size_t>(csg::NodeCategory::COUNT), "CATEGORY_TABLE needs one entry per NodeCategory");
+static_assert(category_table_in_order(CATEGORY_TABLE), "CATEGORY_TABLE must be in the same order as NodeCategory");
+static_assert(table_size(TYPE_TABLE) == static_cast<size_t>(csg::NodeType::COUNT), "TYPE_TABLE needs one entry per NodeType");
+static_assert(type_table_in_order(TYPE_TABLE), "TYPE_TABLE must be in the same order as NodeType");
 
 boost::optional<csg::NodeCategoryInfo> csg::NodeCategoryInfo::from(const NodeCategory category)
 {
-	switch (category) {
-		case NodeCategory::OUTPUT:
-			return NodeCategoryInfo{ category, "Output", false };
-		case NodeCategory::COLOR:
-			return NodeCategoryInfo{ category, "Color" };
-		case NodeCategory::CONVERTER:
-			return NodeCategoryInfo{ category, "Converter" };
-		case NodeCategory::INPUT:
-			return NodeCategoryInfo{ category, "Input" };
-		case NodeCategory::SHADER:
-			return NodeCategoryInfo{ category, "Shader" };
-		case NodeCategory::TEXTURE:
-			return NodeCategoryInfo{ category, "Texture" };
-		case NodeCategory::VECTOR:
-			return NodeCategoryInfo{ category, "Vector" };
-		default:
-			return boost::none;
+	const size_t category_index{ static_cast<size_t>(category) };
+	if (category_index >= table_size(CATEGORY_TABLE)) {
+		return boost::none;
 	}
+	const CategoryEntry& entry{ CATEGORY_TABLE[category_index] };
+	return NodeCategoryInfo{ entry.category, entry.name, entry.allow_creation };
 }
 
 csg::NodeCategoryInfo::NodeCategoryInfo(const NodeCategory category, const char* const name, const bool allow_creation) :
@@ -36,188 +164,32 @@ csg::NodeCategoryInfo::NodeCategoryInfo(const NodeCategory category, const char*
 
 boost::optional<csg::NodeTypeInfo> csg::NodeTypeInfo::from(const NodeType type)
 {
-	switch (type) {
-		// Output
-		case NodeType::MATERIAL_OUTPUT:
-			return NodeTypeInfo{ type, NodeCategory::OUTPUT, "Material Output",    "out_material",    false };
-		// Color
-		case NodeType::BRIGHTNESS_CONTRAST:
-			return NodeTypeInfo{ type, NodeCategory::COLOR, "Brightness/Contrast",    "bright_contrast" };
-		case NodeType::GAMMA:
-			return NodeTypeInfo{ type, NodeCategory::COLOR, "Gamma",                  "gamma" };
-		case NodeType::HSV:
-			return NodeTypeInfo{ type, NodeCategory::COLOR, "HSV",                    "hsv" };
-		case NodeType::INVERT:
-			return NodeTypeInfo{ type, NodeCategory::COLOR, "Invert",                 "invert" };
-		case NodeType::LIGHT_FALLOFF:
-			return NodeTypeInfo{ type, NodeCategory::COLOR, "Light Falloff",          "light_falloff" };
-		case NodeType::MIX_RGB:
-			return NodeTypeInfo{ type, NodeCategory::COLOR, "Mix RGB",                "mix_rgb" };
-		case NodeType::RGB_CURVES:
-			return NodeTypeInfo{ type, NodeCategory::COLOR, "RGB Curves",             "rgb_curves" };
-		// Converter
-		case NodeType::BLACKBODY:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Blackbody",          "blackbody" };
-		case NodeType::CLAMP:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Clamp",              "clamp" };
-		case NodeType::COLOR_RAMP:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Color Ramp",         "color_ramp" };
-		case NodeType::COMBINE_HSV:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Combine HSV",        "combine_hsv" };
-		case NodeType::COMBINE_RGB:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Combine RGB",        "combine_rgb" };
-		case NodeType::COMBINE_XYZ:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Combine XYZ",        "combine_xyz" };
-		case NodeType::MAP_RANGE:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Map Range",          "map_range" };
-		case NodeType::MATH:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Math",               "math" };
-		case NodeType::RGB_TO_BW:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "RGB to BW",          "rgb_to_bw" };
-		case NodeType::SEPARATE_HSV:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Separate HSV",       "separate_hsv" };
-		case NodeType::SEPARATE_RGB:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Separate RGB",       "separate_rgb" };
-		case NodeType::SEPARATE_XYZ:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Separate XYZ",       "separate_xyz" };
-		case NodeType::VECTOR_MATH:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Vector Math",        "vector_math" };
-		case NodeType::WAVELENGTH:
-			return NodeTypeInfo{ type, NodeCategory::CONVERTER, "Wavelength",         "wavelength" };
-		// Input
-		case NodeType::AMBIENT_OCCLUSION:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Ambient Occlusion",      "ambient_occlusion" };
-		case NodeType::BEVEL:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Bevel",                  "bevel" };
-		case NodeType::CAMERA_DATA:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Camera Data",            "camera_data" };
-		case NodeType::FRESNEL:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Fresnel",                "fresnel" };
-		case NodeType::GEOMETRY:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Geometry",               "geometry" };
-		case NodeType::LAYER_WEIGHT:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Layer Weight",           "layer_weight" };
-		case NodeType::LIGHT_PATH:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Light Path",             "light_path" };
-		case NodeType::OBJECT_INFO:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Object Info",            "object_info" };
-		case NodeType::RGB:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "RGB",                    "rgb" };
-		case NodeType::TANGENT:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Tangent",                "tangent" };
-		case NodeType::TEXTURE_COORDINATE:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Texture Coordinate",     "texture_coordinate" };
-		case NodeType::VALUE:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Value",                  "value" };
-		case NodeType::WIREFRAME:
-			return NodeTypeInfo{ type, NodeCategory::INPUT, "Wireframe",              "wireframe" };
-		// Shader
-		case NodeType::ADD_SHADER:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Add Shader",            "add_shader" };
-		case NodeType::ANISOTROPIC_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Anisotropic BSDF",      "anisotropic_bsdf" };
-		case NodeType::DIFFUSE_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Diffuse BSDF",          "diffuse_bsdf" };
-		case NodeType::EMISSION:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Emission",              "emission" };
-		case NodeType::GLASS_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Glass BSDF",            "glass_bsdf" };
-		case NodeType::GLOSSY_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Glossy BSDF",           "glossy_bsdf" };
-		case NodeType::HAIR_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Hair BSDF",             "hair_bsdf" };
-		case NodeType::HOLDOUT:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Holdout",               "holdout" };
-		case NodeType::MIX_SHADER:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Mix Shader",            "mix_shader" };
-		case NodeType::PRINCIPLED_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Principled BSDF",       "principled_bsdf" };
-		case NodeType::PRINCIPLED_HAIR:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Principled Hair",       "principled_hair" };
-		case NodeType::PRINCIPLED_VOLUME:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Principled Volume",     "principled_volume" };
-		case NodeType::REFRACTION_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Refraction BSDF",       "refraction_bsdf" };
-		case NodeType::SUBSURFACE_SCATTER:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Subsurface Scattering", "subsurface_scatter" };
-		case NodeType::TOON_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Toon BSDF",             "toon_bsdf"};
-		case NodeType::TRANSLUCENT_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Translucent BSDF",      "translucent_bsdf" };
-		case NodeType::TRANSPARENT_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Transparent BSDF",      "transparent_bsdf" };
-		case NodeType::VELVET_BSDF:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Velvet BSDF",           "velvet_bsdf" };
-		case NodeType::VOL_ABSORPTION:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Volume Absorption",     "vol_absorb" };
-		case NodeType::VOL_SCATTER:
-			return NodeTypeInfo{ type, NodeCategory::SHADER, "Volume Scatter",        "vol_scatter" };
-		// Texture
-		case NodeType::MAX_TEXMAP:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "3ds Max Texmap",       "max_tex" };
-		case NodeType::BRICK_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Brick Texture",        "brick_tex" };
-		case NodeType::CHECKER_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Checker Texture",      "checker_tex" };
-		case NodeType::GRADIENT_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Gradient Texture",     "gradient_tex" };
-		case NodeType::MAGIC_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Magic Texture",        "magic_tex" };
-		case NodeType::MUSGRAVE_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Musgrave Texture",     "musgrave_tex" };
-		case NodeType::NOISE_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Noise Texture",        "noise_tex" };
-		case NodeType::VORONOI_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Voronoi Texture",      "voronoi_tex" };
-		case NodeType::WAVE_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "Wave Texture",         "wave_tex" };
-		case NodeType::WHITE_NOISE_TEX:
-			return NodeTypeInfo{ type, NodeCategory::TEXTURE, "White Noise Texture",  "white_noise_tex" };
-		// Vector
-		case NodeType::BUMP:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Bump",                  "bump" };
-		case NodeType::DISPLACEMENT:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Displacement",          "displacement" };
-		case NodeType::MAPPING:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Mapping",               "mapping" };
-		case NodeType::NORMAL:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Normal",                "normal" };
-		case NodeType::NORMAL_MAP:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Normal Map",            "normal_map" };
-		case NodeType::VECTOR_CURVES:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Vector Curves",         "vector_curves" };
-		case NodeType::VECTOR_DISPLACEMENT:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Vector Displacement",   "vector_displacement" };
-		case NodeType::VECTOR_TRANSFORM:
-			return NodeTypeInfo{ type, NodeCategory::VECTOR, "Vector Transform",      "vector_transform" };
-		default:
-			return boost::none;
+	const size_t type_index{ static_cast<size_t>(type) };
+	if (type_index >= table_size(TYPE_TABLE)) {
+		return boost::none;
 	}
+	const TypeEntry& entry{ TYPE_TABLE[type_index] };
+	return NodeTypeInfo{ entry.type, entry.category, entry.disp_name, entry.name, entry.allow_creation };
 }
 
-boost::optional<csg::NodeTypeInfo> csg::NodeTypeInfo::from(const char* type_name)
+static csc::StringTable<csg::NodeType> make_node_type_table()
 {
-	static std::mutex local_mutex;
-	static std::atomic<bool> initialized{ false };
-	static std::map<std::string, NodeType> node_type_map;
-
-	if (initialized.load() == false) {
-		std::lock_guard<std::mutex> lock{ local_mutex };
-		node_type_map.clear();
-		for (const NodeType this_type : NodeTypeList{}) {
-			const boost::optional<NodeTypeInfo> opt_type_info = NodeTypeInfo::from(this_type);
-			assert(opt_type_info.has_value());
-			node_type_map[opt_type_info->name()] = opt_type_info->type();
-		}
-		initialized.store(true);
+	std::vector<std::pair<boost::string_view, csg::NodeType>> entries;
+	for (const csg::NodeType this_type : csg::NodeTypeList{}) {
+		const boost::optional<csg::NodeTypeInfo> opt_type_info = csg::NodeTypeInfo::from(this_type);
+		assert(opt_type_info.has_value());
+		entries.push_back(std::make_pair(boost::string_view{ opt_type_info->name() }, opt_type_info->type()));
 	}
+	return csc::StringTable<csg::NodeType>{ entries };
+}
 
-	// Only use the const reference after the locking portion
-	const std::map<std::string, NodeType>& const_map{ node_type_map };
+boost::optional<csg::NodeTypeInfo> csg::NodeTypeInfo::from(const boost::string_view type_name)
+{
+	static const csc::StringTable<NodeType> node_type_table{ make_node_type_table() };
 
-	if (const_map.count(type_name) == 1) {
-		const boost::optional<NodeTypeInfo> opt_type_info = NodeTypeInfo::from(const_map.at(type_name));
-		return opt_type_info;
+	const NodeType* const type{ node_type_table.find(type_name) };
+	if (type != nullptr) {
+		return NodeTypeInfo::from(*type);
 	}
 	else {
 		return boost::none;
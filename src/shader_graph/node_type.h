@@ -1,6 +1,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 
 #include "shader_core/util_enum.h"
 
@@ -121,7 +122,7 @@ namespace csg {
 	class NodeTypeInfo {
 	public:
 		static boost::optional<NodeTypeInfo> from(NodeType type);
-		static boost::optional<NodeTypeInfo> from(const char* type_name);
+		static boost::optional<NodeTypeInfo> from(boost::string_view type_name);
 
 		inline NodeType type() const { return _type; }
 		inline NodeCategory category() const { return _category; }
@@ -29,7 +29,7 @@ namespace csg {
 			assert(index < points.size());
 			return points[index];
 		}
-		std::vector<ColorRampPoint> get() const { return points; }
+		const std::vector<ColorRampPoint>& get() const { return points; }
 
 		void set(size_t index, ColorRampPoint new_point);
 		void remove(size_t index);
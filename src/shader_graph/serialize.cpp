@@ -3,20 +3,30 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cerrno>
 #include <cstddef>
 #include <cstring>
-#include <iomanip>
-#include <list>
+#include <istream>
 #include <map>
 #include <memory>
-#include <sstream>
+#include <set>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
-#include <boost/tokenizer.hpp>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
-#include "shader_core/config.h"
+#include <boost/utility/string_view.hpp>
+
+#include "shader_core/number_format.h"
+#include "shader_core/number_parse.h"
 #include "shader_core/rect.h"
+#include "shader_core/tokenizer.h"
 #include "shader_core/vector.h"
 
 #include "curves.h"
@@ -27,6 +37,8 @@
 #include "node_id.h"
 #include "node_type.h"
 #include "ramp.h"
+#include "serialize_binary.h"
+#include "serialize_compressed.h"
 #include "slot.h"
 #include "slot_id.h"
 
@@ -41,18 +53,49 @@ static const char* const NODE_END{ "node_end" };
 
 static const char* const NODE_ID_PREFIX{ "_nodeid_" };
 
-static std::string name_from_node_id(const csg::NodeId node_id)
+static const char* const PATCH_MAGIC_WORD{ "cycles_shader_patch" };
+static const char* const PATCH_VERSION_INPUT{ "1" };
+static const char* const PATCH_VERSION_OUTPUT{ "1" };
+
+static const char* const SECTION_REMOVED_NODES      { "section_removed_nodes" };
+static const char* const SECTION_ADDED_NODES        { "section_added_nodes" };
+static const char* const SECTION_CHANGED_NODES      { "section_changed_nodes" };
+static const char* const SECTION_REMOVED_CONNECTIONS{ "section_removed_connections" };
+static const char* const SECTION_ADDED_CONNECTIONS  { "section_added_connections" };
+
+// Rough size of one connection record, names and slot display names of both ends
+constexpr size_t CONNECTION_SIZE_ESTIMATE{ 96 };
+
+// Bytes read at a time when streaming from a file or stream
+constexpr size_t STREAM_CHUNK_SIZE{ 64 * 1024 };
+
+// Batches of node records at least this big are split across threads, smaller ones are not worth starting threads for
+constexpr size_t PARALLEL_NODES_MIN{ 512 };
+// Each parse thread gets at least this many records
+constexpr size_t PARALLEL_NODES_PER_THREAD{ 128 };
+constexpr size_t PARALLEL_THREADS_MAX{ 16 };
+
+static void append_node_name(std::string& output, const csg::NodeId node_id)
 {
 	const size_t size_src{ sizeof(csg::NodeId) };
 	const size_t size_dest{ ext::base64::encoded_size(size_src) };
 	std::array<char, 24> result_array;
 	assert(size_dest < result_array.size());
-	result_array.fill('\0');
-	ext::base64::encode(result_array.data(), &node_id, size_src);
-	return std::string{ NODE_ID_PREFIX } + result_array.data();
+	const size_t encoded_size{ ext::base64::encode(result_array.data(), &node_id, size_src) };
+	output += NODE_ID_PREFIX;
+	output.append(result_array.data(), encoded_size);
+}
+
+static void append_float3(std::string& output, const csc::Float3 value)
+{
+	csc::append_float(output, value.x);
+	output += ',';
+	csc::append_float(output, value.y);
+	output += ',';
+	csc::append_float(output, value.z);
 }
 
-static std::string serialize_curve(const csg::Curve& curve)
+static void append_curve(std::string& output, const csg::Curve& curve)
 {
 	constexpr char SEPARATOR{ ',' };
 
@@ -68,119 +111,112 @@ static std::string serialize_curve(const csg::Curve& curve)
 		}
 	};
 
-	std::stringstream sstream;
-	sstream << std::fixed << std::setprecision(SERIALIZED_GRAPH_PRECISION);
-
 	bool write_opening_separator{ false };
-	for (const csg::CurvePoint point : curve.control_points()) {
+	for (const csg::CurvePoint& point : curve.control_points()) {
 		if (write_opening_separator) {
-			sstream << SEPARATOR;
+			output += SEPARATOR;
 		}
-		sstream << point.pos.x << SEPARATOR << point.pos.y << SEPARATOR << interp_as_char(point.interp);
+		csc::append_float(output, point.pos.x);
+		output += SEPARATOR;
+		csc::append_float(output, point.pos.y);
+		output += SEPARATOR;
+		output += interp_as_char(point.interp);
 		write_opening_separator = true;
 	}
-	return sstream.str();
 }
 
-static std::string serialize_slot_value(const csg::SlotValue& slot_value)
+static void append_slot_value(std::string& output, const csg::SlotValue& slot_value)
 {
 	switch (slot_value.type()) {
 	case csg::SlotType::BOOL:
-		if (slot_value.as<csg::BoolSlotValue>().has_value()) {
-			const csg::BoolSlotValue bool_slot_value{ slot_value.as<csg::BoolSlotValue>().value() };
-			if (bool_slot_value.get()) {
-				return "1";
-			}
-			else {
-				return "0";
-			}
+		if (const csg::BoolSlotValue* const bool_slot_value{ slot_value.as_ptr<csg::BoolSlotValue>() }) {
+			output += bool_slot_value->get() ? '1' : '0';
+			return;
 		}
 		break;
 	case csg::SlotType::COLOR:
-		if (slot_value.as<csg::ColorSlotValue>().has_value()) {
-			const csg::ColorSlotValue color_slot_value{ slot_value.as<csg::ColorSlotValue>().value() };
-			const csc::Float3 color{ color_slot_value.get() };
-			std::stringstream sstream;
-			sstream << std::fixed << std::setprecision(SERIALIZED_GRAPH_PRECISION) << color.x << ',' << color.y << ',' << color.z;
-			return sstream.str();
+		if (const csg::ColorSlotValue* const color_slot_value{ slot_value.as_ptr<csg::ColorSlotValue>() }) {
+			append_float3(output, color_slot_value->get());
+			return;
 		}
 		break;
 	case csg::SlotType::ENUM:
-		if (slot_value.as<csg::EnumSlotValue>().has_value()) {
-			const csg::EnumSlotValue enum_slot_value{ slot_value.as<csg::EnumSlotValue>().value() };
-			return std::string{ enum_slot_value.internal_name() };
+		if (const csg::EnumSlotValue* const enum_slot_value{ slot_value.as_ptr<csg::EnumSlotValue>() }) {
+			output += enum_slot_value->internal_name();
+			return;
 		}
 		break;
 	case csg::SlotType::FLOAT:
-		if (slot_value.as<csg::FloatSlotValue>().has_value()) {
-			const csg::FloatSlotValue float_slot_value{ slot_value.as<csg::FloatSlotValue>().value() };
-			std::stringstream sstream;
-			sstream << std::fixed << std::setprecision(SERIALIZED_GRAPH_PRECISION) << float_slot_value.get();
-			return sstream.str();
+		if (const csg::FloatSlotValue* const float_slot_value{ slot_value.as_ptr<csg::FloatSlotValue>() }) {
+			csc::append_float(output, float_slot_value->get());
+			return;
 		}
 		break;
 	case csg::SlotType::INT:
-		if (slot_value.as<csg::IntSlotValue>().has_value()) {
-			const csg::IntSlotValue int_slot_value{ slot_value.as<csg::IntSlotValue>().value() };
-			std::stringstream sstream;
-			sstream << int_slot_value.get();
-			return sstream.str();
+		if (const csg::IntSlotValue* const int_slot_value{ slot_value.as_ptr<csg::IntSlotValue>() }) {
+			csc::append_int(output, int_slot_value->get());
+			return;
 		}
 		break;
 	case csg::SlotType::VECTOR:
-		if (slot_value.as<csg::VectorSlotValue>().has_value()) {
-			const csg::VectorSlotValue vec_slot_value{ slot_value.as<csg::VectorSlotValue>().value() };
-			const csc::Float3 color{ vec_slot_value.get() };
-			std::stringstream sstream;
-			sstream << std::fixed << std::setprecision(SERIALIZED_GRAPH_PRECISION) << color.x << ',' << color.y << ',' << color.z;
-			return sstream.str();
+		if (const csg::VectorSlotValue* const vec_slot_value{ slot_value.as_ptr<csg::VectorSlotValue>() }) {
+			append_float3(output, vec_slot_value->get());
+			return;
 		}
 		break;
 	case csg::SlotType::CURVE_RGB:
-		if (slot_value.as<csg::RGBCurveSlotValue>().has_value()) {
+		if (const csg::RGBCurveSlotValue* const rgb_slot_value{ slot_value.as_ptr<csg::RGBCurveSlotValue>() }) {
 			constexpr char CURVE_SEPARATOR{ '/' };
-			const csg::RGBCurveSlotValue rgb_slot_value{ slot_value.as<csg::RGBCurveSlotValue>().value() };
-			std::stringstream sstream;
-			sstream << std::fixed << std::setprecision(SERIALIZED_GRAPH_PRECISION);
-			sstream << "curve_rgb_00" << CURVE_SEPARATOR << "00" << CURVE_SEPARATOR;
-			sstream << serialize_curve(rgb_slot_value.get_all()) << CURVE_SEPARATOR;
-			sstream << serialize_curve(rgb_slot_value.get_r()) << CURVE_SEPARATOR;
-			sstream << serialize_curve(rgb_slot_value.get_g()) << CURVE_SEPARATOR;
-			sstream << serialize_curve(rgb_slot_value.get_b());
-			return sstream.str();
+			output += "curve_rgb_00";
+			output += CURVE_SEPARATOR;
+			output += "00";
+			output += CURVE_SEPARATOR;
+			append_curve(output, rgb_slot_value->get_all());
+			output += CURVE_SEPARATOR;
+			append_curve(output, rgb_slot_value->get_r());
+			output += CURVE_SEPARATOR;
+			append_curve(output, rgb_slot_value->get_g());
+			output += CURVE_SEPARATOR;
+			append_curve(output, rgb_slot_value->get_b());
+			return;
 		}
 		break;
 	case csg::SlotType::CURVE_VECTOR:
-		if (slot_value.as<csg::VectorCurveSlotValue>().has_value()) {
+		if (const csg::VectorCurveSlotValue* const curve_slot_value{ slot_value.as_ptr<csg::VectorCurveSlotValue>() }) {
 			constexpr char CURVE_SEPARATOR{ '/' };
-			const csg::VectorCurveSlotValue curve_slot_value{ slot_value.as<csg::VectorCurveSlotValue>().value() };
-			std::stringstream sstream;
-			sstream << std::fixed << std::setprecision(SERIALIZED_GRAPH_PRECISION);
-			sstream << "curve_vec_00" << CURVE_SEPARATOR << "00" << CURVE_SEPARATOR;
-			sstream << curve_slot_value.get_min().x << "," << curve_slot_value.get_min().y << CURVE_SEPARATOR;
-			sstream << curve_slot_value.get_max().x << "," << curve_slot_value.get_max().y << CURVE_SEPARATOR;
-			sstream << serialize_curve(curve_slot_value.get_x()) << CURVE_SEPARATOR;
-			sstream << serialize_curve(curve_slot_value.get_y()) << CURVE_SEPARATOR;
-			sstream << serialize_curve(curve_slot_value.get_z());
-			return sstream.str();
+			output += "curve_vec_00";
+			output += CURVE_SEPARATOR;
+			output += "00";
+			output += CURVE_SEPARATOR;
+			csc::append_float(output, curve_slot_value->get_min().x);
+			output += ',';
+			csc::append_float(output, curve_slot_value->get_min().y);
+			output += CURVE_SEPARATOR;
+			csc::append_float(output, curve_slot_value->get_max().x);
+			output += ',';
+			csc::append_float(output, curve_slot_value->get_max().y);
+			output += CURVE_SEPARATOR;
+			append_curve(output, curve_slot_value->get_x());
+			output += CURVE_SEPARATOR;
+			append_curve(output, curve_slot_value->get_y());
+			output += CURVE_SEPARATOR;
+			append_curve(output, curve_slot_value->get_z());
+			return;
 		}
 		break;
 	case csg::SlotType::COLOR_RAMP:
-		if (slot_value.as<csg::ColorRampSlotValue>().has_value()) {
+		if (const csg::ColorRampSlotValue* const ramp_slot_value{ slot_value.as_ptr<csg::ColorRampSlotValue>() }) {
 			constexpr char RAMP_SEPARATOR{ ',' };
-			const csg::ColorRampSlotValue ramp_slot_value{ slot_value.as<csg::ColorRampSlotValue>().value() };
-			std::stringstream sstream;
-			sstream << std::fixed << std::setprecision(SERIALIZED_GRAPH_PRECISION);
-			sstream << "ramp00";
-			for (const auto& this_point : ramp_slot_value.get().get()) {
-				const float a = this_point.pos;
-				const float b = this_point.color.x;
-				const float c = this_point.color.y;
-				const float d = this_point.color.z;
-				const float e = this_point.alpha;
-				sstream << RAMP_SEPARATOR << a << RAMP_SEPARATOR << b << RAMP_SEPARATOR << c << RAMP_SEPARATOR << d << RAMP_SEPARATOR << e;
+			output += "ramp00";
+			for (const auto& this_point : ramp_slot_value->get().get()) {
+				output += RAMP_SEPARATOR;
+				csc::append_float(output, this_point.pos);
+				output += RAMP_SEPARATOR;
+				append_float3(output, this_point.color);
+				output += RAMP_SEPARATOR;
+				csc::append_float(output, this_point.alpha);
 			}
-			return sstream.str();
+			return;
 		}
 		break;
 	default:
@@ -188,166 +224,228 @@ static std::string serialize_slot_value(const csg::SlotValue& slot_value)
 		break;
 	}
 
-	return "ERROR";
+	output += "ERROR";
 }
 
-std::string csg::serialize_graph(const Graph& graph)
+// Rough guess of how many characters a slot value will take, used to size the output buffer up front
+static size_t estimate_slot_value_size(const csg::SlotType type)
 {
-	// Make a local sorted copy of all nodes and connections
-	const auto& graph_connections = graph.connections();
-	std::vector<Connection> connections{ graph_connections.begin(), graph_connections.end() };
-	std::sort(connections.begin(), connections.end());
+	switch (type) {
+	case csg::SlotType::BOOL:
+		return 1;
+	case csg::SlotType::FLOAT:
+	case csg::SlotType::INT:
+		return 10;
+	case csg::SlotType::ENUM:
+		return 16;
+	case csg::SlotType::COLOR:
+	case csg::SlotType::VECTOR:
+		return 32;
+	default:
+		return 256;
+	}
+}
 
-	std::vector<Node> nodes;
-	for (const auto& node : graph.nodes()) {
-		nodes.push_back(*node);
+static size_t estimate_node_size(const csg::Node& node)
+{
+	// Type name, node name, position and node_end
+	size_t result{ 80 };
+	const std::shared_ptr<const std::string> cached_values{ node.serialized_values() };
+	if (cached_values) {
+		return result + cached_values->size();
 	}
-	std::sort(nodes.begin(), nodes.end(),
-		[](const Node& a, const Node& b) {
-			return a.id() < b.id();
+	const std::vector<csg::Slot>& slots{ node.slots() };
+	for (size_t i = 0; i < slots.size(); i++) {
+		if (slots[i].dir() == csg::SlotDirection::INPUT && node.slot_value_ptr_without_decoding(i) != nullptr) {
+			result += std::strlen(slots[i].name()) + estimate_slot_value_size(slots[i].type()) + 2;
 		}
-	);
-
-	std::stringstream result_stream;
-
-	// Header
-	result_stream << MAGIC_WORD << "|" << VERSION_OUTPUT << "|";
+	}
+	return result;
+}
 
-	// Node section
-	result_stream << SECTION_NODES << "|";
-	std::map<NodeId, std::string> names_by_id;
-	for (const Node& node : nodes) {
-		const std::string node_name{ name_from_node_id(node.id()) };
-		names_by_id[node.id()] = node_name;
-		const boost::optional<NodeTypeInfo> info{ NodeTypeInfo::from(node.type()) };
-		if (info.has_value()) {
-			result_stream << info->name() << "|" << node_name << "|";
-			result_stream << node.position.x << "|" << node.position.y << "|";
-			for (const Slot& slot : node.slots()) {
-				if (slot.dir() == SlotDirection::INPUT && slot.value.has_value()) {
-					result_stream << slot.name() << "|" << serialize_slot_value(slot.value.value()) << "|";
-				}
+// Everything in a node after its position, this is what gets cached on the node
+static std::string serialize_node_values(const csg::Node& node)
+{
+	std::string output;
+	output.reserve(estimate_node_size(node));
+	const std::vector<csg::Slot>& slots{ node.slots() };
+	for (size_t i = 0; i < slots.size(); i++) {
+		const csg::Slot& slot{ slots[i] };
+		const csg::SlotValue* const value{ node.slot_value_ptr_without_decoding(i) };
+		if (slot.dir() == csg::SlotDirection::INPUT && value != nullptr) {
+			output += slot.name();
+			output += '|';
+			const boost::optional<boost::string_view> undecoded_value{ node.undecoded_value(i) };
+			if (undecoded_value) {
+				// Values that were never accessed are written back exactly as they were read
+				output.append(undecoded_value->data(), undecoded_value->size());
 			}
-			result_stream << "node_end|";
-		}
-		else {
-			continue;
+			else {
+				append_slot_value(output, *value);
+			}
+			output += '|';
 		}
 	}
+	output += NODE_END;
+	output += '|';
+	return output;
+}
 
-	// Connection section
-	result_stream << SECTION_CONNECTIONS << "|";
-
-	for (const Connection& connection : connections) {
-		const csg::NodeId id_src{ connection.source().node_id() };
-		const csg::NodeId id_dest{ connection.dest().node_id() };
-		if (names_by_id.count(id_src) == 0 || names_by_id.count(id_dest) == 0) {
-			// Either source or dest node does not exist, ignore this connection
-			continue;
-		}
-		const std::string name_src{ names_by_id[id_src] };
-		const std::string name_dest{ names_by_id[id_dest] };
-		const auto opt_node_src{ graph.get(id_src) };
-		const auto opt_node_dest{ graph.get(id_dest) };
-
-		// We already checked that these nodes exist, so the optionals here should always hold a value
-		assert(opt_node_src.use_count() > 0);
-		assert(opt_node_dest.use_count() > 0);
+static void append_node(std::string& output, const csg::Node& node, const csg::NodeTypeInfo& info)
+{
+	output += info.name();
+	output += '|';
+	append_node_name(output, node.id());
+	output += '|';
+	csc::append_int(output, node.position.x);
+	output += '|';
+	csc::append_int(output, node.position.y);
+	output += '|';
+
+	// Slot values are only serialized again after one of them has changed
+	std::shared_ptr<const std::string> values{ node.serialized_values() };
+	if (values == nullptr) {
+		values = std::make_shared<const std::string>(serialize_node_values(node));
+		node.set_serialized_values(values);
+	}
+	output += *values;
+}
 
-		// Now we need to get the slots to find the slot names
-		const auto opt_slot_src{ opt_node_src->slot(connection.source().index()) };
-		const auto opt_slot_dest{ opt_node_dest->slot(connection.dest().index()) };
-		if (opt_slot_src.has_value() == false || opt_slot_dest.has_value() == false) {
-			// One of the slots is not real, ignore this connection
-			continue;
+// Pointers to all nodes in a graph, sorted by id so output does not depend on draw order
+static std::vector<const csg::Node*> sorted_nodes(const csg::Graph& graph)
+{
+	std::vector<const csg::Node*> result;
+	result.reserve(graph.nodes().size());
+	for (const csg::Node& node : graph.nodes()) {
+		result.push_back(&node);
+	}
+	std::sort(result.begin(), result.end(),
+		[](const csg::Node* const a, const csg::Node* const b) {
+			return a->id() < b->id();
 		}
+	);
+	return result;
+}
 
-		result_stream << name_src << "|" << opt_slot_src->disp_name() << "|";
-		result_stream << name_dest << "|" << opt_slot_dest->disp_name() << "|";
+// Connections are only written if both ends refer to real slots
+static bool connection_is_serializable(const csg::Graph& graph, const csg::Connection& connection)
+{
+	const auto opt_node_src{ graph.get(connection.source().node_id()) };
+	const auto opt_node_dest{ graph.get(connection.dest().node_id()) };
+	if (opt_node_src == nullptr || opt_node_dest == nullptr) {
+		// Either source or dest node does not exist
+		return false;
 	}
+	return connection.source().index() < opt_node_src->slot_count() && connection.dest().index() < opt_node_dest->slot_count();
+}
 
-	return result_stream.str();
+static void append_connection(std::string& output, const csg::Graph& graph, const csg::Connection& connection)
+{
+	assert(connection_is_serializable(graph, connection));
+	const auto node_src{ graph.get(connection.source().node_id()) };
+	const auto node_dest{ graph.get(connection.dest().node_id()) };
+	const csg::Slot& slot_src{ node_src->slots()[connection.source().index()] };
+	const csg::Slot& slot_dest{ node_dest->slots()[connection.dest().index()] };
+
+	append_node_name(output, node_src->id());
+	output += '|';
+	output += slot_src.disp_name();
+	output += '|';
+	append_node_name(output, node_dest->id());
+	output += '|';
+	output += slot_dest.disp_name();
+	output += '|';
 }
 
-// Check whether iter is able to successfully increment count times without becoming equal to end
-template<typename T>
-static bool iter_has_contents(T iter, const T end, size_t count)
+static std::string serialize_graph_text(const csg::Graph& graph)
 {
-	while (count > 0) {
-		if (iter == end) {
-			return false;
+	using namespace csg;
+
+	// Sort pointers to nodes and a local copy of all connections
+	const std::vector<const Node*> nodes{ sorted_nodes(graph) };
+
+	const auto& graph_connections = graph.connections();
+	std::vector<Connection> connections{ graph_connections.begin(), graph_connections.end() };
+	std::sort(connections.begin(), connections.end());
+
+	// Names and slot display names of both ends
+	size_t size_estimate{ 64 + connections.size() * CONNECTION_SIZE_ESTIMATE };
+	for (const Node* const node : nodes) {
+		size_estimate += estimate_node_size(*node);
+	}
+
+	std::string result;
+	result.reserve(size_estimate);
+
+	// Header
+	result += MAGIC_WORD;
+	result += '|';
+	result += VERSION_OUTPUT;
+	result += '|';
+
+	// Node section
+	result += SECTION_NODES;
+	result += '|';
+	for (const Node* const node : nodes) {
+		const boost::optional<NodeTypeInfo> info{ NodeTypeInfo::from(node->type()) };
+		if (info.has_value()) {
+			append_node(result, *node, *info);
 		}
-		count--;
-		iter++;
 	}
-	return true;
-}
 
-// Normal stoi/stof will use system locale which may be a problem, this way uses default locale
+	// Connection section
+	result += SECTION_CONNECTIONS;
+	result += '|';
 
-static int my_stoi(const std::string& input)
-{
-	std::stringstream stream{ input };
-	int result{ 0 };
-	stream >> result;
-	return result;
-}
+	for (const Connection& connection : connections) {
+		if (connection_is_serializable(graph, connection)) {
+			append_connection(result, graph, connection);
+		}
+	}
 
-static float my_stof(const std::string& input)
-{
-	std::stringstream stream{ input };
-	float result{ 0.0f };
-	stream >> result;
 	return result;
 }
 
-static csc::Float2 my_stof2(const std::string& input)
+static csc::Float2 my_stof2(const boost::string_view input)
 {
-	const boost::char_separator<char> sep{ "," };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ input, sep };
-
-	auto token_iter = tokenizer.begin();
-	if (iter_has_contents(token_iter, tokenizer.end(), 2) == false) {
+	csc::Tokenizer tokens{ input, ',' };
+	if (tokens.has_tokens(2) == false) {
 		// Did not find the two expected comma-separated floats
 		return csc::Float2{};
 	}
 
 	csc::Float2 result;
-	result.x = my_stof(*token_iter++);
-	result.y = my_stof(*token_iter++);
+	result.x = csc::parse_float(tokens.next());
+	result.y = csc::parse_float(tokens.next());
 	return result;
 }
 
-static csc::Float3 my_stof3(const std::string& input)
+static csc::Float3 my_stof3(const boost::string_view input)
 {
-	const boost::char_separator<char> sep{ "," };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ input, sep };
-
-	auto token_iter = tokenizer.begin();
-	if (iter_has_contents(token_iter, tokenizer.end(), 3) == false) {
+	csc::Tokenizer tokens{ input, ',' };
+	if (tokens.has_tokens(3) == false) {
 		// Did not find the three expected comma-separated floats
 		return csc::Float3{};
 	}
 
 	csc::Float3 result;
-	result.x = my_stof(*token_iter++);
-	result.y = my_stof(*token_iter++);
-	result.z = my_stof(*token_iter++);
+	result.x = csc::parse_float(tokens.next());
+	result.y = csc::parse_float(tokens.next());
+	result.z = csc::parse_float(tokens.next());
 	return result;
 }
 
-static boost::optional<csg::NodeId> node_id_from_name(const std::string& node_name)
+static boost::optional<csg::NodeId> node_id_from_name(const boost::string_view node_name)
 {
-	if (node_name.find(NODE_ID_PREFIX) != 0) {
+	if (node_name.starts_with(NODE_ID_PREFIX) == false) {
 		// This name does not have the right prefix
 		return boost::none;
 	}
 
-	const size_t prefix_size = strlen(NODE_ID_PREFIX);
-	const std::string id_encoded{ node_name.substr(prefix_size, node_name.size() - prefix_size) };
+	const boost::string_view id_encoded{ node_name.substr(strlen(NODE_ID_PREFIX)) };
 	std::array<char, 32> buffer;
 	buffer.fill('\0');
-	const std::pair<size_t, size_t> decode_result = ext::base64::decode(buffer.data(), id_encoded.c_str(), std::min(static_cast<size_t>(16), id_encoded.size()));
+	const std::pair<size_t, size_t> decode_result = ext::base64::decode(buffer.data(), id_encoded.data(), std::min(static_cast<size_t>(16), id_encoded.size()));
 	if (decode_result.first < sizeof(csg::NodeId)) {
 		// ID was not long enough
 		return boost::none;
@@ -358,9 +456,9 @@ static boost::optional<csg::NodeId> node_id_from_name(const std::string& node_na
 	return result;
 }
 
-static boost::optional<csg::NodeType> get_type_from_name(const std::string& type_name)
+static boost::optional<csg::NodeType> get_type_from_name(const boost::string_view type_name)
 {
-	const boost::optional<csg::NodeTypeInfo> opt_type_info{ csg::NodeTypeInfo::from(type_name.c_str()) };
+	const boost::optional<csg::NodeTypeInfo> opt_type_info{ csg::NodeTypeInfo::from(type_name) };
 	if (opt_type_info.has_value()) {
 		return opt_type_info->type();
 	}
@@ -369,7 +467,7 @@ static boost::optional<csg::NodeType> get_type_from_name(const std::string& type
 	}
 }
 
-static csg::CurveInterp get_interp(const std::string symbol)
+static csg::CurveInterp get_interp(const boost::string_view symbol)
 {
 	if (symbol == "l") {
 		return csg::CurveInterp::LINEAR;
@@ -379,19 +477,25 @@ static csg::CurveInterp get_interp(const std::string symbol)
 	}
 }
 
-static boost::optional<csg::Curve> deserialize_curve(const std::string& curve, const csc::Float2 min, const csc::Float2 max)
+static boost::optional<csg::Curve> deserialize_curve(const boost::string_view curve, const csc::Float2 min, const csc::Float2 max, const size_t max_points)
 {
-	const boost::char_separator<char> sep{ "," };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ curve, sep };
-
-	auto token_iter = tokenizer.begin();
+	csc::Tokenizer tokens{ curve, ',' };
 
+	const csc::FloatRect bounds{ min, max };
 	std::vector<csg::CurvePoint> points;
-	while (iter_has_contents(token_iter, tokenizer.end(), 3)) {
-		const float x{ my_stof(*token_iter++) };
-		const float y{ my_stof(*token_iter++) };
-		const csg::CurveInterp interp{ get_interp(*token_iter++) };
-		points.push_back(csg::CurvePoint{ csc::Float2{ x, y }, interp });
+	while (tokens.has_tokens(3)) {
+		if (points.size() >= max_points) {
+			return boost::none;
+		}
+		const float x{ csc::parse_float(tokens.next()) };
+		const float y{ csc::parse_float(tokens.next()) };
+		const csg::CurveInterp interp{ get_interp(tokens.next()) };
+		const csc::Float2 pos{ x, y };
+		// Curves require every point to be inside their bounds, a point outside rejects the whole curve as the binary format does
+		if (bounds.contains(pos) == false) {
+			return boost::none;
+		}
+		points.push_back(csg::CurvePoint{ pos, interp });
 	}
 
 	if (points.size() < 2) {
@@ -402,27 +506,24 @@ static boost::optional<csg::Curve> deserialize_curve(const std::string& curve, c
 	}
 }
 
-static boost::optional<csg::RGBCurveSlotValue> deserialize_rgb_curve(const std::string& rgb_curve)
+static boost::optional<csg::RGBCurveSlotValue> deserialize_rgb_curve(const boost::string_view rgb_curve, const size_t max_points)
 {
-	const boost::char_separator<char> sep{ "/" };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ rgb_curve, sep };
+	csc::Tokenizer tokens{ rgb_curve, '/' };
 
-	auto token_iter = tokenizer.begin();
-
-	if (iter_has_contents(token_iter, tokenizer.end(), 6) == false) {
+	if (tokens.has_tokens(6) == false) {
 		return boost::none;
 	}
 
-	const std::string curve_type{ *token_iter++ };
-	const std::string curve_version{ *token_iter++ };
+	const boost::string_view curve_type{ tokens.next() };
+	const boost::string_view curve_version{ tokens.next() };
 
 	const csc::Float2 min{ 0.0f, 0.0f };
 	const csc::Float2 max{ 1.0f, 1.0f };
 
-	const boost::optional<csg::Curve> opt_all{ deserialize_curve(*token_iter++, min, max) };
-	const boost::optional<csg::Curve> opt_r{ deserialize_curve(*token_iter++, min, max) };
-	const boost::optional<csg::Curve> opt_g{ deserialize_curve(*token_iter++, min, max) };
-	const boost::optional<csg::Curve> opt_b{ deserialize_curve(*token_iter++, min, max) };
+	const boost::optional<csg::Curve> opt_all{ deserialize_curve(tokens.next(), min, max, max_points) };
+	const boost::optional<csg::Curve> opt_r{ deserialize_curve(tokens.next(), min, max, max_points) };
+	const boost::optional<csg::Curve> opt_g{ deserialize_curve(tokens.next(), min, max, max_points) };
+	const boost::optional<csg::Curve> opt_b{ deserialize_curve(tokens.next(), min, max, max_points) };
 
 	csg::RGBCurveSlotValue result{};
 	if (opt_all) {
@@ -441,30 +542,27 @@ static boost::optional<csg::RGBCurveSlotValue> deserialize_rgb_curve(const std::
 	return result;
 }
 
-static boost::optional<csg::VectorCurveSlotValue> deserialize_vector_curve(const std::string& vector_curve)
+static boost::optional<csg::VectorCurveSlotValue> deserialize_vector_curve(const boost::string_view vector_curve, const size_t max_points)
 {
-	const boost::char_separator<char> sep{ "/" };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ vector_curve, sep };
-
-	auto token_iter = tokenizer.begin();
+	csc::Tokenizer tokens{ vector_curve, '/' };
 
-	if (iter_has_contents(token_iter, tokenizer.end(), 7) == false) {
+	if (tokens.has_tokens(7) == false) {
 		return boost::none;
 	}
 
-	const std::string curve_type{ *token_iter++ };
-	const std::string curve_version{ *token_iter++ };
-	const csc::Float2 min{ my_stof2(*token_iter++) };
-	const csc::Float2 max{ my_stof2(*token_iter++) };
+	const boost::string_view curve_type{ tokens.next() };
+	const boost::string_view curve_version{ tokens.next() };
+	const csc::Float2 min{ my_stof2(tokens.next()) };
+	const csc::Float2 max{ my_stof2(tokens.next()) };
 
 	// Check validity of min and max before proceeding
 	if (min.x >= max.x || min.y >= max.y) {
 		return boost::none;
 	}
 
-	const boost::optional<csg::Curve> opt_x{ deserialize_curve(*token_iter++, min, max) };
-	const boost::optional<csg::Curve> opt_y{ deserialize_curve(*token_iter++, min, max) };
-	const boost::optional<csg::Curve> opt_z{ deserialize_curve(*token_iter++, min, max) };
+	const boost::optional<csg::Curve> opt_x{ deserialize_curve(tokens.next(), min, max, max_points) };
+	const boost::optional<csg::Curve> opt_y{ deserialize_curve(tokens.next(), min, max, max_points) };
+	const boost::optional<csg::Curve> opt_z{ deserialize_curve(tokens.next(), min, max, max_points) };
 
 	csg::VectorCurveSlotValue result{ min, max };
 	if (opt_x) {
@@ -482,26 +580,23 @@ static boost::optional<csg::VectorCurveSlotValue> deserialize_vector_curve(const
 
 // For deserializing the old curve format
 // This program can only read this format, not write it
-static boost::optional<csg::Curve> deserialize_legacy_curve(const std::string& curve_string)
+static boost::optional<csg::Curve> deserialize_legacy_curve(const boost::string_view curve_string, const size_t max_points)
 {
-	const boost::char_separator<char> sep{ "," };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ curve_string, sep };
+	csc::Tokenizer tokens{ curve_string, ',' };
 
-	auto token_iter{ tokenizer.begin() };
-
-	if (iter_has_contents(token_iter, tokenizer.end(), 3) == false) {
+	if (tokens.has_tokens(3) == false) {
 		return boost::none;
 	}
 
-	const std::string identifier = *token_iter++;
-	const std::string interpolation_str = *token_iter++;
-	const std::string control_point_count_str = *token_iter++;
+	const boost::string_view identifier{ tokens.next() };
+	const boost::string_view interpolation_str{ tokens.next() };
+	const boost::string_view control_point_count_str{ tokens.next() };
 
 	if (identifier != "curve00") {
 		return boost::none;
 	}
 
-	const auto get_interp_type = [](const std::string& name) -> csg::CurveInterp
+	const auto get_interp_type = [](const boost::string_view name) -> csg::CurveInterp
 	{
 		if (name == "cubic_hermite") {
 			return csg::CurveInterp::CUBIC_HERMITE;
@@ -512,17 +607,21 @@ static boost::optional<csg::Curve> deserialize_legacy_curve(const std::string& c
 	};
 	const csg::CurveInterp point_interp{ get_interp_type(interpolation_str) };
 
-	const size_t point_count{ static_cast<size_t>(my_stoi(control_point_count_str)) };
+	const int point_count_int{ csc::parse_int(control_point_count_str) };
+	if (point_count_int < 0 || static_cast<size_t>(point_count_int) > max_points) {
+		return boost::none;
+	}
+	const size_t point_count{ static_cast<size_t>(point_count_int) };
 
-	if (iter_has_contents(token_iter, tokenizer.end(), point_count * 2) == false) {
+	if (tokens.has_tokens(point_count * 2) == false) {
 		return boost::none;
 	}
 
 	const csc::FloatRect valid_rect{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f} };
 	std::vector<csg::CurvePoint> points;
 	for (size_t i = 0; i < point_count; i++) {
-		const float x{ my_stof(*token_iter++) };
-		const float y{ my_stof(*token_iter++) };
+		const float x{ csc::parse_float(tokens.next()) };
+		const float y{ csc::parse_float(tokens.next()) };
 		const csc::Float2 pos{ x, y };
 		if (valid_rect.contains(pos)) {
 			points.push_back(csg::CurvePoint{ pos, point_interp });
@@ -537,31 +636,31 @@ static boost::optional<csg::Curve> deserialize_legacy_curve(const std::string& c
 	return csg::Curve{ valid_rect.begin(), valid_rect.end(), points };
 }
 
-static boost::optional<csg::ColorRamp> deserialize_ramp(const std::string& ramp_string)
+static boost::optional<csg::ColorRamp> deserialize_ramp(const boost::string_view ramp_string, const size_t max_points)
 {
 	using namespace csg;
 
-	const boost::char_separator<char> sep{ "," };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ ramp_string, sep };
-
-	auto token_iter{ tokenizer.begin() };
+	csc::Tokenizer tokens{ ramp_string, ',' };
 
-	if (iter_has_contents(token_iter, tokenizer.end(), 1) == false) {
+	if (tokens.done()) {
 		return boost::none;
 	}
 
-	const std::string identifier = *token_iter++;
+	const boost::string_view identifier{ tokens.next() };
 	if (identifier != "ramp00") {
 		return boost::none;
 	}
 
 	std::vector<ColorRampPoint> ramp_points;
-	while (iter_has_contents(token_iter, tokenizer.end(), 5)) {
-		const float pos{ my_stof(*token_iter++) };
-		const float r{ my_stof(*token_iter++) };
-		const float g{ my_stof(*token_iter++) };
-		const float b{ my_stof(*token_iter++) };
-		const float a{ my_stof(*token_iter++) };
+	while (tokens.has_tokens(5)) {
+		if (ramp_points.size() >= max_points) {
+			return boost::none;
+		}
+		const float pos{ csc::parse_float(tokens.next()) };
+		const float r{ csc::parse_float(tokens.next()) };
+		const float g{ csc::parse_float(tokens.next()) };
+		const float b{ csc::parse_float(tokens.next()) };
+		const float a{ csc::parse_float(tokens.next()) };
 		const ColorRampPoint this_point{ pos, csc::Float3{ r, g, b }, a };
 		ramp_points.push_back(this_point);
 	}
@@ -573,315 +672,989 @@ static boost::optional<csg::ColorRamp> deserialize_ramp(const std::string& ramp_
 	return ColorRamp{ ramp_points };
 }
 
-boost::optional<csg::Graph> csg::deserialize_graph(const std::string& graph_string)
+// Advance tokens to one past the next NODE_END, returns true if a NODE_END was found
+static bool skip_past_node_end(csc::Tokenizer& tokens)
 {
-	const boost::char_separator<char> sep{ "|" };
-	const boost::tokenizer<boost::char_separator<char>> tokenizer{ graph_string, sep };
+	while (tokens.done() == false && tokens.front() != NODE_END) {
+		tokens.next();
+	}
+	if (tokens.done() == false) {
+		tokens.next();
+		return true;
+	}
+	return false;
+}
 
-	auto token_iter = tokenizer.begin();
+// Advance tokens past one node record, consuming the same tokens as parsing the record does
+// Returns false if the input ended before the record's NODE_END
+static bool skip_node_record(csc::Tokenizer& tokens)
+{
+	const boost::string_view type_code{ tokens.next() };
+	for (size_t i = 0; i < 3; i++) {
+		tokens.next();
+	}
+	if (get_type_from_name(type_code).has_value()) {
+		// Step over whole input/value pairs so a value can never be mistaken for the end of the record
+		while (tokens.done() == false && tokens.front() != NODE_END && tokens.has_tokens(2)) {
+			tokens.next();
+			tokens.next();
+		}
+	}
+	return skip_past_node_end(tokens);
+}
+
+// Number of threads used to parse a batch of node records
+static size_t node_parse_thread_count(const size_t record_count)
+{
+	if (record_count < PARALLEL_NODES_MIN) {
+		return 1;
+	}
+	// This is 0 if the number of cores is unknown, which parses on the calling thread
+	const size_t hardware_threads{ std::thread::hardware_concurrency() };
+	return std::min({ hardware_threads, PARALLEL_THREADS_MAX, record_count / PARALLEL_NODES_PER_THREAD });
+}
 
-	if (token_iter == tokenizer.end() || *token_iter != MAGIC_WORD) {
+// Slot types whose values are expensive enough to decode that loading can leave them as text
+static bool is_heavy_slot_type(const csg::SlotType type)
+{
+	return type == csg::SlotType::CURVE_RGB || type == csg::SlotType::CURVE_VECTOR || type == csg::SlotType::COLOR_RAMP;
+}
+
+// Value a TSlot would have after setting new_value on it
+template <typename TSlot, typename TRaw> static boost::optional<csg::SlotValue> decoded_slot_value(const csg::SlotValue& value, const boost::optional<TRaw>& new_value)
+{
+	const TSlot* const old_value{ value.as_ptr<TSlot>() };
+	if (old_value == nullptr || new_value.has_value() == false) {
 		return boost::none;
 	}
-	else {
-		++token_iter;
+	TSlot result{ *old_value };
+	result.set(new_value.value());
+	return csg::SlotValue{ result };
+}
+
+// Apply one input name/value pair from a serialized node to that node
+// With lazy_heavy_values set, curve and ramp values are stored on the node as text and decoded when first accessed
+static void read_input_value(csg::Node& node, const boost::string_view input_name, const boost::string_view input_value, const csg::DeserializeOptions& options)
+{
+	using namespace csg;
+
+	if (input_value.size() > options.max_value_length) {
+		return;
 	}
 
-	if (token_iter == tokenizer.end() || *token_iter != VERSION_INPUT) {
-		return boost::none;
+	const size_t max_points{ options.max_curve_points };
+	const boost::optional<size_t> opt_slot_index{ node.slot_index(SlotDirection::INPUT, input_name) };
+	if (opt_slot_index.has_value()) {
+		// Only curve and ramp values are ever left undecoded, so other values can be read without decoding
+		const Slot& slot{ node.slots()[*opt_slot_index] };
+		const SlotValue* const value{ node.slot_value_ptr_without_decoding(*opt_slot_index) };
+		if (options.lazy_heavy_values && is_heavy_slot_type(slot.type())) {
+			node.set_undecoded_value(*opt_slot_index, input_value, max_points);
+		}
+		else if (value != nullptr) {
+			const size_t slot_index{ *opt_slot_index };
+			// Choose how we interpret 'input_value' based on the slot type
+			switch (slot.type()) {
+			case SlotType::BOOL:
+			{
+				const bool bool_value{ static_cast<bool>(csc::parse_int(input_value)) };
+				node.set_slot_value<BoolSlotValue>(slot_index, bool_value);
+				break;
+			}
+			case SlotType::COLOR:
+			{
+				const csc::Float3 float3_value{ my_stof3(input_value) };
+				node.set_slot_value<ColorSlotValue>(slot_index, float3_value);
+				break;
+			}
+			case SlotType::ENUM:
+			{
+				const EnumSlotValue* const slot_value{ value->as_ptr<EnumSlotValue>() };
+				if (slot_value) {
+					const boost::optional<size_t> option{ NodeEnumOptionInfo::find(slot_value->get_meta(), input_value) };
+					if (option) {
+						node.set_slot_value<EnumSlotValue>(slot_index, *option);
+					}
+				}
+				break;
+			}
+			case SlotType::FLOAT:
+			{
+				const float float_value{ csc::parse_float(input_value) };
+				node.set_slot_value<FloatSlotValue>(slot_index, float_value);
+				break;
+			}
+			case SlotType::INT:
+			{
+				const int int_value{ csc::parse_int(input_value) };
+				node.set_slot_value<IntSlotValue>(slot_index, int_value);
+				break;
+			}
+			case SlotType::VECTOR:
+			{
+				const csc::Float3 float3_value{ my_stof3(input_value) };
+				node.set_slot_value<VectorSlotValue>(slot_index, float3_value);
+				break;
+			}
+			case SlotType::CURVE_RGB:
+			{
+				const boost::optional<csg::RGBCurveSlotValue> opt_curve_value{ deserialize_rgb_curve(input_value, max_points) };
+				if (opt_curve_value) {
+					node.set_slot_value<RGBCurveSlotValue>(slot_index, *opt_curve_value);
+				}
+				break;
+			}
+			case SlotType::CURVE_VECTOR:
+			{
+				const boost::optional<csg::VectorCurveSlotValue> opt_curve_value{ deserialize_vector_curve(input_value, max_points) };
+				if (opt_curve_value) {
+					node.set_slot_value<VectorCurveSlotValue>(slot_index, *opt_curve_value);
+				}
+				break;
+			}
+			case SlotType::COLOR_RAMP:
+			{
+				const boost::optional<csg::ColorRamp> opt_ramp_value{ deserialize_ramp(input_value, max_points) };
+				if (opt_ramp_value) {
+					node.set_slot_value<ColorRampSlotValue>(slot_index, *opt_ramp_value);
+				}
+				break;
+			}
+			default:
+				// Not a type we know how to parse from a string, do nothing
+				break;
+			}
+		}
 	}
 	else {
-		++token_iter;
+		// Here we can handle old parameters that don't exist anymore and translate them if possible
+		if (node.type() == csg::NodeType::RGB_CURVES) {
+			const boost::optional<csg::Curve> new_curve{ deserialize_legacy_curve(input_value, max_points) };
+			if (new_curve) {
+				const boost::optional<size_t> slot_index{ node.slot_index(csg::SlotDirection::INPUT, "curves") };
+				if (slot_index) {
+					const boost::optional<csg::Slot> slot{ node.slot(*slot_index) };
+					if (slot && slot->type() == csg::SlotType::CURVE_RGB) {
+						if (const csg::RGBCurveSlotValue* const old_curve{ node.slot_value_ptr<csg::RGBCurveSlotValue>(*slot_index) }) {
+							csg::RGBCurveSlotValue rgb_curve{ *old_curve };
+							if (input_name == "rgb_curve") {
+								rgb_curve.set_all(*new_curve);
+								node.set_slot_value<csg::RGBCurveSlotValue>(*slot_index, rgb_curve);
+							}
+							else if (input_name == "r_curve") {
+								rgb_curve.set_r(*new_curve);
+								node.set_slot_value<csg::RGBCurveSlotValue>(*slot_index, rgb_curve);
+							}
+							else if (input_name == "g_curve") {
+								rgb_curve.set_g(*new_curve);
+								node.set_slot_value<csg::RGBCurveSlotValue>(*slot_index, rgb_curve);
+							}
+							else if (input_name == "b_curve") {
+								rgb_curve.set_b(*new_curve);
+								node.set_slot_value<csg::RGBCurveSlotValue>(*slot_index, rgb_curve);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+boost::optional<csg::SlotValue> csg::decode_slot_value(const SlotValue& value, const boost::string_view text, const size_t max_points)
+{
+	switch (value.type()) {
+		case SlotType::CURVE_RGB:
+			return decoded_slot_value<RGBCurveSlotValue>(value, deserialize_rgb_curve(text, max_points));
+		case SlotType::CURVE_VECTOR:
+			return decoded_slot_value<VectorCurveSlotValue>(value, deserialize_vector_curve(text, max_points));
+		case SlotType::COLOR_RAMP:
+			return decoded_slot_value<ColorRampSlotValue>(value, deserialize_ramp(text, max_points));
+		default:
+			return boost::none;
+	}
+}
+
+std::string csg::serialize_graph(const Graph& graph, const SerializedFormat format)
+{
+	switch (format) {
+		case SerializedFormat::BINARY:
+			return serialize_graph_binary(graph);
+		case SerializedFormat::COMPRESSED:
+			return compress_serialized_graph(serialize_graph_text(graph));
+		case SerializedFormat::TEXT:
+		default:
+			return serialize_graph_text(graph);
 	}
+}
 
-	csg::Graph result{ GraphType::EMPTY };
+boost::optional<csg::Graph> csg::deserialize_graph(const boost::string_view graph_string, const DeserializeOptions& options)
+{
+	GraphStreamParser parser{ nullptr, options };
+	parser.feed(graph_string);
+	return parser.finish();
+}
 
-	// Advance iterator until we find the start of the node section
-	while (token_iter != tokenizer.end() && *token_iter != SECTION_NODES) {
-		token_iter++;
+boost::optional<csg::Graph> csg::deserialize_graph(std::istream& input, const DeserializeOptions& options)
+{
+	GraphStreamParser parser{ nullptr, options };
+	if (parser.feed(input) == false) {
+		return boost::none;
 	}
+	return parser.finish();
+}
 
-	if (token_iter == tokenizer.end()) {
-		// No nodes or connection section in the input, return empty graph
-		return result;
+boost::optional<csg::Graph> csg::deserialize_graph_fd(const int fd, const DeserializeOptions& options)
+{
+	GraphStreamParser parser{ nullptr, options };
+	if (parser.feed_fd(fd) == false) {
+		return boost::none;
 	}
+	return parser.finish();
+}
 
-	// Map to let us look up node ids by name
-	// This will be needed for building connections later in this function
-	std::map<std::string, NodeId> ids_by_name;
-
-	// Advance token to the start of the first node
-	token_iter++;
-
-	// Loop adding nodes until we see the connections header
-	while (token_iter != tokenizer.end() && *token_iter != SECTION_CONNECTIONS) {
-		constexpr size_t NODE_MIN_TOKENS{ 5 }; // type, name, x, y, node_end
-		if (iter_has_contents(token_iter, tokenizer.end(), NODE_MIN_TOKENS) == false) {
-			// Not enough tokens exist to form a node, end here
-			return result;
-		}
-		assert(token_iter != tokenizer.end());
-		const std::string type_code{ *token_iter++ };
-		assert(token_iter != tokenizer.end());
-		const std::string node_name{ *token_iter++ };
-		assert(token_iter != tokenizer.end());
-		const int x{ my_stoi(*token_iter++) };
-		assert(token_iter != tokenizer.end());
-		const int y{ my_stoi(*token_iter++) };
-
-		const boost::optional<NodeType> opt_node_type{ get_type_from_name(type_code) };
-		if (opt_node_type.has_value() == false) {
-			// We do not recognize this type code
-			// Advance the iterator past this node and continue
-			while (token_iter != tokenizer.end() && *token_iter != NODE_END) {
-				token_iter++;
-			}
-			if (*token_iter == NODE_END) {
-				token_iter++;
+csg::GraphStreamParser::GraphStreamParser(const std::function<void(const GraphStreamProgress&)> progress_callback, const DeserializeOptions options) :
+	progress_callback{ progress_callback },
+	options{ options },
+	graph{ std::make_unique<Graph>(GraphType::EMPTY) }
+{
+
+}
+
+csg::GraphStreamParser::~GraphStreamParser()
+{
+
+}
+
+void csg::GraphStreamParser::feed(const boost::string_view data)
+{
+	_progress.bytes_read += data.size();
+
+	if (state == State::BINARY || state == State::COMPRESSED) {
+		buffer.append(data.data(), data.size());
+	}
+	else if (state != State::DONE && state != State::FAILED) {
+		if (buffer.empty()) {
+			// Parse straight from the input and only keep the incomplete record at the end
+			const size_t consumed{ consume(data, false) };
+			buffer.assign(data.data() + consumed, data.size() - consumed);
+			rescan_size = buffer.size() * 2;
+		}
+		else {
+			buffer.append(data.data(), data.size());
+			// A record split over many small chunks is only scanned again once the buffer has doubled, which keeps parsing linear
+			if (buffer.size() >= rescan_size) {
+				const size_t consumed{ consume(buffer, false) };
+				buffer.erase(0, consumed);
+				rescan_size = buffer.size() * 2;
 			}
-			continue;
 		}
+	}
 
-		const boost::optional<NodeId> opt_node_id{ node_id_from_name(node_name) };
-		NodeId node_id;
-		if (opt_node_id.has_value()) {
-			node_id = opt_node_id.value();
-			if (result.add(opt_node_type.value(), csc::Int2{ x, y }, node_id) == false) {
-				// This node was not added because it is a duplicate id
-				// This can randomly happen but should be very rare (birthday problem with a 64 bit number)
-				// except in malformed graphs
-				return boost::none;
-			}
+	if (progress_callback) {
+		progress_callback(_progress);
+	}
+}
+
+bool csg::GraphStreamParser::feed(std::istream& input)
+{
+	std::array<char, STREAM_CHUNK_SIZE> chunk;
+	while (input.good() && state != State::FAILED) {
+		input.read(chunk.data(), chunk.size());
+		const std::streamsize read_size{ input.gcount() };
+		if (read_size > 0) {
+			feed(boost::string_view{ chunk.data(), static_cast<size_t>(read_size) });
 		}
-		else {
-			node_id = result.add(opt_node_type.value(), csc::Int2{ x, y });
+	}
+	return input.eof() || state == State::FAILED;
+}
+
+bool csg::GraphStreamParser::feed_fd(const int fd)
+{
+	std::array<char, STREAM_CHUNK_SIZE> chunk;
+	while (state != State::FAILED) {
+#ifdef _WIN32
+		const int read_size{ _read(fd, chunk.data(), static_cast<unsigned int>(chunk.size())) };
+#else
+		const ssize_t read_size{ read(fd, chunk.data(), chunk.size()) };
+		if (read_size < 0 && errno == EINTR) {
+			continue;
 		}
-		
-		if (ids_by_name.count(node_name) != 0) {
-			// This name has already been used
-			// The graph is invalid, abort processing here
+#endif
+		if (read_size < 0) {
+			return false;
+		}
+		if (read_size == 0) {
+			break;
+		}
+		feed(boost::string_view{ chunk.data(), static_cast<size_t>(read_size) });
+	}
+	return true;
+}
+
+boost::optional<csg::Graph> csg::GraphStreamParser::finish()
+{
+	if (state != State::BINARY && state != State::COMPRESSED) {
+		consume(buffer, true);
+	}
+
+	if (state == State::BINARY) {
+		state = State::DONE;
+		const boost::optional<Graph> result{ deserialize_graph_binary(buffer, options) };
+		buffer.clear();
+		return result;
+	}
+	if (state == State::COMPRESSED) {
+		state = State::DONE;
+		const boost::optional<std::string> opt_decompressed{ decompress_serialized_graph(buffer, options.max_decompressed_size) };
+		buffer.clear();
+		if (opt_decompressed.has_value() == false) {
 			return boost::none;
 		}
-		ids_by_name[node_name] = node_id;
-
-		// Load in all input/value pairs
-		while (token_iter != tokenizer.end() && *token_iter != NODE_END && iter_has_contents(token_iter, tokenizer.end(), 2)) {
-			assert(token_iter != tokenizer.end());
-			const std::string input_name{ *token_iter++ };
-			assert(token_iter != tokenizer.end());
-			const std::string input_value{ *token_iter++ };
-
-			const std::shared_ptr<const Node> node{ result.get(node_id) };
-			assert(node.use_count() > 0);
-
-			const boost::optional<size_t> opt_slot_index{ node->slot_index(SlotDirection::INPUT, input_name) };
-			if (opt_slot_index.has_value()) {
-				const boost::optional<Slot> opt_slot = node->slot(*opt_slot_index);
-				assert(opt_slot.has_value());
-				if (opt_slot->value.has_value()) {
-					const SlotId slot_id{ node->id(), *opt_slot_index };
-					// Choose how we interpret 'input_value' based on the slot type
-					switch (opt_slot.value().type()) {
-					case SlotType::BOOL:
-					{
-						const bool bool_value{ static_cast<bool>(my_stoi(input_value)) };
-						result.set_bool(slot_id, bool_value);
-						break;
-					}
-					case SlotType::COLOR:
-					{
-						const csc::Float3 float3_value{ my_stof3(input_value) };
-						result.set_color(slot_id, float3_value);
-						break;
-					}
-					case SlotType::ENUM:
-					{
-						const boost::optional<EnumSlotValue> slot_value{ opt_slot->value->as<EnumSlotValue>() };
-						if (slot_value) {
-							const NodeMetaEnum meta_enum{ slot_value->get_meta() };
-							assert(NodeEnumInfo::from(meta_enum).has_value());
-							const NodeEnumInfo enum_info{ NodeEnumInfo::from(meta_enum).value() };
-							// Loop though all available internal names to look for a match
-							for (size_t i = 0; i < enum_info.count(); i++) {
-								assert(NodeEnumOptionInfo::from(meta_enum, i).has_value());
-								const NodeEnumOptionInfo option_info{ NodeEnumOptionInfo::from(meta_enum, i).value() };
-								if (input_value == option_info.internal_name()) {
-									// Match the regular internal name
-									result.set_enum(slot_id, i);
-									break;
-								}
-								else if (option_info.alt_name() && input_value == option_info.alt_name()) {
-									// Match the alternate name if it exists
-									result.set_enum(slot_id, i);
-									break;
-								}
-							}
-						}
-						break;
-					}
-					case SlotType::FLOAT:
-					{
-						const float float_value{ my_stof(input_value) };
-						result.set_float(slot_id, float_value);
-						break;
-					}
-					case SlotType::INT:
-					{
-						const int int_value{ my_stoi(input_value) };
-						result.set_int(slot_id, int_value);
-						break;
+		return deserialize_graph(*opt_decompressed, options);
+	}
+	buffer.clear();
+
+	if (state == State::FAILED) {
+		return boost::none;
+	}
+	assert(state == State::DONE);
+	return std::move(*graph);
+}
+
+size_t csg::GraphStreamParser::consume(const boost::string_view data, const bool at_end)
+{
+	if (state == State::HEADER && is_binary_graph(data)) {
+		// Binary graphs are offset based and are only read once all input is buffered
+		state = State::BINARY;
+		return 0;
+	}
+	if (state == State::HEADER && is_compressed_graph(data)) {
+		// The compressed payload is decoded in one piece once all input is buffered
+		state = State::COMPRESSED;
+		return 0;
+	}
+
+	// A token is only complete once the separator after it has arrived, or at the end of input
+	size_t complete_size{ data.size() };
+	if (at_end == false) {
+		const size_t last_separator{ data.rfind('|') };
+		complete_size = (last_separator == boost::string_view::npos) ? 0 : last_separator + 1;
+	}
+	csc::Tokenizer tokens{ data.substr(0, complete_size), '|' };
+
+	while (true) {
+		switch (state) {
+			case State::HEADER:
+				if (tokens.has_tokens(2) == false) {
+					if (at_end) {
+						state = State::FAILED;
 					}
-					case SlotType::VECTOR:
-					{
-						const csc::Float3 float3_value{ my_stof3(input_value) };
-						result.set_vector(slot_id, float3_value);
-						break;
+					return tokens.position();
+				}
+				if (tokens.next() != MAGIC_WORD || tokens.next() != VERSION_INPUT) {
+					state = State::FAILED;
+					return tokens.position();
+				}
+				state = State::SEEK_NODES;
+				break;
+			case State::SEEK_NODES:
+				// Advance tokens until we find the start of the node section
+				while (tokens.done() == false && tokens.front() != SECTION_NODES) {
+					tokens.next();
+				}
+				if (tokens.done()) {
+					if (at_end) {
+						// No nodes or connection section in the input, result is an empty graph
+						state = State::DONE;
 					}
-					case SlotType::CURVE_RGB:
-					{
-						const boost::optional<csg::RGBCurveSlotValue> opt_curve_value{ deserialize_rgb_curve(input_value) };
-						if (opt_curve_value) {
-							result.set_curve_rgb(slot_id, *opt_curve_value);
-						}
+					return tokens.position();
+				}
+				tokens.next();
+				state = State::NODES;
+				break;
+			case State::NODES:
+			{
+				// Find where every complete node record ends, then parse them all as one batch
+				std::vector<boost::string_view> records;
+				bool section_ended{ false };
+				while (tokens.done() == false) {
+					if (tokens.front() == SECTION_CONNECTIONS) {
+						section_ended = true;
 						break;
 					}
-					case SlotType::CURVE_VECTOR:
-					{
-						const boost::optional<csg::VectorCurveSlotValue> opt_curve_value{ deserialize_vector_curve(input_value) };
-						if (opt_curve_value) {
-							result.set_curve_vec(slot_id, *opt_curve_value);
-						}
+					constexpr size_t NODE_MIN_TOKENS{ 5 }; // type, name, x, y, node_end
+					if (tokens.has_tokens(NODE_MIN_TOKENS) == false) {
 						break;
 					}
-					case SlotType::COLOR_RAMP:
-					{
-						const boost::optional<csg::ColorRamp> opt_ramp_value{ deserialize_ramp(input_value) };
-						if (opt_ramp_value) {
-							result.set_color_ramp(slot_id, *opt_ramp_value);
-						}
+					csc::Tokenizer record_end{ tokens };
+					if (skip_node_record(record_end) == false && at_end == false) {
+						// Wait for the rest of this record, at the end of input it is read as far as it goes
 						break;
 					}
-					default:
-						// Not a type we know how to parse from a string, do nothing
-						break;
+					if (graph->nodes().size() + records.size() >= options.max_node_count) {
+						state = State::FAILED;
+						return tokens.position();
 					}
+					records.push_back(data.substr(tokens.position(), record_end.position() - tokens.position()));
+					tokens = record_end;
+				}
+				if (read_nodes(records) == false) {
+					state = State::FAILED;
+					return tokens.position();
+				}
+				if (section_ended) {
+					tokens.next();
+					state = State::CONNECTIONS;
+					break;
 				}
+				if (at_end) {
+					// Either the input ended or not enough tokens exist to form a node, end here
+					state = State::DONE;
+				}
+				return tokens.position();
 			}
-			else {
-				// Here we can handle old parameters that don't exist anymore and translate them if possible
-				if (opt_node_type == csg::NodeType::RGB_CURVES) {
-					const boost::optional<csg::Curve> new_curve{ deserialize_legacy_curve(input_value) };
-					if (new_curve) {
-						const boost::optional<size_t> slot_index{ node->slot_index(csg::SlotDirection::INPUT, "curves") };
-						if (slot_index) {
-							const boost::optional<csg::Slot> slot{ node->slot(*slot_index) };
-							if (slot && slot->type() == csg::SlotType::CURVE_RGB) {
-								const boost::optional<csg::RGBCurveSlotValue> opt_curve{ slot->value->as<csg::RGBCurveSlotValue>() };
-								if (opt_curve) {
-									csg::RGBCurveSlotValue rgb_curve{ *opt_curve };
-									if (input_name == "rgb_curve") {
-										rgb_curve.set_all(*new_curve);
-										result.set_curve_rgb(csg::SlotId{ node_id, *slot_index }, rgb_curve);
-									}
-									else if (input_name == "r_curve") {
-										rgb_curve.set_r(*new_curve);
-										result.set_curve_rgb(csg::SlotId{ node_id, *slot_index }, rgb_curve);
-									}
-									else if (input_name == "g_curve") {
-										rgb_curve.set_g(*new_curve);
-										result.set_curve_rgb(csg::SlotId{ node_id, *slot_index }, rgb_curve);
-									}
-									else if (input_name == "b_curve") {
-										rgb_curve.set_b(*new_curve);
-										result.set_curve_rgb(csg::SlotId{ node_id, *slot_index }, rgb_curve);
-									}
-								}
-							}
-						}
+			case State::CONNECTIONS:
+			{
+				constexpr size_t CONNECTION_TOKENS{ 4 };
+				if (tokens.has_tokens(CONNECTION_TOKENS) == false) {
+					if (at_end) {
+						// Not enough tokens left for a full connection, end early
+						state = State::DONE;
 					}
+					return tokens.position();
 				}
+				if (connection_record_count >= options.max_connection_count) {
+					state = State::FAILED;
+					return tokens.position();
+				}
+				connection_record_count++;
+				read_connection(tokens);
+				break;
 			}
+			case State::BINARY:
+			case State::COMPRESSED:
+			case State::DONE:
+			case State::FAILED:
+			default:
+				return tokens.position();
 		}
+	}
+}
+
+// A node record that has been parsed but not yet added to the graph
+struct csg::GraphStreamParser::ParsedNode {
+	boost::string_view name;
+	bool has_encoded_id{ false };
+	// Empty if the type code is not recognized
+	boost::optional<Node> node;
+};
+
+csg::GraphStreamParser::ParsedNode csg::GraphStreamParser::parse_node_record(const boost::string_view record) const
+{
+	csc::Tokenizer tokens{ record, '|' };
+	const boost::string_view type_code{ tokens.next() };
+	const boost::string_view node_name{ tokens.next() };
+	const int x{ csc::parse_int(tokens.next()) };
+	const int y{ csc::parse_int(tokens.next()) };
+
+	ParsedNode result;
+	result.name = node_name;
+
+	const boost::optional<NodeType> opt_node_type{ get_type_from_name(type_code) };
+	if (opt_node_type.has_value() == false) {
+		return result;
+	}
+
+	const boost::optional<NodeId> opt_node_id{ node_id_from_name(node_name) };
+	if (opt_node_id.has_value()) {
+		result.has_encoded_id = true;
+		result.node = Node{ opt_node_type.value(), csc::Int2{ x, y }, opt_node_id.value() };
+	}
+	else {
+		result.node = Node{ opt_node_type.value(), csc::Int2{ x, y } };
+	}
+
+	// Load in all input/value pairs
+	while (tokens.done() == false && tokens.front() != NODE_END && tokens.has_tokens(2)) {
+		const boost::string_view input_name{ tokens.next() };
+		const boost::string_view input_value{ tokens.next() };
+		read_input_value(*result.node, input_name, input_value, options);
+	}
 
-		// Advance to one past the next NODE_END and continue loop
-		while (token_iter != tokenizer.end() && *token_iter != NODE_END) {
-			token_iter++;
+	return result;
+}
+
+bool csg::GraphStreamParser::read_nodes(const std::vector<boost::string_view>& records)
+{
+	const size_t thread_count{ node_parse_thread_count(records.size()) };
+	if (thread_count <= 1) {
+		for (const boost::string_view record : records) {
+			ParsedNode parsed{ parse_node_record(record) };
+			if (add_parsed_node(parsed) == false) {
+				return false;
+			}
 		}
-		if (*token_iter == NODE_END) {
-			token_iter++;
+		return true;
+	}
+
+	// Each thread parses one contiguous range of records into its own buffer
+	const size_t records_per_thread{ (records.size() + thread_count - 1) / thread_count };
+	std::vector<std::vector<ParsedNode>> thread_results(thread_count);
+	std::vector<std::thread> threads;
+	for (size_t thread_index = 0; thread_index < thread_count; thread_index++) {
+		const size_t begin{ std::min(thread_index * records_per_thread, records.size()) };
+		const size_t end{ std::min(begin + records_per_thread, records.size()) };
+		std::vector<ParsedNode>& results{ thread_results[thread_index] };
+		threads.emplace_back([this, &records, &results, begin, end]() {
+			results.reserve(end - begin);
+			for (size_t i = begin; i < end; i++) {
+				results.push_back(parse_node_record(records[i]));
+			}
+		});
+	}
+	for (std::thread& this_thread : threads) {
+		this_thread.join();
+	}
+
+	// Merge in input order so duplicate ids and names are rejected exactly as they are on one thread
+	for (std::vector<ParsedNode>& results : thread_results) {
+		for (ParsedNode& parsed : results) {
+			if (add_parsed_node(parsed) == false) {
+				return false;
+			}
 		}
 	}
+	return true;
+}
 
-	// Advance iterator until we find the start of the connection section
-	while (token_iter != tokenizer.end() && *token_iter != SECTION_CONNECTIONS) {
-		token_iter++;
+bool csg::GraphStreamParser::add_parsed_node(ParsedNode& parsed)
+{
+	if (parsed.node.has_value() == false) {
+		// We do not recognize this type code, skip this node
+		return true;
 	}
 
-	if (token_iter == tokenizer.end()) {
-		// No connections, return graph so far
-		return result;
+	if (parsed.has_encoded_id == false) {
+		// The id was rolled during parsing, roll again if it is taken as Graph::add would
+		while (graph->contains(parsed.node->id())) {
+			Node rerolled_node{ parsed.node->type(), parsed.node->position };
+			rerolled_node.copy_from(*parsed.node);
+			*parsed.node = std::move(rerolled_node);
+		}
 	}
 
-	// Advance token to the start of the first connection
-	token_iter++;
+	const NodeId node_id{ parsed.node->id() };
+	if (graph->add(std::move(*parsed.node)) == false) {
+		// This node was not added because it is a duplicate id
+		// This can randomly happen but should be very rare (birthday problem with a 64 bit number)
+		// except in malformed graphs
+		return false;
+	}
 
-	while (token_iter != tokenizer.end()) {
-		constexpr size_t CONNECTION_TOKENS{ 4 };
-		if (iter_has_contents(token_iter, tokenizer.end(), CONNECTION_TOKENS) == false) {
-			// Not enough tokens left for a full connection, end early
-			break;
+	if (ids_by_name.find(parsed.name) != ids_by_name.end()) {
+		// This name has already been used
+		// The graph is invalid, abort processing here
+		return false;
+	}
+	ids_by_name.emplace(parsed.name.to_string(), node_id);
+	_progress.node_count++;
+	return true;
+}
+
+void csg::GraphStreamParser::read_connection(csc::Tokenizer& tokens)
+{
+	const boost::string_view name_src{ tokens.next() };
+	const boost::string_view slot_src{ tokens.next() };
+	const boost::string_view name_dst{ tokens.next() };
+	const boost::string_view slot_dst{ tokens.next() };
+
+	const auto id_src_iter = ids_by_name.find(name_src);
+	const auto id_dst_iter = ids_by_name.find(name_dst);
+	if (id_src_iter == ids_by_name.end() || id_dst_iter == ids_by_name.end()) {
+		// Name does not reference a real node, skip this connection
+		return;
+	}
+	const NodeId id_src{ id_src_iter->second };
+	const NodeId id_dst{ id_dst_iter->second };
+
+	const auto node_src{ graph->get(id_src) };
+	const auto node_dst{ graph->get(id_dst) };
+	assert(node_src != nullptr);
+	assert(node_dst != nullptr);
+
+	const boost::optional<size_t> slot_index_src{ node_src->slot_index_by_disp_name(SlotDirection::OUTPUT, slot_src) };
+	const boost::optional<size_t> slot_index_dst{ node_dst->slot_index_by_disp_name(SlotDirection::INPUT, slot_dst) };
+	if (slot_index_src.has_value() == false || slot_index_dst.has_value() == false) {
+		return;
+	}
+
+	const SlotId src_slot_id{ id_src, slot_index_src.value() };
+	const SlotId dst_slot_id{ id_dst, slot_index_dst.value() };
+
+	if (graph->add_connection(src_slot_id, dst_slot_id)) {
+		_progress.connection_count++;
+	}
+}
+
+// Set of all connections that would be written by the serializer
+static std::set<csg::Connection> serializable_connections(const csg::Graph& graph)
+{
+	std::set<csg::Connection> result;
+	for (const csg::Connection& connection : graph.connections()) {
+		if (connection_is_serializable(graph, connection)) {
+			result.insert(connection);
+		}
+	}
+	return result;
+}
+
+std::string csg::serialize_graph_patch(const Graph& old_graph, const Graph& new_graph)
+{
+	const std::vector<const Node*> old_nodes{ sorted_nodes(old_graph) };
+	const std::vector<const Node*> new_nodes{ sorted_nodes(new_graph) };
+
+	// A node only counts as the same node if both id and type match, otherwise it is removed and added again
+	const auto same_node = [](const Node* const other, const Node& node) -> bool
+	{
+		return other != nullptr && other->type() == node.type();
+	};
+
+	std::string removed_section;
+	for (const Node* const old_node : old_nodes) {
+		if (same_node(new_graph.get(old_node->id()), *old_node) == false) {
+			append_node_name(removed_section, old_node->id());
+			removed_section += '|';
 		}
+	}
 
-		const std::string name_src{ *(token_iter++) };
-		const std::string slot_src{ *(token_iter++) };
-		const std::string name_dst{ *(token_iter++) };
-		const std::string slot_dst{ *(token_iter++) };
-		if (ids_by_name.count(name_src) == 0 || ids_by_name.count(name_dst) == 0) {
-			// Name does not reference a real node, skip this connection
+	std::string added_section;
+	std::string changed_section;
+	for (const Node* const new_node : new_nodes) {
+		const boost::optional<NodeTypeInfo> info{ NodeTypeInfo::from(new_node->type()) };
+		if (info.has_value() == false) {
 			continue;
 		}
-		const NodeId id_src{ ids_by_name[name_src] };
-		const NodeId id_dst{ ids_by_name[name_dst] };
-
-		// Find source slot
-		const auto node_src{ result.get(id_src) };
-		assert(node_src.use_count() > 0);
-		boost::optional<size_t> slot_index_src;
-		{
-			size_t current_index{ 0 };
-			for (const Slot this_slot : node_src->slots()) {
-				if (this_slot.dir() == csg::SlotDirection::OUTPUT && slot_src == this_slot.disp_name()) {
-					slot_index_src = current_index;
-					break;
-				}
-				current_index++;
+		const Node* const old_node{ old_graph.get(new_node->id()) };
+		if (same_node(old_node, *new_node) == false) {
+			append_node(added_section, *new_node, *info);
+			continue;
+		}
+
+		// Changed nodes use the same record as added ones, but only list values that differ
+		std::string changed_values;
+		for (size_t i = 0; i < new_node->slot_count(); i++) {
+			const Slot& new_slot{ new_node->slots()[i] };
+			const SlotValue* const new_value{ new_node->slot_value_ptr(i) };
+			if (new_slot.dir() == SlotDirection::INPUT && new_value != nullptr && *new_value != *old_node->slot_value_ptr(i)) {
+				changed_values += new_slot.name();
+				changed_values += '|';
+				append_slot_value(changed_values, *new_value);
+				changed_values += '|';
 			}
 		}
+		if (changed_values.empty() && new_node->position == old_node->position) {
+			continue;
+		}
+		changed_section += info->name();
+		changed_section += '|';
+		append_node_name(changed_section, new_node->id());
+		changed_section += '|';
+		csc::append_int(changed_section, new_node->position.x);
+		changed_section += '|';
+		csc::append_int(changed_section, new_node->position.y);
+		changed_section += '|';
+		changed_section += changed_values;
+		changed_section += NODE_END;
+		changed_section += '|';
+	}
 
-		// Find Dest slot
-		const auto node_dst{ result.get(id_dst) };
-		assert(node_dst.use_count() > 0);
-		boost::optional<size_t> slot_index_dst;
-		{
-			size_t current_index{ 0 };
-			for (const Slot this_slot : node_dst->slots()) {
-				if (this_slot.dir() == csg::SlotDirection::INPUT && slot_dst == this_slot.disp_name()) {
-					slot_index_dst = current_index;
-					break;
+	const std::set<Connection> old_connections{ serializable_connections(old_graph) };
+	const std::set<Connection> new_connections{ serializable_connections(new_graph) };
+
+	std::string removed_connection_section;
+	for (const Connection& connection : old_connections) {
+		if (new_connections.count(connection) == 0) {
+			append_connection(removed_connection_section, old_graph, connection);
+		}
+	}
+
+	std::string added_connection_section;
+	for (const Connection& connection : new_connections) {
+		if (old_connections.count(connection) == 0) {
+			append_connection(added_connection_section, new_graph, connection);
+		}
+	}
+
+	std::string result;
+	result += PATCH_MAGIC_WORD;
+	result += '|';
+	result += PATCH_VERSION_OUTPUT;
+	result += '|';
+	const std::pair<const char*, const std::string*> sections[]{
+		{ SECTION_REMOVED_NODES, &removed_section },
+		{ SECTION_ADDED_NODES, &added_section },
+		{ SECTION_CHANGED_NODES, &changed_section },
+		{ SECTION_REMOVED_CONNECTIONS, &removed_connection_section },
+		{ SECTION_ADDED_CONNECTIONS, &added_connection_section },
+	};
+	for (const auto& this_section : sections) {
+		result += this_section.first;
+		result += '|';
+		result += *this_section.second;
+	}
+	return result;
+}
+
+// One node record from a patch, values are views into the patch string
+struct PatchNode {
+	csg::NodeType type;
+	csg::NodeId id;
+	csc::Int2 position;
+	std::vector<std::pair<boost::string_view, boost::string_view>> values;
+};
+
+// One connection record from a patch, slots are display names
+struct PatchConnection {
+	csg::NodeId source_id;
+	boost::string_view source_slot;
+	csg::NodeId dest_id;
+	boost::string_view dest_slot;
+};
+
+struct GraphPatch {
+	std::vector<csg::NodeId> removed_nodes;
+	std::vector<PatchNode> added_nodes;
+	std::vector<PatchNode> changed_nodes;
+	std::vector<PatchConnection> removed_connections;
+	std::vector<PatchConnection> added_connections;
+};
+
+static bool is_patch_section(const boost::string_view token)
+{
+	return token == SECTION_REMOVED_NODES || token == SECTION_ADDED_NODES || token == SECTION_CHANGED_NODES ||
+		token == SECTION_REMOVED_CONNECTIONS || token == SECTION_ADDED_CONNECTIONS;
+}
+
+// Patches are written by this program, so unlike full graphs any malformed record rejects the whole patch
+static boost::optional<PatchNode> read_patch_node(csc::Tokenizer& tokens)
+{
+	if (tokens.has_tokens(5) == false) {
+		return boost::none;
+	}
+	const boost::optional<csg::NodeType> opt_type{ get_type_from_name(tokens.next()) };
+	const boost::optional<csg::NodeId> opt_id{ node_id_from_name(tokens.next()) };
+	const int x{ csc::parse_int(tokens.next()) };
+	const int y{ csc::parse_int(tokens.next()) };
+	if (opt_type.has_value() == false || opt_id.has_value() == false) {
+		return boost::none;
+	}
+
+	PatchNode result{ *opt_type, *opt_id, csc::Int2{ x, y }, {} };
+	while (tokens.done() == false && tokens.front() != NODE_END) {
+		if (tokens.has_tokens(2) == false) {
+			return boost::none;
+		}
+		const boost::string_view input_name{ tokens.next() };
+		const boost::string_view input_value{ tokens.next() };
+		result.values.push_back(std::make_pair(input_name, input_value));
+	}
+	if (tokens.done()) {
+		return boost::none;
+	}
+	tokens.next();
+	return result;
+}
+
+static boost::optional<PatchConnection> read_patch_connection(csc::Tokenizer& tokens)
+{
+	if (tokens.has_tokens(4) == false) {
+		return boost::none;
+	}
+	const boost::optional<csg::NodeId> opt_source_id{ node_id_from_name(tokens.next()) };
+	const boost::string_view source_slot{ tokens.next() };
+	const boost::optional<csg::NodeId> opt_dest_id{ node_id_from_name(tokens.next()) };
+	const boost::string_view dest_slot{ tokens.next() };
+	if (opt_source_id.has_value() == false || opt_dest_id.has_value() == false) {
+		return boost::none;
+	}
+	return PatchConnection{ *opt_source_id, source_slot, *opt_dest_id, dest_slot };
+}
+
+// Read one patch, stopping at the end of input or at the header of the next patch
+static boost::optional<GraphPatch> read_patch(csc::Tokenizer& tokens)
+{
+	if (tokens.done() || tokens.next() != PATCH_MAGIC_WORD) {
+		return boost::none;
+	}
+	if (tokens.done() || tokens.next() != PATCH_VERSION_INPUT) {
+		return boost::none;
+	}
+
+	GraphPatch result;
+	while (tokens.done() == false && tokens.front() != PATCH_MAGIC_WORD) {
+		const boost::string_view section{ tokens.next() };
+		if (is_patch_section(section) == false) {
+			return boost::none;
+		}
+		while (tokens.done() == false && is_patch_section(tokens.front()) == false && tokens.front() != PATCH_MAGIC_WORD) {
+			if (section == SECTION_REMOVED_NODES) {
+				const boost::optional<csg::NodeId> opt_id{ node_id_from_name(tokens.next()) };
+				if (opt_id.has_value() == false) {
+					return boost::none;
 				}
-				current_index++;
+				result.removed_nodes.push_back(*opt_id);
+			}
+			else if (section == SECTION_ADDED_NODES || section == SECTION_CHANGED_NODES) {
+				const boost::optional<PatchNode> opt_node{ read_patch_node(tokens) };
+				if (opt_node.has_value() == false) {
+					return boost::none;
+				}
+				std::vector<PatchNode>& nodes{ section == SECTION_ADDED_NODES ? result.added_nodes : result.changed_nodes };
+				nodes.push_back(*opt_node);
+			}
+			else {
+				const boost::optional<PatchConnection> opt_connection{ read_patch_connection(tokens) };
+				if (opt_connection.has_value() == false) {
+					return boost::none;
+				}
+				std::vector<PatchConnection>& connections{ section == SECTION_ADDED_CONNECTIONS ? result.added_connections : result.removed_connections };
+				connections.push_back(*opt_connection);
 			}
 		}
+	}
+	return result;
+}
 
-		if (slot_index_src.has_value() == false || slot_index_dst.has_value() == false) {
-			continue;
+static bool apply_patch(csg::Graph& graph, const GraphPatch& patch)
+{
+	using namespace csg;
+
+	// Everything is checked against the graph before anything is changed, so a rejected patch leaves the graph as it was
+	const std::set<NodeId> removed_ids{ patch.removed_nodes.begin(), patch.removed_nodes.end() };
+	for (const NodeId this_id : removed_ids) {
+		const Node* const node{ graph.get(this_id) };
+		if (node == nullptr || NodeTypeInfo::from(node->type())->category() == NodeCategory::OUTPUT) {
+			// Output nodes can never be removed from a graph
+			return false;
 		}
+	}
 
-		const SlotId src_slot_id{ id_src, slot_index_src.value() };
-		const SlotId dst_slot_id{ id_dst, slot_index_dst.value() };
+	// Stand-ins for added nodes, used to resolve slot names before the real nodes exist
+	std::map<NodeId, Node> added_nodes;
+	for (const PatchNode& this_node : patch.added_nodes) {
+		const bool exists_after_removal{ graph.contains(this_node.id) && removed_ids.count(this_node.id) == 0 };
+		if (exists_after_removal || added_nodes.count(this_node.id) != 0) {
+			return false;
+		}
+		added_nodes.emplace(this_node.id, Node{ this_node.type, this_node.position, this_node.id });
+	}
+	for (const PatchNode& this_node : patch.changed_nodes) {
+		const Node* const node{ graph.get(this_node.id) };
+		if (node == nullptr || node->type() != this_node.type || removed_ids.count(this_node.id) != 0) {
+			return false;
+		}
+	}
 
-		result.add_connection(src_slot_id, dst_slot_id);
+	// Find the node a connection refers to once node changes are applied
+	const auto node_after_patch = [&](const NodeId id) -> const Node*
+	{
+		const auto added_iter = added_nodes.find(id);
+		if (added_iter != added_nodes.end()) {
+			return &added_iter->second;
+		}
+		if (removed_ids.count(id) != 0) {
+			return nullptr;
+		}
+		return graph.get(id);
+	};
+	const auto resolve_connections = [&](const std::vector<PatchConnection>& connections, const bool after_patch) -> boost::optional<std::vector<Connection>>
+	{
+		std::vector<Connection> result;
+		for (const PatchConnection& this_connection : connections) {
+			const Node* const node_src{ after_patch ? node_after_patch(this_connection.source_id) : graph.get(this_connection.source_id) };
+			const Node* const node_dest{ after_patch ? node_after_patch(this_connection.dest_id) : graph.get(this_connection.dest_id) };
+			if (node_src == nullptr || node_dest == nullptr) {
+				return boost::none;
+			}
+			const boost::optional<size_t> slot_index_src{ node_src->slot_index_by_disp_name(SlotDirection::OUTPUT, this_connection.source_slot) };
+			const boost::optional<size_t> slot_index_dest{ node_dest->slot_index_by_disp_name(SlotDirection::INPUT, this_connection.dest_slot) };
+			if (slot_index_src.has_value() == false || slot_index_dest.has_value() == false) {
+				return boost::none;
+			}
+			result.push_back(Connection{ SlotId{ node_src->id(), *slot_index_src }, SlotId{ node_dest->id(), *slot_index_dest } });
+		}
+		return result;
+	};
+	const boost::optional<std::vector<Connection>> opt_removed_connections{ resolve_connections(patch.removed_connections, false) };
+	const boost::optional<std::vector<Connection>> opt_added_connections{ resolve_connections(patch.added_connections, true) };
+	if (opt_removed_connections.has_value() == false || opt_added_connections.has_value() == false) {
+		return false;
 	}
 
-	return result;
+	// Apply to a copy, which shares its nodes with graph, so a patch that only fails partway through still leaves graph as it was
+	Graph result{ graph };
+
+	// Apply in dependency order: connections away, nodes away, nodes in, connections in
+	for (const Connection& this_connection : *opt_removed_connections) {
+		const boost::optional<Connection> current_connection{ result.connection_to(this_connection.dest()) };
+		if (current_connection.has_value() && current_connection->source() == this_connection.source()) {
+			result.remove_connection(this_connection.dest());
+		}
+	}
+
+	// Connections that touch removed nodes go with them
+	result.remove(removed_ids);
+
+	const auto apply_values = [](Node& node, const PatchNode& this_node)
+	{
+		for (const auto& this_value : this_node.values) {
+			read_input_value(node, this_value.first, this_value.second, DeserializeOptions{});
+		}
+	};
+
+	for (const PatchNode& this_node : patch.added_nodes) {
+		Node new_node{ this_node.type, this_node.position, this_node.id };
+		apply_values(new_node, this_node);
+		if (result.add(std::move(new_node)) == false) {
+			return false;
+		}
+	}
+
+	for (const PatchNode& this_node : patch.changed_nodes) {
+		const Node* const node{ result.get(this_node.id) };
+		assert(node != nullptr);
+		Node changed_node{ *node };
+		apply_values(changed_node, this_node);
+		if (result.copy_node(this_node.id, changed_node) == false) {
+			return false;
+		}
+		result.set_position(this_node.id, this_node.position);
+	}
+
+	for (const Connection& this_connection : *opt_added_connections) {
+		// A connection the patch did not remove is still going into dest when the graph has drifted from the patch's base
+		const boost::optional<Connection> current_connection{ result.connection_to(this_connection.dest()) };
+		if (current_connection.has_value() && current_connection->source() != this_connection.source()) {
+			return false;
+		}
+		if (result.add_connection(this_connection.source(), this_connection.dest()) == false) {
+			return false;
+		}
+	}
+
+	graph = std::move(result);
+	return true;
+}
+
+bool csg::apply_graph_patch(Graph& graph, const boost::string_view patch_string)
+{
+	csc::Tokenizer tokens{ patch_string, '|' };
+	do {
+		const boost::optional<GraphPatch> opt_patch{ read_patch(tokens) };
+		if (opt_patch.has_value() == false || apply_patch(graph, *opt_patch) == false) {
+			return false;
+		}
+	} while (tokens.done() == false);
+	return true;
 }
@@ -1,12 +1,132 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include "node_id.h"
+
+namespace csc {
+	class Tokenizer;
+}
 
 namespace csg {
 	class Graph;
+	class Slot;
+	class SlotValue;
+
+	enum class SerializedFormat {
+		TEXT,
+		BINARY,
+		// The text format wrapped in the compressed format, see serialize_compressed.h
+		COMPRESSED,
+	};
+
+	struct DeserializeOptions {
+		// Keep curve and ramp values from text input as text until their slot is first accessed
+		// Values that are never accessed are written back unchanged by the text serializer
+		bool lazy_heavy_values{ false };
+
+		// Limits for untrusted input, the defaults are far beyond anything the editor creates
+		// A graph with more nodes or connections than this fails to load
+		size_t max_node_count{ 1 << 20 };
+		size_t max_connection_count{ 1 << 22 };
+		// A value longer than this is skipped and its slot keeps the default, this also bounds values kept undecoded
+		size_t max_value_length{ 1 << 20 };
+		// A curve or color ramp with more points than this is skipped the same way
+		size_t max_curve_points{ 1 << 12 };
+		// A compressed graph that expands to more than this fails to load
+		size_t max_decompressed_size{ 1 << 28 };
+	};
+
+	std::string serialize_graph(const Graph& graph, SerializedFormat format = SerializedFormat::TEXT);
+	// The format is detected from the header
+	// The input is parsed in place and only needs to stay alive until this function returns
+	boost::optional<Graph> deserialize_graph(boost::string_view graph_string, const DeserializeOptions& options = DeserializeOptions{});
+	// Read until the end of the stream or file descriptor, without first loading the whole input into memory
+	boost::optional<Graph> deserialize_graph(std::istream& input, const DeserializeOptions& options = DeserializeOptions{});
+	boost::optional<Graph> deserialize_graph_fd(int fd, const DeserializeOptions& options = DeserializeOptions{});
+
+	// Decode a curve or ramp value written by the text serializer into what value would hold after setting it
+	// Returns none if value is not a curve or ramp, or if the text is not valid or has more than max_points points
+	boost::optional<SlotValue> decode_slot_value(const SlotValue& value, boost::string_view text, size_t max_points);
+
+	// Describe the changes that turn old_graph into new_graph as a versioned text patch
+	std::string serialize_graph_patch(const Graph& old_graph, const Graph& new_graph);
+	// Apply a patch made by serialize_graph_patch, returns false and leaves graph unchanged if the patch does not fit it
+	// Several patches written back to back are applied in order, if one is rejected the patches before it stay applied
+	bool apply_graph_patch(Graph& graph, boost::string_view patch_string);
+
+	struct GraphStreamProgress {
+		size_t bytes_read{ 0 };
+		size_t node_count{ 0 };
+		size_t connection_count{ 0 };
+	};
+
+	/**
+	 * @brief Builds a graph from serialized input that arrives in chunks.
+	 * Text input is parsed as soon as each node or connection is complete, so only a partial record is ever buffered.
+	 * Binary and compressed input is detected from its header and is buffered until finish() is called.
+	 */
+	class GraphStreamParser {
+	public:
+		// The callback, if any, is called after each chunk is consumed
+		GraphStreamParser(std::function<void(const GraphStreamProgress&)> progress_callback = nullptr, DeserializeOptions options = DeserializeOptions{});
+		~GraphStreamParser();
+
+		void feed(boost::string_view data);
+		// Feed everything until the end of input, returns false if reading failed before the end was reached
+		bool feed(std::istream& input);
+		bool feed_fd(int fd);
+
+		// Call once all input has been fed, returns none if the input was not a valid graph
+		boost::optional<Graph> finish();
+
+		// True if the input is already known to be invalid and there is no point feeding more
+		bool failed() const { return state == State::FAILED; }
+		GraphStreamProgress progress() const { return _progress; }
+
+	private:
+		enum class State {
+			HEADER,
+			SEEK_NODES,
+			NODES,
+			CONNECTIONS,
+			BINARY,
+			COMPRESSED,
+			DONE,
+			FAILED,
+		};
+
+		// Process all complete records in data and return how many bytes were used
+		size_t consume(boost::string_view data, bool at_end);
+
+		struct ParsedNode;
+		// Node records do not depend on each other, so large batches are parsed on several threads and then added in order
+		ParsedNode parse_node_record(boost::string_view record) const;
+		bool read_nodes(const std::vector<boost::string_view>& records);
+		bool add_parsed_node(ParsedNode& parsed);
+		void read_connection(csc::Tokenizer& tokens);
+
+		std::function<void(const GraphStreamProgress&)> progress_callback;
+		const DeserializeOptions options;
+		GraphStreamProgress _progress;
+
+		State state{ State::HEADER };
+		// Unconsumed input, this is the whole input for binary and compressed graphs and at most one partial record for text
+		std::string buffer;
+		// Text input is not parsed again until the buffer reaches this size
+		size_t rescan_size{ 0 };
+		size_t connection_record_count{ 0 };
 
-	std::string serialize_graph(const Graph& graph);
-	boost::optional<Graph> deserialize_graph(const std::string& graph_string);
+		std::unique_ptr<Graph> graph;
+		std::map<std::string, NodeId, std::less<>> ids_by_name;
+	};
 }
@@ -0,0 +1,568 @@
+#include "serialize_binary.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "shader_core/rect.h"
+#include "shader_core/vector.h"
+
+#include "curves.h"
+#include "graph.h"
+#include "node.h"
+#include "node_id.h"
+#include "node_type.h"
+#include "ramp.h"
+#include "serialize.h"
+#include "slot.h"
+#include "slot_id.h"
+
+/*
+ * Layout of the binary format, all values are little-endian
+ * Every section begins on a 4-byte boundary so the file can be read in place
+ *
+ * Header, 32 bytes:
+ *   char[8] magic, u32 version, u32 node_count, u32 value_count, u32 connection_count, u32 data_word_count, u32 reserved
+ * Node table, 32 bytes each, sorted by id:
+ *   i64 id, u32 node type, i32 x, i32 y, u32 first value index, u32 value count, u32 reserved
+ * Value table, 20 bytes each, grouped by node:
+ *   u32 slot index, u32 slot type, u32[3] payload
+ * Connection table, 16 bytes each:
+ *   u32 source node index, u32 source slot index, u32 dest node index, u32 dest slot index
+ * Data words, 4 bytes each:
+ *   Packed curve and ramp points, referenced by the payload of those values as (first word, word count)
+ */
+
+static const char BINARY_MAGIC[8]{ 'c', 's', 'g', '_', 'b', 'i', 'n', '\0' };
+constexpr uint32_t BINARY_VERSION{ 1 };
+
+constexpr size_t HEADER_SIZE{ 32 };
+constexpr size_t NODE_RECORD_SIZE{ 32 };
+constexpr size_t VALUE_RECORD_SIZE{ 20 };
+constexpr size_t CONNECTION_RECORD_SIZE{ 16 };
+constexpr size_t DATA_WORD_SIZE{ 4 };
+
+constexpr uint32_t INTERP_LINEAR{ 0 };
+constexpr uint32_t INTERP_CUBIC_HERMITE{ 1 };
+
+static void append_u32(std::string& output, const uint32_t value)
+{
+	const char bytes[4]{
+		static_cast<char>(value & 0xff),
+		static_cast<char>((value >> 8) & 0xff),
+		static_cast<char>((value >> 16) & 0xff),
+		static_cast<char>((value >> 24) & 0xff)
+	};
+	output.append(bytes, sizeof(bytes));
+}
+
+static void append_i32(std::string& output, const int32_t value)
+{
+	append_u32(output, static_cast<uint32_t>(value));
+}
+
+static void append_i64(std::string& output, const int64_t value)
+{
+	const uint64_t bits{ static_cast<uint64_t>(value) };
+	append_u32(output, static_cast<uint32_t>(bits & 0xffffffff));
+	append_u32(output, static_cast<uint32_t>(bits >> 32));
+}
+
+static uint32_t float_bits(const float value)
+{
+	uint32_t result;
+	std::memcpy(&result, &value, sizeof(float));
+	return result;
+}
+
+static uint32_t read_u32(const char* const data)
+{
+	const unsigned char* const bytes{ reinterpret_cast<const unsigned char*>(data) };
+	return static_cast<uint32_t>(bytes[0]) |
+		(static_cast<uint32_t>(bytes[1]) << 8) |
+		(static_cast<uint32_t>(bytes[2]) << 16) |
+		(static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+static int32_t read_i32(const char* const data)
+{
+	return static_cast<int32_t>(read_u32(data));
+}
+
+static int64_t read_i64(const char* const data)
+{
+	const uint64_t low{ read_u32(data) };
+	const uint64_t high{ read_u32(data + 4) };
+	return static_cast<int64_t>(low | (high << 32));
+}
+
+static float read_f32(const char* const data)
+{
+	const uint32_t bits{ read_u32(data) };
+	float result;
+	std::memcpy(&result, &bits, sizeof(float));
+	return result;
+}
+
+/**
+ * @brief Holds the value and data sections while a graph is being written.
+ */
+class BinaryGraphWriter {
+public:
+	void add_value(const uint32_t slot_index, const csg::SlotValue& slot_value)
+	{
+		uint32_t payload[3]{ 0, 0, 0 };
+		switch (slot_value.type()) {
+			case csg::SlotType::BOOL:
+				payload[0] = slot_value.as_ptr<csg::BoolSlotValue>()->get() ? 1 : 0;
+				break;
+			case csg::SlotType::COLOR:
+				set_float3(payload, slot_value.as_ptr<csg::ColorSlotValue>()->get());
+				break;
+			case csg::SlotType::ENUM:
+				payload[0] = static_cast<uint32_t>(slot_value.as_ptr<csg::EnumSlotValue>()->get());
+				break;
+			case csg::SlotType::FLOAT:
+				payload[0] = float_bits(slot_value.as_ptr<csg::FloatSlotValue>()->get());
+				break;
+			case csg::SlotType::INT:
+				payload[0] = static_cast<uint32_t>(slot_value.as_ptr<csg::IntSlotValue>()->get());
+				break;
+			case csg::SlotType::VECTOR:
+				set_float3(payload, slot_value.as_ptr<csg::VectorSlotValue>()->get());
+				break;
+			case csg::SlotType::CURVE_RGB:
+			{
+				payload[0] = static_cast<uint32_t>(data_word_count);
+				const csg::RGBCurveSlotValue& curve_value{ *slot_value.as_ptr<csg::RGBCurveSlotValue>() };
+				add_curve(curve_value.get_all());
+				add_curve(curve_value.get_r());
+				add_curve(curve_value.get_g());
+				add_curve(curve_value.get_b());
+				payload[1] = static_cast<uint32_t>(data_word_count) - payload[0];
+				break;
+			}
+			case csg::SlotType::CURVE_VECTOR:
+			{
+				payload[0] = static_cast<uint32_t>(data_word_count);
+				const csg::VectorCurveSlotValue& curve_value{ *slot_value.as_ptr<csg::VectorCurveSlotValue>() };
+				add_word(float_bits(curve_value.get_min().x));
+				add_word(float_bits(curve_value.get_min().y));
+				add_word(float_bits(curve_value.get_max().x));
+				add_word(float_bits(curve_value.get_max().y));
+				add_curve(curve_value.get_x());
+				add_curve(curve_value.get_y());
+				add_curve(curve_value.get_z());
+				payload[1] = static_cast<uint32_t>(data_word_count) - payload[0];
+				break;
+			}
+			case csg::SlotType::COLOR_RAMP:
+			{
+				payload[0] = static_cast<uint32_t>(data_word_count);
+				const std::vector<csg::ColorRampPoint>& points{ slot_value.as_ptr<csg::ColorRampSlotValue>()->get().get() };
+				add_word(static_cast<uint32_t>(points.size()));
+				for (const csg::ColorRampPoint& this_point : points) {
+					add_word(float_bits(this_point.pos));
+					add_word(float_bits(this_point.color.x));
+					add_word(float_bits(this_point.color.y));
+					add_word(float_bits(this_point.color.z));
+					add_word(float_bits(this_point.alpha));
+				}
+				payload[1] = static_cast<uint32_t>(data_word_count) - payload[0];
+				break;
+			}
+			default:
+				return;
+		}
+
+		append_u32(values, slot_index);
+		append_u32(values, static_cast<uint32_t>(slot_value.type()));
+		for (const uint32_t this_word : payload) {
+			append_u32(values, this_word);
+		}
+		value_count++;
+	}
+
+	std::string values;
+	size_t value_count{ 0 };
+
+	std::string data_words;
+	size_t data_word_count{ 0 };
+
+private:
+	static void set_float3(uint32_t* const payload, const csc::Float3 value)
+	{
+		payload[0] = float_bits(value.x);
+		payload[1] = float_bits(value.y);
+		payload[2] = float_bits(value.z);
+	}
+
+	void add_word(const uint32_t word)
+	{
+		append_u32(data_words, word);
+		data_word_count++;
+	}
+
+	void add_curve(const csg::Curve& curve)
+	{
+		add_word(static_cast<uint32_t>(curve.control_points().size()));
+		for (const csg::CurvePoint& this_point : curve.control_points()) {
+			add_word(float_bits(this_point.pos.x));
+			add_word(float_bits(this_point.pos.y));
+			add_word(this_point.interp == csg::CurveInterp::LINEAR ? INTERP_LINEAR : INTERP_CUBIC_HERMITE);
+		}
+	}
+};
+
+bool csg::is_binary_graph(const boost::string_view graph_data)
+{
+	return graph_data.size() >= sizeof(BINARY_MAGIC) && std::memcmp(graph_data.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+std::string csg::serialize_graph_binary(const Graph& graph)
+{
+	std::vector<const Node*> nodes;
+	nodes.reserve(graph.nodes().size());
+	for (const Node& node : graph.nodes()) {
+		if (node.type() != NodeType::COUNT) {
+			nodes.push_back(&node);
+		}
+	}
+	std::sort(nodes.begin(), nodes.end(),
+		[](const Node* const a, const Node* const b) {
+			return a->id() < b->id();
+		}
+	);
+
+	std::map<NodeId, uint32_t> index_by_id;
+	std::string node_table;
+	node_table.reserve(nodes.size() * NODE_RECORD_SIZE);
+	BinaryGraphWriter writer;
+	for (const Node* const node : nodes) {
+		index_by_id[node->id()] = static_cast<uint32_t>(index_by_id.size());
+		const size_t first_value{ writer.value_count };
+		for (size_t i = 0; i < node->slot_count(); i++) {
+			const SlotValue* const value{ node->slot_value_ptr(i) };
+			if (node->slots()[i].dir() == SlotDirection::INPUT && value != nullptr) {
+				writer.add_value(static_cast<uint32_t>(i), *value);
+			}
+		}
+		append_i64(node_table, node->id());
+		append_u32(node_table, static_cast<uint32_t>(node->type()));
+		append_i32(node_table, node->position.x);
+		append_i32(node_table, node->position.y);
+		append_u32(node_table, static_cast<uint32_t>(first_value));
+		append_u32(node_table, static_cast<uint32_t>(writer.value_count - first_value));
+		append_u32(node_table, 0);
+	}
+
+	std::vector<Connection> connections;
+	for (const Connection& connection : graph.connections()) {
+		const auto src_iter = index_by_id.find(connection.source().node_id());
+		const auto dest_iter = index_by_id.find(connection.dest().node_id());
+		if (src_iter != index_by_id.end() && dest_iter != index_by_id.end()) {
+			connections.push_back(connection);
+		}
+	}
+	std::sort(connections.begin(), connections.end());
+	std::string connection_table;
+	connection_table.reserve(connections.size() * CONNECTION_RECORD_SIZE);
+	for (const Connection& connection : connections) {
+		append_u32(connection_table, index_by_id[connection.source().node_id()]);
+		append_u32(connection_table, static_cast<uint32_t>(connection.source().index()));
+		append_u32(connection_table, index_by_id[connection.dest().node_id()]);
+		append_u32(connection_table, static_cast<uint32_t>(connection.dest().index()));
+	}
+
+	std::string result;
+	result.reserve(HEADER_SIZE + node_table.size() + writer.values.size() + connection_table.size() + writer.data_words.size());
+	result.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	append_u32(result, BINARY_VERSION);
+	append_u32(result, static_cast<uint32_t>(nodes.size()));
+	append_u32(result, static_cast<uint32_t>(writer.value_count));
+	append_u32(result, static_cast<uint32_t>(connections.size()));
+	append_u32(result, static_cast<uint32_t>(writer.data_word_count));
+	append_u32(result, 0);
+	assert(result.size() == HEADER_SIZE);
+	result += node_table;
+	result += writer.values;
+	result += connection_table;
+	result += writer.data_words;
+	return result;
+}
+
+/**
+ * @brief Bounds-checked access to the data word section of a binary graph.
+ */
+class BinaryDataWords {
+public:
+	BinaryDataWords(const char* const begin, const size_t word_count) : begin{ begin }, word_count{ word_count } {}
+
+	// Restrict reads to the range referenced by one value, returns false if it does not fit in the section
+	// The writer never overlaps ranges, so each one must begin after the last so no word is read twice
+	bool select(const uint32_t first_word, const uint32_t range_word_count)
+	{
+		if (first_word < range_end || first_word > word_count || range_word_count > word_count - first_word) {
+			return false;
+		}
+		cursor = first_word;
+		range_end = first_word + range_word_count;
+		return true;
+	}
+
+	bool has_words(const size_t count) const { return count <= range_end - cursor; }
+	uint32_t next_u32() { assert(cursor < range_end); return read_u32(begin + DATA_WORD_SIZE * cursor++); }
+	float next_f32() { assert(cursor < range_end); return read_f32(begin + DATA_WORD_SIZE * cursor++); }
+
+private:
+	const char* begin;
+	size_t word_count;
+
+	size_t cursor{ 0 };
+	size_t range_end{ 0 };
+};
+
+static boost::optional<csg::Curve> read_curve(BinaryDataWords& words, const csc::Float2 min, const csc::Float2 max, const size_t max_points)
+{
+	if (words.has_words(1) == false) {
+		return boost::none;
+	}
+	const size_t point_count{ words.next_u32() };
+	if (point_count < 2 || point_count > max_points || point_count > SIZE_MAX / 3 || words.has_words(point_count * 3) == false) {
+		return boost::none;
+	}
+
+	const csc::FloatRect bounds{ min, max };
+	std::vector<csg::CurvePoint> points;
+	points.reserve(point_count);
+	for (size_t i = 0; i < point_count; i++) {
+		const float x{ words.next_f32() };
+		const float y{ words.next_f32() };
+		const uint32_t interp{ words.next_u32() };
+		const csc::Float2 pos{ x, y };
+		if (bounds.contains(pos) == false) {
+			return boost::none;
+		}
+		points.push_back(csg::CurvePoint{ pos, interp == INTERP_LINEAR ? csg::CurveInterp::LINEAR : csg::CurveInterp::CUBIC_HERMITE });
+	}
+	return csg::Curve{ min, max, points };
+}
+
+static bool float3_valid(const csc::Float3 value)
+{
+	return std::isfinite(value.x) && std::isfinite(value.y) && std::isfinite(value.z);
+}
+
+// Apply one value record to the graph, invalid values are skipped
+static void read_value(csg::Graph& graph, const csg::NodeId node_id, const char* const record, BinaryDataWords& words, const size_t max_points)
+{
+	using namespace csg;
+
+	const Node* const node{ graph.get(node_id) };
+	assert(node != nullptr);
+
+	const size_t slot_index{ read_u32(record) };
+	const uint32_t slot_type{ read_u32(record + 4) };
+	const char* const payload{ record + 8 };
+	if (slot_index >= node->slot_count()) {
+		return;
+	}
+	const Slot& slot{ node->slots()[slot_index] };
+	if (slot.dir() != SlotDirection::INPUT || node->slot_value_ptr_without_decoding(slot_index) == nullptr || static_cast<uint32_t>(slot.type()) != slot_type) {
+		return;
+	}
+
+	const SlotId slot_id{ node_id, slot_index };
+	const csc::Float3 payload_float3{ read_f32(payload), read_f32(payload + 4), read_f32(payload + 8) };
+	switch (slot.type()) {
+		case SlotType::BOOL:
+			graph.set_bool(slot_id, read_u32(payload) != 0);
+			break;
+		case SlotType::COLOR:
+			if (float3_valid(payload_float3)) {
+				graph.set_color(slot_id, payload_float3);
+			}
+			break;
+		case SlotType::ENUM:
+			graph.set_enum(slot_id, read_u32(payload));
+			break;
+		case SlotType::FLOAT:
+			if (std::isfinite(payload_float3.x)) {
+				graph.set_float(slot_id, payload_float3.x);
+			}
+			break;
+		case SlotType::INT:
+			graph.set_int(slot_id, read_i32(payload));
+			break;
+		case SlotType::VECTOR:
+			if (float3_valid(payload_float3)) {
+				graph.set_vector(slot_id, payload_float3);
+			}
+			break;
+		case SlotType::CURVE_RGB:
+		{
+			if (words.select(read_u32(payload), read_u32(payload + 4)) == false) {
+				break;
+			}
+			const csc::Float2 min{ 0.0f, 0.0f };
+			const csc::Float2 max{ 1.0f, 1.0f };
+			const boost::optional<Curve> opt_all{ read_curve(words, min, max, max_points) };
+			const boost::optional<Curve> opt_r{ read_curve(words, min, max, max_points) };
+			const boost::optional<Curve> opt_g{ read_curve(words, min, max, max_points) };
+			const boost::optional<Curve> opt_b{ read_curve(words, min, max, max_points) };
+			if (opt_all && opt_r && opt_g && opt_b) {
+				RGBCurveSlotValue curve_value;
+				curve_value.set_all(*opt_all);
+				curve_value.set_r(*opt_r);
+				curve_value.set_g(*opt_g);
+				curve_value.set_b(*opt_b);
+				graph.set_curve_rgb(slot_id, curve_value);
+			}
+			break;
+		}
+		case SlotType::CURVE_VECTOR:
+		{
+			if (words.select(read_u32(payload), read_u32(payload + 4)) == false || words.has_words(4) == false) {
+				break;
+			}
+			const float min_x{ words.next_f32() };
+			const float min_y{ words.next_f32() };
+			const float max_x{ words.next_f32() };
+			const float max_y{ words.next_f32() };
+			const csc::Float2 min{ min_x, min_y };
+			const csc::Float2 max{ max_x, max_y };
+			if ((min.x < max.x && min.y < max.y) == false) {
+				break;
+			}
+			const boost::optional<Curve> opt_x{ read_curve(words, min, max, max_points) };
+			const boost::optional<Curve> opt_y{ read_curve(words, min, max, max_points) };
+			const boost::optional<Curve> opt_z{ read_curve(words, min, max, max_points) };
+			if (opt_x && opt_y && opt_z) {
+				VectorCurveSlotValue curve_value{ min, max };
+				curve_value.set_x(*opt_x);
+				curve_value.set_y(*opt_y);
+				curve_value.set_z(*opt_z);
+				graph.set_curve_vec(slot_id, curve_value);
+			}
+			break;
+		}
+		case SlotType::COLOR_RAMP:
+		{
+			if (words.select(read_u32(payload), read_u32(payload + 4)) == false || words.has_words(1) == false) {
+				break;
+			}
+			const size_t point_count{ words.next_u32() };
+			if (point_count < 2 || point_count > max_points || point_count > SIZE_MAX / 5 || words.has_words(point_count * 5) == false) {
+				break;
+			}
+			std::vector<ColorRampPoint> points;
+			points.reserve(point_count);
+			for (size_t i = 0; i < point_count; i++) {
+				const float pos{ words.next_f32() };
+				const float r{ words.next_f32() };
+				const float g{ words.next_f32() };
+				const float b{ words.next_f32() };
+				const float a{ words.next_f32() };
+				// Points are sorted by these values, which is undefined with a NaN among them
+				if (std::isfinite(pos) == false || float3_valid(csc::Float3{ r, g, b }) == false || std::isfinite(a) == false) {
+					return;
+				}
+				points.push_back(ColorRampPoint{ pos, csc::Float3{ r, g, b }, a });
+			}
+			graph.set_color_ramp(slot_id, ColorRampSlotValue{ ColorRamp{ points } });
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+boost::optional<csg::Graph> csg::deserialize_graph_binary(const boost::string_view graph_data, const DeserializeOptions& options)
+{
+	if (is_binary_graph(graph_data) == false || graph_data.size() < HEADER_SIZE) {
+		return boost::none;
+	}
+
+	const char* const header{ graph_data.data() };
+	if (read_u32(header + 8) != BINARY_VERSION) {
+		return boost::none;
+	}
+	const size_t node_count{ read_u32(header + 12) };
+	const size_t value_count{ read_u32(header + 16) };
+	const size_t connection_count{ read_u32(header + 20) };
+	const size_t data_word_count{ read_u32(header + 24) };
+	if (node_count > options.max_node_count || connection_count > options.max_connection_count) {
+		return boost::none;
+	}
+
+	// Counts are 32-bit so none of these products can overflow a 64-bit size_t
+	const size_t node_table_offset{ HEADER_SIZE };
+	const size_t value_table_offset{ node_table_offset + node_count * NODE_RECORD_SIZE };
+	const size_t connection_table_offset{ value_table_offset + value_count * VALUE_RECORD_SIZE };
+	const size_t data_offset{ connection_table_offset + connection_count * CONNECTION_RECORD_SIZE };
+	const size_t total_size{ data_offset + data_word_count * DATA_WORD_SIZE };
+	if (graph_data.size() < total_size) {
+		return boost::none;
+	}
+
+	BinaryDataWords words{ graph_data.data() + data_offset, data_word_count };
+
+	Graph result{ GraphType::EMPTY };
+
+	// Node ids by index in the node table, nodes of unknown types are left as none
+	std::vector<boost::optional<NodeId>> ids_by_index;
+	ids_by_index.reserve(node_count);
+	// The writer never overlaps the value ranges of two nodes, requiring that here means each value record is read at most once
+	size_t next_value{ 0 };
+	for (size_t i = 0; i < node_count; i++) {
+		const char* const record{ graph_data.data() + node_table_offset + i * NODE_RECORD_SIZE };
+		const NodeId node_id{ read_i64(record) };
+		const uint32_t type_index{ read_u32(record + 8) };
+		const csc::Int2 pos{ read_i32(record + 12), read_i32(record + 16) };
+		const size_t first_value{ read_u32(record + 20) };
+		const size_t node_value_count{ read_u32(record + 24) };
+
+		if (type_index >= static_cast<uint32_t>(NodeType::COUNT)) {
+			// We do not recognize this type
+			ids_by_index.push_back(boost::none);
+			continue;
+		}
+		if (result.add(static_cast<NodeType>(type_index), pos, node_id) == false) {
+			// Duplicate id, this only happens in malformed graphs
+			return boost::none;
+		}
+		ids_by_index.push_back(node_id);
+
+		if (first_value < next_value || first_value > value_count || node_value_count > value_count - first_value) {
+			continue;
+		}
+		next_value = first_value + node_value_count;
+		for (size_t value_index = first_value; value_index < next_value; value_index++) {
+			read_value(result, node_id, graph_data.data() + value_table_offset + value_index * VALUE_RECORD_SIZE, words, options.max_curve_points);
+		}
+	}
+
+	for (size_t i = 0; i < connection_count; i++) {
+		const char* const record{ graph_data.data() + connection_table_offset + i * CONNECTION_RECORD_SIZE };
+		const size_t src_node_index{ read_u32(record) };
+		const size_t src_slot_index{ read_u32(record + 4) };
+		const size_t dest_node_index{ read_u32(record + 8) };
+		const size_t dest_slot_index{ read_u32(record + 12) };
+		if (src_node_index >= ids_by_index.size() || dest_node_index >= ids_by_index.size()) {
+			continue;
+		}
+		if (ids_by_index[src_node_index].has_value() == false || ids_by_index[dest_node_index].has_value() == false) {
+			continue;
+		}
+		const SlotId src_slot_id{ *ids_by_index[src_node_index], src_slot_index };
+		const SlotId dest_slot_id{ *ids_by_index[dest_node_index], dest_slot_index };
+		result.add_connection(src_slot_id, dest_slot_id);
+	}
+
+	return result;
+}
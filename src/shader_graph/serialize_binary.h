@@ -0,0 +1,23 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Declares functions to convert a Graph to and from the binary serialized format.
+ */
+
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+namespace csg {
+	class Graph;
+	struct DeserializeOptions;
+
+	// Check whether data starts with the binary format header
+	bool is_binary_graph(boost::string_view graph_data);
+
+	std::string serialize_graph_binary(const Graph& graph);
+	// Reads directly from graph_data, which may point at a memory mapped file
+	boost::optional<Graph> deserialize_graph_binary(boost::string_view graph_data, const DeserializeOptions& options);
+}
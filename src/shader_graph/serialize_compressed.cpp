@@ -0,0 +1,109 @@
+#include "serialize_compressed.h"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "shader_core/lz.h"
+
+#include "ext_base64.h"
+
+/*
+ * Layout of the compressed format:
+ *   cycles_shader_lz|version|decompressed size|payload
+ * The payload is the serialized graph compressed with csc::lz_compress, then base64 encoded
+ */
+
+static const char* const COMPRESSED_MAGIC{ "cycles_shader_lz|" };
+static const char* const COMPRESSED_VERSION_INPUT{ "1" };
+static const char* const COMPRESSED_VERSION_OUTPUT{ "1" };
+
+// Decompressed sizes are limited to this many digits, which is far more than any graph needs
+constexpr size_t MAX_SIZE_DIGITS{ 12 };
+
+// Split the next '|' terminated field off the front of input
+static boost::optional<boost::string_view> next_field(boost::string_view& input)
+{
+	const size_t separator{ input.find('|') };
+	if (separator == boost::string_view::npos) {
+		return boost::none;
+	}
+	const boost::string_view result{ input.substr(0, separator) };
+	input.remove_prefix(separator + 1);
+	return result;
+}
+
+static boost::optional<size_t> parse_size(const boost::string_view size_string)
+{
+	if (size_string.empty() || size_string.size() > MAX_SIZE_DIGITS) {
+		return boost::none;
+	}
+	size_t result{ 0 };
+	for (const char this_char : size_string) {
+		if (this_char < '0' || this_char > '9') {
+			return boost::none;
+		}
+		result = result * 10 + static_cast<size_t>(this_char - '0');
+	}
+	return result;
+}
+
+bool csg::is_compressed_graph(const boost::string_view graph_data)
+{
+	return graph_data.starts_with(COMPRESSED_MAGIC);
+}
+
+std::string csg::compress_serialized_graph(const boost::string_view graph_data)
+{
+	const std::string compressed{ csc::lz_compress(graph_data) };
+
+	std::string output{ COMPRESSED_MAGIC };
+	output += COMPRESSED_VERSION_OUTPUT;
+	output += '|';
+	output += std::to_string(graph_data.size());
+	output += '|';
+
+	const size_t payload_begin{ output.size() };
+	output.resize(payload_begin + ext::base64::encoded_size(compressed.size()));
+	const size_t payload_size{ ext::base64::encode(&output[payload_begin], compressed.data(), compressed.size()) };
+	output.resize(payload_begin + payload_size);
+
+	return output;
+}
+
+boost::optional<std::string> csg::decompress_serialized_graph(const boost::string_view compressed_data, const size_t max_size)
+{
+	if (is_compressed_graph(compressed_data) == false) {
+		return boost::none;
+	}
+
+	boost::string_view remaining{ compressed_data.substr(std::strlen(COMPRESSED_MAGIC)) };
+	const boost::optional<boost::string_view> version{ next_field(remaining) };
+	if (version.has_value() == false || *version != COMPRESSED_VERSION_INPUT) {
+		return boost::none;
+	}
+	const boost::optional<boost::string_view> size_string{ next_field(remaining) };
+	if (size_string.has_value() == false) {
+		return boost::none;
+	}
+	const boost::optional<size_t> decompressed_size{ parse_size(*size_string) };
+	if (decompressed_size.has_value() == false || *decompressed_size > max_size) {
+		return boost::none;
+	}
+
+	// Decoding stops at the padding, so leave it out of the length check
+	boost::string_view payload{ remaining };
+	while (payload.ends_with('=')) {
+		payload.remove_suffix(1);
+	}
+	// decoded_size assumes padded input, so size for the padding that was removed
+	std::vector<char> compressed(ext::base64::decoded_size(payload.size() + 3));
+	const std::pair<size_t, size_t> decode_result = ext::base64::decode(compressed.data(), payload.data(), payload.size());
+	if (decode_result.second != payload.size()) {
+		// Stopped early on a character that is not base64
+		return boost::none;
+	}
+
+	return csc::lz_decompress(boost::string_view{ compressed.data(), decode_result.first }, *decompressed_size);
+}
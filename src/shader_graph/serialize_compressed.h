@@ -0,0 +1,23 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Declares functions to wrap a serialized graph in the compressed format.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+namespace csg {
+	// Check whether data starts with the compressed format header
+	bool is_compressed_graph(boost::string_view graph_data);
+
+	// Compress a graph in any serialized format, the result is plain text so it can be stored anywhere the text format can
+	std::string compress_serialized_graph(boost::string_view graph_data);
+	// Returns the serialized graph that was compressed, or none if the input is not valid or would expand past max_size
+	boost::optional<std::string> decompress_serialized_graph(boost::string_view compressed_data, size_t max_size = SIZE_MAX);
+}
@@ -2,6 +2,10 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
 
 #include <boost/algorithm/clamp.hpp>
 #include <boost/optional.hpp>
@@ -10,13 +14,10 @@
 #include "shader_core/rect.h"
 #include "shader_core/vector.h"
 
-static bool set_curve(csg::Curve& curve, const csg::Curve& new_value)
+// A new curve must have the same bounds as the one it replaces
+static bool curve_fits(const csg::Curve& curve, const csg::Curve& new_value)
 {
-	if (new_value.min() != curve.min() || new_value.max() != curve.max()) {
-		return false;
-	}
-	curve = new_value;
-	return true;
+	return new_value.min() == curve.min() && new_value.max() == curve.max();
 }
 
 bool csg::ColorSlotValue::operator==(const ColorSlotValue& other) const
@@ -78,81 +79,96 @@ bool csg::VectorSlotValue::operator==(const VectorSlotValue& other) const
 	return value.similar(other.value, FLOAT_COMPARE_DIFF);
 }
 
-csg::RGBCurveSlotValue::RGBCurveSlotValue() :
-	curve_all{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } },
-	curve_r{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } },
-	curve_g{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } },
-	curve_b{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } }
+csg::RGBCurveSlotValue::RGBCurveSlotValue()
 {
-
+	// Every default value can share the same points
+	static const std::shared_ptr<const Curves> default_curves{ std::make_shared<const Curves>(Curves{
+		Curve{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } },
+		Curve{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } },
+		Curve{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } },
+		Curve{ csc::Float2{ 0.0f, 0.0f }, csc::Float2{ 1.0f, 1.0f } }
+	}) };
+	curves = default_curves;
 }
 
 bool csg::RGBCurveSlotValue::set_all(const Curve& value)
 {
-	return set_curve(curve_all, value);
+	return set_curve(&Curves::all, value);
 }
 
 bool csg::RGBCurveSlotValue::set_r(const Curve& value)
 {
-	return set_curve(curve_r, value);
+	return set_curve(&Curves::r, value);
 }
 
 bool csg::RGBCurveSlotValue::set_g(const Curve& value)
 {
-	return set_curve(curve_g, value);
+	return set_curve(&Curves::g, value);
 }
 
 bool csg::RGBCurveSlotValue::set_b(const Curve& value)
 {
-	return set_curve(curve_b, value);
+	return set_curve(&Curves::b, value);
+}
+
+bool csg::RGBCurveSlotValue::set_curve(Curve Curves::* const curve, const Curve& value)
+{
+	if (curve_fits((*curves).*curve, value) == false) {
+		return false;
+	}
+	const std::shared_ptr<Curves> new_curves{ std::make_shared<Curves>(*curves) };
+	(*new_curves).*curve = value;
+	curves = new_curves;
+	return true;
 }
 
 bool csg::RGBCurveSlotValue::operator==(const RGBCurveSlotValue& other) const
 {
+	if (curves == other.curves) {
+		return true;
+	}
 	return (
-		curve_all.similar(other.curve_all , FLOAT_COMPARE_DIFF) &&
-		curve_r.similar(other.curve_r, FLOAT_COMPARE_DIFF) &&
-		curve_g.similar(other.curve_g, FLOAT_COMPARE_DIFF) &&
-		curve_b.similar(other.curve_b, FLOAT_COMPARE_DIFF)
+		curves->all.similar(other.curves->all, FLOAT_COMPARE_DIFF) &&
+		curves->r.similar(other.curves->r, FLOAT_COMPARE_DIFF) &&
+		curves->g.similar(other.curves->g, FLOAT_COMPARE_DIFF) &&
+		curves->b.similar(other.curves->b, FLOAT_COMPARE_DIFF)
 		);
 }
 
 csg::VectorCurveSlotValue::VectorCurveSlotValue(const csc::Float2 min, const csc::Float2 max) :
-	curve_x{ min, max },
-	curve_y{ min, max },
-	curve_z{ min, max },
-	min{ min },
-	max{ max }
+	curves{ std::make_shared<const Curves>(Curves{ Curve{ min, max }, Curve{ min, max }, Curve{ min, max }, min, max }) }
 {
 
 }
 
 bool csg::VectorCurveSlotValue::set_x(const Curve& value)
 {
-	return set_curve(curve_x, value);
+	return set_curve(&Curves::x, value);
 }
 
 bool csg::VectorCurveSlotValue::set_y(const Curve& value)
 {
-	return set_curve(curve_y, value);
+	return set_curve(&Curves::y, value);
 }
 
 bool csg::VectorCurveSlotValue::set_z(const Curve& value)
 {
-	return set_curve(curve_z, value);
+	return set_curve(&Curves::z, value);
 }
 
 bool csg::VectorCurveSlotValue::set_bounds(const csc::FloatRect bounds_rect)
 {
-	const bool valid_x{ curve_x.bounds_valid(bounds_rect) };
-	const bool valid_y{ curve_y.bounds_valid(bounds_rect) };
-	const bool valid_z{ curve_z.bounds_valid(bounds_rect) };
+	const bool valid_x{ curves->x.bounds_valid(bounds_rect) };
+	const bool valid_y{ curves->y.bounds_valid(bounds_rect) };
+	const bool valid_z{ curves->z.bounds_valid(bounds_rect) };
 	if (valid_x && valid_y && valid_z) {
-		curve_x.set_bounds(bounds_rect);
-		curve_y.set_bounds(bounds_rect);
-		curve_z.set_bounds(bounds_rect);
-		min = bounds_rect.begin();
-		max = bounds_rect.end();
+		const std::shared_ptr<Curves> new_curves{ std::make_shared<Curves>(*curves) };
+		new_curves->x.set_bounds(bounds_rect);
+		new_curves->y.set_bounds(bounds_rect);
+		new_curves->z.set_bounds(bounds_rect);
+		new_curves->min = bounds_rect.begin();
+		new_curves->max = bounds_rect.end();
+		curves = new_curves;
 		return true;
 	}
 	else {
@@ -160,77 +176,129 @@ bool csg::VectorCurveSlotValue::set_bounds(const csc::FloatRect bounds_rect)
 	}
 }
 
+bool csg::VectorCurveSlotValue::set_curve(Curve Curves::* const curve, const Curve& value)
+{
+	if (curve_fits((*curves).*curve, value) == false) {
+		return false;
+	}
+	const std::shared_ptr<Curves> new_curves{ std::make_shared<Curves>(*curves) };
+	(*new_curves).*curve = value;
+	curves = new_curves;
+	return true;
+}
+
 bool csg::VectorCurveSlotValue::operator==(const VectorCurveSlotValue& other) const
 {
+	if (curves == other.curves) {
+		return true;
+	}
 	return (
-		curve_x.similar(other.curve_x, FLOAT_COMPARE_DIFF) &&
-		curve_y.similar(other.curve_y, FLOAT_COMPARE_DIFF) &&
-		curve_z.similar(other.curve_z, FLOAT_COMPARE_DIFF) &&
-		min.similar(other.min, FLOAT_COMPARE_DIFF) &&
-		max.similar(other.max, FLOAT_COMPARE_DIFF)
+		curves->x.similar(other.curves->x, FLOAT_COMPARE_DIFF) &&
+		curves->y.similar(other.curves->y, FLOAT_COMPARE_DIFF) &&
+		curves->z.similar(other.curves->z, FLOAT_COMPARE_DIFF) &&
+		curves->min.similar(other.curves->min, FLOAT_COMPARE_DIFF) &&
+		curves->max.similar(other.curves->max, FLOAT_COMPARE_DIFF)
 	);
 }
 
+csg::ColorRampSlotValue::ColorRampSlotValue()
+{
+	static const std::shared_ptr<const ColorRamp> default_ramp{ std::make_shared<const ColorRamp>() };
+	ramp = default_ramp;
+}
+
 bool csg::ColorRampSlotValue::operator==(const ColorRampSlotValue& other) const
 {
-	return ramp.similar(other.ramp, FLOAT_COMPARE_DIFF);
+	return ramp == other.ramp || ramp->similar(*other.ramp, FLOAT_COMPARE_DIFF);
 }
 
-csg::SlotValue& csg::SlotValue::operator=(const SlotValue& other)
+csg::SlotValue::SlotValue(const SlotValue& other) : _type{ other._type }
 {
-	_type = other._type;
-	value_union = other.value_union;
+	construct_from(other);
+}
 
-	if (other.curve_rgb_value) {
-		curve_rgb_value = std::make_unique<RGBCurveSlotValue>(*other.curve_rgb_value);
-	}
-	else {
-		curve_vector_value = std::unique_ptr<VectorCurveSlotValue>();
-	}
+csg::SlotValue::SlotValue(SlotValue&& other) noexcept : _type{ other._type }
+{
+	construct_from(std::move(other));
+}
 
-	if (other.curve_vector_value) {
-		curve_vector_value = std::make_unique<VectorCurveSlotValue>(*other.curve_vector_value);
-	}
-	else {
-		curve_vector_value = std::unique_ptr<VectorCurveSlotValue>();
+csg::SlotValue& csg::SlotValue::operator=(const SlotValue& other)
+{
+	if (this != &other) {
+		destroy();
+		_type = other._type;
+		construct_from(other);
 	}
+	return *this;
+}
 
-	if (other.color_ramp_value) {
-		color_ramp_value = std::make_unique<ColorRampSlotValue>(*other.color_ramp_value);
-	}
-	else {
-		color_ramp_value = std::unique_ptr<ColorRampSlotValue>();
+csg::SlotValue& csg::SlotValue::operator=(SlotValue&& other) noexcept
+{
+	if (this != &other) {
+		destroy();
+		_type = other._type;
+		construct_from(std::move(other));
 	}
-
 	return *this;
 }
 
-template <> boost::optional<csg::BoolSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::BOOL) ? boost::none : boost::optional<csg::BoolSlotValue>{ value_union.bool_value };
-}
-template <> boost::optional<csg::ColorSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::COLOR) ? boost::none : boost::optional<csg::ColorSlotValue>{ value_union.color_value };
-}
-template <> boost::optional<csg::EnumSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::ENUM) ? boost::none : boost::optional<csg::EnumSlotValue>{ value_union.enum_value };
-}
-template <> boost::optional<csg::FloatSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::FLOAT) ? boost::none : boost::optional<csg::FloatSlotValue>{ value_union.float_value };
-}
-template <> boost::optional<csg::IntSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::INT) ? boost::none : boost::optional<csg::IntSlotValue>{ value_union.int_value };
-}
-template <> boost::optional<csg::VectorSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::VECTOR) ? boost::none : boost::optional<csg::VectorSlotValue>{ value_union.vector_value };
+csg::SlotValue::~SlotValue()
+{
+	destroy();
 }
-template <> boost::optional<csg::RGBCurveSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::CURVE_RGB || static_cast<bool>(curve_rgb_value) == false) ? boost::none : boost::optional<csg::RGBCurveSlotValue>{ *curve_rgb_value };
+
+void csg::SlotValue::construct_from(const SlotValue& other)
+{
+	switch (_type) {
+		case SlotType::CURVE_RGB:
+			new (&value_union.curve_rgb_value) RGBCurveSlotValue{ other.value_union.curve_rgb_value };
+			break;
+		case SlotType::CURVE_VECTOR:
+			new (&value_union.curve_vector_value) VectorCurveSlotValue{ other.value_union.curve_vector_value };
+			break;
+		case SlotType::COLOR_RAMP:
+			new (&value_union.color_ramp_value) ColorRampSlotValue{ other.value_union.color_ramp_value };
+			break;
+		default:
+			// Every other member is trivially copyable
+			std::memcpy(static_cast<void*>(&value_union), &other.value_union, sizeof(SlotValueUnion));
+			break;
+	}
 }
-template <> boost::optional<csg::VectorCurveSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::CURVE_VECTOR || static_cast<bool>(curve_vector_value) == false) ? boost::none : boost::optional<csg::VectorCurveSlotValue>{ *curve_vector_value };
+
+void csg::SlotValue::construct_from(SlotValue&& other)
+{
+	switch (_type) {
+		case SlotType::CURVE_RGB:
+			new (&value_union.curve_rgb_value) RGBCurveSlotValue{ std::move(other.value_union.curve_rgb_value) };
+			break;
+		case SlotType::CURVE_VECTOR:
+			new (&value_union.curve_vector_value) VectorCurveSlotValue{ std::move(other.value_union.curve_vector_value) };
+			break;
+		case SlotType::COLOR_RAMP:
+			new (&value_union.color_ramp_value) ColorRampSlotValue{ std::move(other.value_union.color_ramp_value) };
+			break;
+		default:
+			construct_from(static_cast<const SlotValue&>(other));
+			break;
+	}
 }
-template <> boost::optional<csg::ColorRampSlotValue> csg::SlotValue::as() const {
-	return (type() != SlotType::COLOR_RAMP || static_cast<bool>(color_ramp_value) == false) ? boost::none : boost::optional<csg::ColorRampSlotValue>{ *color_ramp_value };
+
+void csg::SlotValue::destroy()
+{
+	switch (_type) {
+		case SlotType::CURVE_RGB:
+			value_union.curve_rgb_value.~RGBCurveSlotValue();
+			break;
+		case SlotType::CURVE_VECTOR:
+			value_union.curve_vector_value.~VectorCurveSlotValue();
+			break;
+		case SlotType::COLOR_RAMP:
+			value_union.color_ramp_value.~ColorRampSlotValue();
+			break;
+		default:
+			break;
+	}
 }
 
 bool csg::SlotValue::operator==(const SlotValue& other) const
@@ -284,27 +352,21 @@ bool csg::SlotValue::operator==(const SlotValue& other) const
 		}
 		case SlotType::CURVE_RGB:
 		{
-			assert(curve_rgb_value.get() != nullptr);
-			assert(other.curve_rgb_value.get() != nullptr);
-			if (*curve_rgb_value != *other.curve_rgb_value) {
+			if (value_union.curve_rgb_value != other.value_union.curve_rgb_value) {
 				return false;
 			}
 			break;
 		}
 		case SlotType::CURVE_VECTOR:
 		{
-			assert(curve_vector_value.get() != nullptr);
-			assert(other.curve_vector_value.get() != nullptr);
-			if (*curve_vector_value != *other.curve_vector_value) {
+			if (value_union.curve_vector_value != other.value_union.curve_vector_value) {
 				return false;
 			}
 			break;
 		}
 		case SlotType::COLOR_RAMP:
 		{
-			assert(color_ramp_value.get() != nullptr);
-			assert(other.color_ramp_value.get() != nullptr);
-			if (*color_ramp_value != *other.color_ramp_value) {
+			if (value_union.color_ramp_value != other.value_union.color_ramp_value) {
 				return false;
 			}
 			break;
@@ -331,15 +393,5 @@ bool csg::Slot::operator==(const Slot& other) const
 		return false;
 	}
 
-	if (value.has_value() != other.value.has_value()) {
-		return false;
-	}
-
-	if (value.has_value()) {
-		if (*value != *(other.value)) {
-			return false;
-		}
-	}
-
 	return true;
 }
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #include <boost/optional.hpp>
@@ -18,12 +19,12 @@ namespace csc {
 
 namespace csg {
 
-	enum class SlotDirection {
+	enum class SlotDirection : uint8_t {
 		INPUT,
 		OUTPUT,
 	};
 
-	enum class SlotType {
+	enum class SlotType : uint8_t {
 		BOOL,
 		CLOSURE,
 		COLOR,
@@ -82,21 +83,21 @@ namespace csg {
 
 	private:
 		EnumSlotValue(NodeMetaEnum meta_enum, size_t value, size_t max_value) :
-			meta_enum{ meta_enum }, value{ value }, max_value{ max_value }
+			meta_enum{ meta_enum }, value{ static_cast<uint32_t>(value) }, max_value{ static_cast<uint32_t>(max_value) }
 		{}
 		template <typename T> EnumSlotValue(NodeMetaEnum meta_enum, T value) :
 			EnumSlotValue(meta_enum, static_cast<size_t>(value), static_cast<size_t>(T::COUNT) - 1)
 		{}
 
 		NodeMetaEnum meta_enum;
-		size_t value;
-		size_t max_value;
+		uint32_t value;
+		uint32_t max_value;
 	};
 
 	class FloatSlotValue {
 	public:
 		FloatSlotValue(float initial, float min, float max, size_t precision = 3) :
-			value{ initial }, min{ min }, max{ max }, _precision{ precision }
+			value{ initial }, min{ min }, max{ max }, _precision{ static_cast<uint8_t>(precision) }
 		{}
 
 		float get() const { return value; }
@@ -111,7 +112,7 @@ namespace csg {
 		float value;
 		float min;
 		float max;
-		size_t _precision;
+		uint8_t _precision;
 	};
 
 	class IntSlotValue {
@@ -135,7 +136,7 @@ namespace csg {
 	class VectorSlotValue {
 	public:
 		VectorSlotValue(csc::Float3 initial, csc::Float3 min, csc::Float3 max, size_t precision = 3) :
-			value{ initial }, min{ min }, max{ max }, _precision{ precision }
+			value{ initial }, min{ min }, max{ max }, _precision{ static_cast<uint8_t>(precision) }
 			{}
 
 		csc::Float3 get() const { return value; }
@@ -150,19 +151,22 @@ namespace csg {
 		csc::Float3 value;
 		csc::Float3 min;
 		csc::Float3 max;
-		size_t _precision;
+		uint8_t _precision;
 	};
 
+	// Curve and ramp values share their points between copies, so copying one never copies the points
+	// The points are never changed in place, each setter that changes them makes a new copy first
+
 	class RGBCurveSlotValue {
 	public:
 		RGBCurveSlotValue();
 
-		Curve get_all() const { return curve_all; }
-		Curve get_r() const { return curve_r; }
-		Curve get_g() const { return curve_g; }
-		Curve get_b() const { return curve_b; }
+		const Curve& get_all() const { return curves->all; }
+		const Curve& get_r() const { return curves->r; }
+		const Curve& get_g() const { return curves->g; }
+		const Curve& get_b() const { return curves->b; }
 
-		void set(const RGBCurveSlotValue& value) { *this = RGBCurveSlotValue{ value }; }
+		void set(const RGBCurveSlotValue& value) { *this = value; }
 		bool set_all (const Curve& value);
 		bool set_r(const Curve& value);
 		bool set_g(const Curve& value);
@@ -172,24 +176,30 @@ namespace csg {
 		bool operator!=(const RGBCurveSlotValue& other) const { return operator==(other) == false; }
 
 	private:
-		Curve curve_all;
-		Curve curve_r;
-		Curve curve_g;
-		Curve curve_b;
+		struct Curves {
+			Curve all;
+			Curve r;
+			Curve g;
+			Curve b;
+		};
+
+		bool set_curve(Curve Curves::* curve, const Curve& value);
+
+		std::shared_ptr<const Curves> curves;
 	};
 
 	class VectorCurveSlotValue {
 	public:
 		VectorCurveSlotValue(csc::Float2 min, csc::Float2 max);
 
-		Curve get_x() const { return curve_x; }
-		Curve get_y() const { return curve_y; }
-		Curve get_z() const { return curve_z; }
+		const Curve& get_x() const { return curves->x; }
+		const Curve& get_y() const { return curves->y; }
+		const Curve& get_z() const { return curves->z; }
 
-		csc::Float2 get_min() const { return min; }
-		csc::Float2 get_max() const { return max; }
+		csc::Float2 get_min() const { return curves->min; }
+		csc::Float2 get_max() const { return curves->max; }
 
-		void set(const VectorCurveSlotValue& value) { *this = VectorCurveSlotValue{ value }; }
+		void set(const VectorCurveSlotValue& value) { *this = value; }
 		bool set_x(const Curve& value);
 		bool set_y(const Curve& value);
 		bool set_z(const Curve& value);
@@ -199,29 +209,39 @@ namespace csg {
 		bool operator!=(const VectorCurveSlotValue& other) const { return operator==(other) == false; }
 
 	private:
-		Curve curve_x;
-		Curve curve_y;
-		Curve curve_z;
-		csc::Float2 min;
-		csc::Float2 max;
+		struct Curves {
+			Curve x;
+			Curve y;
+			Curve z;
+			csc::Float2 min;
+			csc::Float2 max;
+		};
+
+		bool set_curve(Curve Curves::* curve, const Curve& value);
+
+		std::shared_ptr<const Curves> curves;
 	};
 
 	class ColorRampSlotValue {
 	public:
-		ColorRampSlotValue() {}
-		ColorRampSlotValue(ColorRamp ramp) : ramp{ ramp } {}
+		ColorRampSlotValue();
+		ColorRampSlotValue(const ColorRamp& ramp) : ramp{ std::make_shared<const ColorRamp>(ramp) } {}
 
-		ColorRamp get() const { return ramp; }
-		void set(ColorRamp new_ramp) { ramp = new_ramp; }
-		void set(ColorRampSlotValue new_ramp) { *this = new_ramp; }
+		const ColorRamp& get() const { return *ramp; }
+		void set(const ColorRamp& new_ramp) { ramp = std::make_shared<const ColorRamp>(new_ramp); }
+		void set(const ColorRampSlotValue& new_ramp) { *this = new_ramp; }
 
 		bool operator==(const ColorRampSlotValue& other) const;
 		bool operator!=(const ColorRampSlotValue& other) const { return operator==(other) == false; }
 
 	private:
-		ColorRamp ramp;
+		std::shared_ptr<const ColorRamp> ramp;
 	};
 
+	/**
+	 * @brief The value of one slot, which can be any of the slot value types above.
+	 * Values are stored inline, curves and ramps only hold a pointer to points that are shared between copies.
+	 */
 	class SlotValue {
 	public:
 		SlotValue(BoolSlotValue bool_value) :     _type{ SlotType::BOOL },   value_union{ bool_value } {}
@@ -231,19 +251,30 @@ namespace csg {
 		SlotValue(IntSlotValue int_value) :       _type{ SlotType::INT }, value_union{ int_value } {}
 		SlotValue(VectorSlotValue vector_value) : _type{ SlotType::VECTOR }, value_union{ vector_value } {}
 
-		SlotValue(const RGBCurveSlotValue& curve_value) : _type{ SlotType::CURVE_RGB }, curve_rgb_value{ std::make_unique<RGBCurveSlotValue>(curve_value) } {}
-		SlotValue(const VectorCurveSlotValue& curve_value) : _type{ SlotType::CURVE_VECTOR }, curve_vector_value{ std::make_unique<VectorCurveSlotValue>(curve_value) } {}
-		SlotValue(const ColorRampSlotValue& ramp_value) : _type{ SlotType::COLOR_RAMP }, color_ramp_value{ std::make_unique<ColorRampSlotValue>(ramp_value) } {}
+		SlotValue(const RGBCurveSlotValue& curve_value) :    _type{ SlotType::CURVE_RGB },    value_union{ curve_value } {}
+		SlotValue(const VectorCurveSlotValue& curve_value) : _type{ SlotType::CURVE_VECTOR }, value_union{ curve_value } {}
+		SlotValue(const ColorRampSlotValue& ramp_value) :    _type{ SlotType::COLOR_RAMP },   value_union{ ramp_value } {}
 
-		// Copy constructor and copy assignment operator, constructor defers to assignment
-		SlotValue(const SlotValue& other) : value_union{ FloatSlotValue{ 0.0f, 0.0f, 0.0f } } { this->operator=(other); }
+		// The union can hold types with destructors, so each of these picks which member to construct or destroy by type
+		SlotValue(const SlotValue& other);
+		SlotValue(SlotValue&& other) noexcept;
 		SlotValue& operator=(const SlotValue& other);
+		SlotValue& operator=(SlotValue&& other) noexcept;
+		~SlotValue();
 
 		SlotType type() const { return _type; }
 
-		// Base template function to get this object's value
-		// Needs to be specialized for each type
-		template <typename T> boost::optional<T> as() const { assert(false); }
+		// Base template function to get a pointer to this object's value, nullptr if it holds a different type
+		// Needs to be specialized for each type, the pointer is valid for as long as this object holds a T
+		template <typename T> const T* as_ptr() const { assert(false); return nullptr; }
+		template <typename T> T* as_ptr() { return const_cast<T*>(static_cast<const SlotValue*>(this)->as_ptr<T>()); }
+
+		// Copy of this object's value
+		template <typename T> boost::optional<T> as() const
+		{
+			const T* const value{ as_ptr<T>() };
+			return (value == nullptr) ? boost::none : boost::optional<T>{ *value };
+		}
 
 		bool operator==(const SlotValue& other) const;
 		bool operator!=(const SlotValue& other) const { return operator==(other) == false; }
@@ -260,6 +291,11 @@ namespace csg {
 			SlotValueUnion(FloatSlotValue float_value) : float_value{ float_value } {}
 			SlotValueUnion(IntSlotValue int_value) : int_value{ int_value } {}
 			SlotValueUnion(VectorSlotValue vector_value) : vector_value{ vector_value } {}
+			SlotValueUnion(const RGBCurveSlotValue& curve_rgb_value) : curve_rgb_value{ curve_rgb_value } {}
+			SlotValueUnion(const VectorCurveSlotValue& curve_vector_value) : curve_vector_value{ curve_vector_value } {}
+			SlotValueUnion(const ColorRampSlotValue& color_ramp_value) : color_ramp_value{ color_ramp_value } {}
+			// SlotValue destroys whichever member is in use
+			~SlotValueUnion() {}
 
 			BoolSlotValue bool_value;
 			ColorSlotValue color_value;
@@ -267,63 +303,57 @@ namespace csg {
 			FloatSlotValue float_value;
 			IntSlotValue int_value;
 			VectorSlotValue vector_value;
+			RGBCurveSlotValue curve_rgb_value;
+			VectorCurveSlotValue curve_vector_value;
+			ColorRampSlotValue color_ramp_value;
 		};
+
+		// Construct the member of value_union for _type from other, value_union must not hold a value
+		void construct_from(const SlotValue& other);
+		void construct_from(SlotValue&& other);
+		void destroy();
+
 		SlotType _type;
 		SlotValueUnion value_union;
-
-		// Pointers to non-union types here
-		// Be sure to update copy assignment operator when a new pointer is added
-		// These types are not part of the union because they contain heap-allocated resources that must be freed
-		std::unique_ptr<RGBCurveSlotValue> curve_rgb_value;
-		std::unique_ptr<VectorCurveSlotValue> curve_vector_value;
-		std::unique_ptr<ColorRampSlotValue> color_ramp_value;
 	};
 
-	template <> boost::optional<BoolSlotValue> SlotValue::as() const;
-	template <> boost::optional<ColorSlotValue> SlotValue::as() const;
-	template <> boost::optional<EnumSlotValue> SlotValue::as() const;
-	template <> boost::optional<FloatSlotValue> SlotValue::as() const;
-	template <> boost::optional<IntSlotValue> SlotValue::as() const;
-	template <> boost::optional<VectorSlotValue> SlotValue::as() const;
-	template <> boost::optional<RGBCurveSlotValue> SlotValue::as() const;
-	template <> boost::optional<VectorCurveSlotValue> SlotValue::as() const;
-	template <> boost::optional<ColorRampSlotValue> SlotValue::as() const;
-
+	template <> inline const BoolSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::BOOL) ? &value_union.bool_value : nullptr;
+	}
+	template <> inline const ColorSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::COLOR) ? &value_union.color_value : nullptr;
+	}
+	template <> inline const EnumSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::ENUM) ? &value_union.enum_value : nullptr;
+	}
+	template <> inline const FloatSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::FLOAT) ? &value_union.float_value : nullptr;
+	}
+	template <> inline const IntSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::INT) ? &value_union.int_value : nullptr;
+	}
+	template <> inline const VectorSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::VECTOR) ? &value_union.vector_value : nullptr;
+	}
+	template <> inline const RGBCurveSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::CURVE_RGB) ? &value_union.curve_rgb_value : nullptr;
+	}
+	template <> inline const VectorCurveSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::CURVE_VECTOR) ? &value_union.curve_vector_value : nullptr;
+	}
+	template <> inline const ColorRampSlotValue* SlotValue::as_ptr() const {
+		return (_type == SlotType::COLOR_RAMP) ? &value_union.color_ramp_value : nullptr;
+	}
+
+	/**
+	 * @brief Description of one input or output of a node type, shared by every node of that type.
+	 * The value of an input is stored in each node, see Node::slot_value.
+	 */
 	class Slot {
 	public:
-		// Creates a slot that does not have an editable value
-		Slot(const char* disp_name, const char* name, SlotDirection dir, SlotType type, bool has_pin = true) :
+		Slot(const char* disp_name, const char* name, SlotDirection dir, SlotType type, bool has_pin) :
 			_disp_name{ disp_name }, _name{ name }, _dir{ dir }, _type{ type }, _has_pin{ has_pin }
 		{}
-		// These constructors take value of a specific type, which can be edited
-		// When a value is specificed, the slot is automatically treated as input
-		Slot(const char* disp_name, const char* name, BoolSlotValue bool_value, bool has_pin = false) :
-			value{ bool_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::BOOL }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, ColorSlotValue color_value, bool has_pin = true) :
-			value{ color_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::COLOR }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, EnumSlotValue enum_value, bool has_pin = false) :
-			value{ enum_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::ENUM }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, FloatSlotValue float_value, bool has_pin = true) :
-			value{ float_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::FLOAT }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, IntSlotValue int_value, bool has_pin = false) :
-			value{ int_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::INT }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, VectorSlotValue vector_value, bool has_pin = true) :
-			value{ vector_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::VECTOR }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, RGBCurveSlotValue rgb_value, bool has_pin = false) :
-			value{ rgb_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::CURVE_RGB }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, VectorCurveSlotValue vector_value, bool has_pin = false) :
-			value{ vector_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::CURVE_VECTOR }, _has_pin{ has_pin }
-		{}
-		Slot(const char* disp_name, const char* name, ColorRampSlotValue ramp_value, bool has_pin = false) :
-			value{ ramp_value }, _disp_name{ disp_name }, _name{ name }, _dir{ SlotDirection::INPUT }, _type{ SlotType::COLOR_RAMP }, _has_pin{ has_pin }
-		{}
 
 		SlotDirection dir() const { return _dir; }
 		SlotType type() const { return _type; }
@@ -334,8 +364,6 @@ namespace csg {
 		bool operator==(const Slot& other) const;
 		bool operator!=(const Slot& other) const { return operator==(other) == false; }
 
-		boost::optional<SlotValue> value;
-
 	private:
 		const char* _disp_name;
 		const char* _name;